@@ -14,7 +14,15 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <mutex>
+#include <sstream>
+#include <sys/stat.h>
+#include <thread>
 
 #include <clang/Basic/DiagnosticOptions.h>
 #include <clang/Basic/TargetInfo.h>
@@ -33,14 +41,23 @@
 #include <clang/Lex/Preprocessor.h>
 #include <clang/Lex/PreprocessorOptions.h>
 #include <llvm/ADT/Statistic.h>
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/ExecutionEngine/MCJIT.h> // forces JIT to link in
+#include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
 #include <llvm/LinkAllPasses.h>
 #include <llvm/Option/Arg.h>
 #include <llvm/Option/ArgList.h>
 #include <llvm/Option/OptTable.h>
 #include <llvm/Support/ErrorHandling.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Host.h>
 #include <llvm/Support/ManagedStatic.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Process.h>
+#include <llvm/Support/SHA1.h>
 #include <llvm/Support/Signals.h>
 #include <llvm/Support/TargetSelect.h>
 #include <llvm/Support/Timer.h>
@@ -80,6 +97,7 @@ public:
 };
 
 static unordered_map<string, CompilerInfo> s_compiler_info;
+static mutex s_compiler_info_mutex;
 
 static class StaticHandler
 {
@@ -108,8 +126,30 @@ std::unique_ptr<llvm::Module> codegen::Module::take_module()
     return move(m_module);
 }
 
+bool codegen::Module::write_bitcode(const std::string& path) const
+{
+    if (!m_module)
+    {
+        return false;
+    }
+    // Write to a temporary and rename so concurrent readers never see a partial file
+    string tmp_path = path + ".tmp" + std::to_string(llvm::sys::Process::getProcessId());
+    {
+        std::error_code ec;
+        llvm::raw_fd_ostream out(tmp_path, ec, llvm::sys::fs::F_None);
+        if (ec)
+        {
+            return false;
+        }
+        llvm::WriteBitcodeToFile(m_module.get(), out);
+    }
+    return !llvm::sys::fs::rename(tmp_path, path);
+}
+
 codegen::Compiler::Compiler()
-    : m_compiler_core{}
+    : m_cache_hits(0)
+    , m_compile_thread_count(0)
+    , m_compiler_core{}
 {
 }
 
@@ -129,23 +169,234 @@ void codegen::Compiler::add_header_search_path(const std::string& path)
     m_header_search_paths.push_back(path);
 }
 
+void codegen::Compiler::set_cache_directory(const std::string& directory)
+{
+    m_cache_directory = directory;
+}
+
+// Digest of the headers built into the library, which clang reads instead of the files
+static const string& get_builtin_header_digest()
+{
+    static const string digest = [] {
+        SHA1 sha;
+        for (const pair<string, string>& header_info : builtin_headers)
+        {
+            sha.update(header_info.first);
+            sha.update(StringRef("", 1));
+            sha.update(header_info.second);
+            sha.update(StringRef("", 1));
+        }
+        return toHex(sha.final());
+    }();
+    return digest;
+}
+
+static time_t get_modification_time(const string& path)
+{
+    struct stat st;
+    return stat(path.c_str(), &st) == 0 ? st.st_mtime : 0;
+}
+
+string codegen::Compiler::get_cache_key(const std::string& source) const
+{
+    // Everything that changes the generated machine code goes into the key
+    stringstream key;
+    key << NGRAPH_VERSION << "\n"
+        << llvm::sys::getProcessTriple() << "\n"
+        << llvm::sys::getHostCPUName().str() << "\n"
+        << "debuginfo " << (std::getenv("NGRAPH_COMPILER_DEBUGINFO_ENABLE") != nullptr) << "\n"
+        << "headers " << get_builtin_header_digest() << "\n";
+    // Headers outside the library are tracked by the modification times of their directories,
+    // which change when headers are added or removed, e.g. by installing another toolchain
+    vector<string> header_directories = m_header_search_paths;
+    header_directories.push_back("/usr/include/c++");
+    header_directories.push_back("/usr/include");
+    for (const string& directory : header_directories)
+    {
+        key << directory << " " << get_modification_time(directory) << "\n";
+    }
+    key << m_precompiled_header_source << "\n" << source;
+    return key.str();
+}
+
+string codegen::Compiler::get_cache_path(const std::string& key) const
+{
+    SHA1 sha;
+    sha.update(key);
+    return file_util::path_join(m_cache_directory, toHex(sha.final()) + ".bc");
+}
+
+unique_ptr<codegen::Module> codegen::Compiler::load_cached_module(const std::string& key)
+{
+    string path = get_cache_path(key);
+    string key_path = path + ".key";
+    if (!file_util::exists(path) || !file_util::exists(key_path))
+    {
+        return nullptr;
+    }
+    // The file name is only a digest of the key, so check the key itself
+    if (file_util::read_file_to_string(key_path) != key)
+    {
+        NGRAPH_WARN << "Ignoring codegen cache entry " << path << " whose key does not match";
+        return nullptr;
+    }
+    auto buffer = MemoryBuffer::getFile(path);
+    if (!buffer)
+    {
+        return nullptr;
+    }
+    if (!m_cached_module_context)
+    {
+        m_cached_module_context.reset(new LLVMContext());
+    }
+    auto module = parseBitcodeFile((*buffer)->getMemBufferRef(), *m_cached_module_context);
+    if (!module)
+    {
+        NGRAPH_WARN << "Ignoring unreadable codegen cache entry " << path << ": "
+                    << toString(module.takeError());
+        return nullptr;
+    }
+    NGRAPH_DEBUG << "Loaded compiled module from " << path;
+    m_cache_hits++;
+    return unique_ptr<codegen::Module>(new codegen::Module(move(*module)));
+}
+
+void codegen::Compiler::store_cached_module(const codegen::Module& module, const string& key)
+{
+    string cache_path = get_cache_path(key);
+    string key_path = cache_path + ".key";
+    file_util::make_directory(m_cache_directory);
+
+    // The key goes first, so a reader never finds bitcode next to a key it does not belong to
+    string tmp_path = key_path + ".tmp" + std::to_string(llvm::sys::Process::getProcessId());
+    {
+        ofstream out(tmp_path, ios::binary);
+        out << key;
+    }
+    if (llvm::sys::fs::rename(tmp_path, key_path) || !module.write_bitcode(cache_path))
+    {
+        NGRAPH_WARN << "Failed to write codegen cache entry " << cache_path;
+    }
+}
+
+shared_ptr<codegen::CompilerCore> codegen::Compiler::create_compiler_core() const
+{
+    auto core = make_shared<CompilerCore>();
+    for (const string& path : m_header_search_paths)
+    {
+        core->add_header_search_path(path);
+    }
+    core->set_precompiled_header_source(m_precompiled_header_source);
+    return core;
+}
+
 std::unique_ptr<codegen::Module> codegen::Compiler::compile(const std::string& source)
 {
-    // lock_guard<mutex> lock(m_mutex);
-    CompilerInfo& compiler_info = s_compiler_info[m_precompiled_header_source];
-    if (!compiler_info.compiler)
+    string cache_key;
+    if (!m_cache_directory.empty())
     {
-        compiler_info.compiler = make_shared<CompilerCore>();
-        for (const string& path : m_header_search_paths)
+        cache_key = get_cache_key(source);
+        auto cached = load_cached_module(cache_key);
+        if (cached)
         {
-            compiler_info.compiler->add_header_search_path(path);
+            return cached;
         }
-        compiler_info.compiler->set_precompiled_header_source(m_precompiled_header_source);
     }
-    auto rc = compiler_info.compiler->compile(m_compiler_action, source);
+
+    shared_ptr<CompilerCore> core;
+    {
+        lock_guard<mutex> lock(s_compiler_info_mutex);
+        CompilerInfo& compiler_info = s_compiler_info[m_precompiled_header_source];
+        if (!compiler_info.compiler)
+        {
+            compiler_info.compiler = create_compiler_core();
+        }
+        core = compiler_info.compiler;
+    }
+    auto rc = core->compile(m_compiler_action, source);
+
+    if (rc && !m_cache_directory.empty())
+    {
+        store_cached_module(*rc, cache_key);
+    }
     return rc;
 }
 
+vector<unique_ptr<codegen::Module>>
+    codegen::Compiler::compile(const vector<string>& sources, size_t num_threads)
+{
+    vector<unique_ptr<codegen::Module>> modules(sources.size());
+
+    vector<string> cache_keys(sources.size());
+    vector<size_t> pending;
+    for (size_t i = 0; i < sources.size(); i++)
+    {
+        if (!m_cache_directory.empty())
+        {
+            cache_keys[i] = get_cache_key(sources[i]);
+            modules[i] = load_cached_module(cache_keys[i]);
+        }
+        if (!modules[i])
+        {
+            pending.push_back(i);
+        }
+    }
+    if (pending.empty())
+    {
+        return modules;
+    }
+
+    // Target initialization in the CompilerCore constructor is not thread safe, so every
+    // worker's compiler instance is created up front on this thread
+    size_t num_workers = max<size_t>(1, min(num_threads, pending.size()));
+    while (m_parallel_cores.size() < num_workers)
+    {
+        m_parallel_cores.push_back(create_compiler_core());
+    }
+    // Each module lives in the context of the action that produced it
+    size_t action_base = m_parallel_actions.size();
+    m_parallel_actions.resize(action_base + sources.size());
+
+    atomic<size_t> next{0};
+    atomic<size_t> busy_workers{0};
+    auto worker = [&](size_t w) {
+        size_t n = next++;
+        if (n < pending.size())
+        {
+            busy_workers++;
+        }
+        for (; n < pending.size(); n = next++)
+        {
+            size_t i = pending[n];
+            modules[i] =
+                m_parallel_cores[w]->compile(m_parallel_actions[action_base + i], sources[i]);
+        }
+    };
+    vector<thread> threads;
+    for (size_t w = 1; w < num_workers; w++)
+    {
+        threads.emplace_back(worker, w);
+    }
+    worker(0);
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+    m_compile_thread_count = max(m_compile_thread_count, busy_workers.load());
+
+    if (!m_cache_directory.empty())
+    {
+        for (size_t i : pending)
+        {
+            if (modules[i])
+            {
+                store_cached_module(*modules[i], cache_keys[i]);
+            }
+        }
+    }
+    return modules;
+}
+
 static std::string GetExecutablePath(const char* Argv0)
 {
     // This just needs to be some symbol in the binary; C++ doesn't
@@ -315,15 +566,21 @@ std::unique_ptr<codegen::Module>
 
     preprocessor_options.RetainRemappedFileBuffers = true;
 
-    CompilerInfo& compiler_info = s_compiler_info[m_precompiled_header_source];
-    if (!m_precompiled_header_source.empty() && compiler_info.pch_file.empty())
+    string pch_file;
     {
-        compiler_info.pch_file = generate_pch(m_precompiled_header_source);
+        // Concurrent compiler instances share one precompiled header per source
+        lock_guard<mutex> lock(s_compiler_info_mutex);
+        CompilerInfo& compiler_info = s_compiler_info[m_precompiled_header_source];
+        if (!m_precompiled_header_source.empty() && compiler_info.pch_file.empty())
+        {
+            compiler_info.pch_file = generate_pch(m_precompiled_header_source);
+        }
+        pch_file = compiler_info.pch_file;
     }
-    if (!compiler_info.pch_file.empty())
+    if (!pch_file.empty())
     {
         // Preprocessor options
-        preprocessor_options.ImplicitPCHInclude = compiler_info.pch_file;
+        preprocessor_options.ImplicitPCHInclude = pch_file;
         preprocessor_options.DisablePCHValidation = 0;
     }
 
@@ -38,6 +38,7 @@ namespace clang
 
 namespace llvm
 {
+    class LLVMContext;
     class Module;
 }
 
@@ -47,6 +48,9 @@ public:
     Module(std::unique_ptr<llvm::Module> module);
     ~Module();
     std::unique_ptr<llvm::Module> take_module();
+    /// \brief Write the module as LLVM bitcode
+    /// \returns true on success
+    bool write_bitcode(const std::string& path) const;
 
 private:
     std::unique_ptr<llvm::Module> m_module;
@@ -59,9 +63,40 @@ public:
     ~Compiler();
     void set_precompiled_header_source(const std::string& source);
     void add_header_search_path(const std::string& path);
+    /// \brief Persist compiled modules as bitcode in `directory` and reuse them when the
+    ///     same source is compiled again, by this or a later process, on the same host CPU
+    ///     and nGraph version. A cache hit skips clang entirely. The full key, including the
+    ///     compile flags and a digest of the headers, is stored with every module and checked
+    ///     when it is loaded.
+    void set_cache_directory(const std::string& directory);
+    /// \brief The number of modules this compiler loaded from the cache directory
+    size_t get_cache_hits() const { return m_cache_hits; }
     std::unique_ptr<ngraph::codegen::Module> compile(const std::string& source);
+    /// \brief Compile independent translation units concurrently, each worker thread on its
+    ///     own compiler instance. All units share the precompiled header source.
+    /// \returns One module per source, in order; a failed unit yields nullptr
+    std::vector<std::unique_ptr<ngraph::codegen::Module>>
+        compile(const std::vector<std::string>& sources, size_t num_threads);
+    /// \brief The most threads that compiled translation units in one call of the
+    ///     concurrent compile()
+    size_t get_compile_thread_count() const { return m_compile_thread_count; }
     std::unique_ptr<clang::CodeGenAction>& get_compiler_action() { return m_compiler_action; }
 private:
+    std::string get_cache_key(const std::string& source) const;
+    std::string get_cache_path(const std::string& key) const;
+    std::unique_ptr<ngraph::codegen::Module> load_cached_module(const std::string& key);
+    void store_cached_module(const ngraph::codegen::Module& module, const std::string& key);
+    std::shared_ptr<CompilerCore> create_compiler_core() const;
+
+    // Per-thread compiler instances and the actions owning the contexts of their modules
+    std::vector<std::shared_ptr<CompilerCore>> m_parallel_cores;
+    std::vector<std::unique_ptr<clang::CodeGenAction>> m_parallel_actions;
+
+    // Owns modules loaded from the cache; must outlive any ExecutionEngine using them
+    std::unique_ptr<llvm::LLVMContext> m_cached_module_context;
+    std::string m_cache_directory;
+    size_t m_cache_hits;
+    size_t m_compile_thread_count;
     std::unique_ptr<clang::CodeGenAction> m_compiler_action;
     std::shared_ptr<CompilerCore> m_compiler_core;
     std::string m_precompiled_header_source;
@@ -52,6 +52,11 @@ bool codegen::ExecutionEngine::add_module(std::unique_ptr<ngraph::codegen::Modul
                 return false;
             }
         }
+        else
+        {
+            // Further modules are linked against those already added when finalized
+            m_execution_engine->addModule(module->take_module());
+        }
     }
     else
     {
@@ -0,0 +1,326 @@
+//*****************************************************************************
+// Copyright 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <unordered_map>
+
+#include "ngraph/cost_model.hpp"
+#include "ngraph/function.hpp"
+#include "ngraph/node.hpp"
+#include "ngraph/op/avg_pool.hpp"
+#include "ngraph/op/batch_norm.hpp"
+#include "ngraph/op/dot.hpp"
+#include "ngraph/op/lrn.hpp"
+#include "ngraph/op/max_pool.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+// This expands the op list in op_tbl.hpp into a list of enumerations that look like this:
+// Abs,
+// Acos,
+// ...
+namespace
+{
+#define NGRAPH_OP(a, b) a,
+    enum class OP_TYPEID
+    {
+#include "ngraph/op/op_tbl.hpp"
+        UnknownOp
+    };
+#undef NGRAPH_OP
+}
+
+static OP_TYPEID get_typeid(const string& s)
+{
+// This expands the op list in op_tbl.hpp into a list of enumerations that look like this:
+// {"Abs", OP_TYPEID::Abs},
+// {"Acos", OP_TYPEID::Acos},
+// ...
+#define NGRAPH_OP(a, b) {#a, OP_TYPEID::a},
+    static const unordered_map<string, OP_TYPEID> typeid_map{
+#include "ngraph/op/op_tbl.hpp"
+    };
+#undef NGRAPH_OP
+    auto it = typeid_map.find(s);
+    return it == typeid_map.end() ? OP_TYPEID::UnknownOp : it->second;
+}
+
+// Multiply-adds of a convolution whose forward output has forward_output_shape elements,
+// each of which sums over one filter's input channels and window
+static size_t convolution_flops(const Shape& forward_output_shape, const Shape& filters_shape)
+{
+    size_t output_channels = filters_shape.at(0);
+    if (output_channels == 0)
+    {
+        return 0;
+    }
+    return 2 * shape_size(forward_output_shape) * (shape_size(filters_shape) / output_channels);
+}
+
+double OpCost::get_arithmetic_intensity() const
+{
+    size_t bytes = get_bytes();
+    return bytes > 0 ? static_cast<double>(flops) / bytes : 0;
+}
+
+OpCost& OpCost::operator+=(const OpCost& other)
+{
+    flops += other.flops;
+    bytes_read += other.bytes_read;
+    bytes_written += other.bytes_written;
+    return *this;
+}
+
+OpCost ngraph::get_op_cost(const Node& node)
+{
+    OpCost cost;
+    for (size_t i = 0; i < node.get_input_size(); i++)
+    {
+        cost.bytes_read +=
+            node.get_input_element_type(i).size() * shape_size(node.get_input_shape(i));
+    }
+    for (size_t i = 0; i < node.get_output_size(); i++)
+    {
+        cost.bytes_written +=
+            node.get_output_element_type(i).size() * shape_size(node.get_output_shape(i));
+    }
+
+    // Most ops produce one output the size of their result
+    size_t elements = node.get_output_size() > 0 ? shape_size(node.get_output_shape(0)) : 0;
+    size_t input_elements = node.get_input_size() > 0 ? shape_size(node.get_input_shape(0)) : 0;
+
+// We want to check that every OP_TYPEID enumeration is included in the list.
+// These GCC flags enable compile-time checking so that if an enumeration
+// is not in the list an error is generated.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic error "-Wswitch"
+#pragma GCC diagnostic error "-Wswitch-enum"
+    switch (get_typeid(node.description()))
+    {
+    case OP_TYPEID::Constant:
+    case OP_TYPEID::GetOutputElement:
+    case OP_TYPEID::Parameter: cost = OpCost(); break;
+    case OP_TYPEID::Broadcast:
+    case OP_TYPEID::Concat:
+    case OP_TYPEID::Convert:
+    case OP_TYPEID::FunctionCall:
+    case OP_TYPEID::OneHot:
+    case OP_TYPEID::Pad:
+    case OP_TYPEID::ReplaceSlice:
+    case OP_TYPEID::Reshape:
+    case OP_TYPEID::Result:
+    case OP_TYPEID::Reverse:
+    case OP_TYPEID::ReverseSequence:
+    case OP_TYPEID::StopGradient:
+    case OP_TYPEID::UnknownOp: break;
+    case OP_TYPEID::Slice:
+    {
+        // Only the elements of the slice are read
+        cost.bytes_read = cost.bytes_written;
+        break;
+    }
+    case OP_TYPEID::Abs:
+    case OP_TYPEID::Acos:
+    case OP_TYPEID::Add:
+    case OP_TYPEID::And:
+    case OP_TYPEID::Asin:
+    case OP_TYPEID::Atan:
+    case OP_TYPEID::Ceiling:
+    case OP_TYPEID::Cos:
+    case OP_TYPEID::Cosh:
+    case OP_TYPEID::Divide:
+    case OP_TYPEID::Equal:
+    case OP_TYPEID::Exp:
+    case OP_TYPEID::Floor:
+    case OP_TYPEID::Greater:
+    case OP_TYPEID::GreaterEq:
+    case OP_TYPEID::Less:
+    case OP_TYPEID::LessEq:
+    case OP_TYPEID::Log:
+    case OP_TYPEID::Maximum:
+    case OP_TYPEID::Minimum:
+    case OP_TYPEID::Multiply:
+    case OP_TYPEID::Negative:
+    case OP_TYPEID::Not:
+    case OP_TYPEID::NotEqual:
+    case OP_TYPEID::Or:
+    case OP_TYPEID::Power:
+    case OP_TYPEID::Relu:
+    case OP_TYPEID::ReluBackprop:
+    case OP_TYPEID::Select:
+    case OP_TYPEID::Sigmoid:
+    case OP_TYPEID::SigmoidBackprop:
+    case OP_TYPEID::Sign:
+    case OP_TYPEID::Sin:
+    case OP_TYPEID::Sinh:
+    case OP_TYPEID::Sqrt:
+    case OP_TYPEID::Subtract:
+    case OP_TYPEID::Tan:
+    case OP_TYPEID::Tanh:
+    {
+        cost.flops = elements;
+        break;
+    }
+    case OP_TYPEID::AllReduce:
+    case OP_TYPEID::ArgMax:
+    case OP_TYPEID::ArgMin:
+    case OP_TYPEID::Max:
+    case OP_TYPEID::Min:
+    case OP_TYPEID::Product:
+    case OP_TYPEID::Reduce:
+    case OP_TYPEID::ReduceWindow:
+    case OP_TYPEID::SelectAndScatter:
+    case OP_TYPEID::Sum:
+    case OP_TYPEID::TopK:
+    {
+        cost.flops = input_elements;
+        break;
+    }
+    case OP_TYPEID::Softmax:
+    {
+        // Exponentiate, sum and divide
+        cost.flops = 3 * elements;
+        break;
+    }
+    case OP_TYPEID::Dot:
+    {
+        auto dot = static_cast<const op::Dot*>(&node);
+        const Shape& arg0_shape = node.get_input_shape(0);
+        size_t reduction_size = 1;
+        for (size_t i = arg0_shape.size() - dot->get_reduction_axes_count(); i < arg0_shape.size();
+             i++)
+        {
+            reduction_size *= arg0_shape[i];
+        }
+        cost.flops =
+            dot->get_reduction_axes_count() == 0 ? elements : 2 * elements * reduction_size;
+        break;
+    }
+    case OP_TYPEID::Convolution:
+    {
+        cost.flops = convolution_flops(node.get_output_shape(0), node.get_input_shape(1));
+        break;
+    }
+    case OP_TYPEID::ConvolutionBackpropData:
+    {
+        cost.flops = convolution_flops(node.get_input_shape(1), node.get_input_shape(0));
+        break;
+    }
+    case OP_TYPEID::ConvolutionBackpropFilters:
+    {
+        cost.flops = convolution_flops(node.get_input_shape(1), node.get_output_shape(0));
+        break;
+    }
+    case OP_TYPEID::AvgPool:
+    {
+        auto avg_pool = static_cast<const op::AvgPool*>(&node);
+        cost.flops = elements * shape_size(avg_pool->get_window_shape());
+        break;
+    }
+    case OP_TYPEID::AvgPoolBackprop:
+    {
+        auto avg_pool = static_cast<const op::AvgPoolBackprop*>(&node);
+        cost.flops = input_elements * shape_size(avg_pool->get_window_shape());
+        break;
+    }
+    case OP_TYPEID::MaxPool:
+    {
+        auto max_pool = static_cast<const op::MaxPool*>(&node);
+        cost.flops = elements * shape_size(max_pool->get_window_shape());
+        break;
+    }
+    case OP_TYPEID::MaxPoolBackprop:
+    {
+        auto max_pool = static_cast<const op::MaxPoolBackprop*>(&node);
+        cost.flops = shape_size(node.get_input_shape(1)) * shape_size(max_pool->get_window_shape());
+        break;
+    }
+    case OP_TYPEID::BatchNorm:
+    {
+        // Normalizing, scaling and shifting takes 4 flops per element; computing the mean and
+        // variance for training takes 3 more
+        auto batch_norm = static_cast<const op::BatchNorm*>(&node);
+        size_t batch_elements = shape_size(node.get_input_shape(2));
+        cost.flops = (batch_norm->get_training_flag() ? 7 : 4) * batch_elements;
+        break;
+    }
+    case OP_TYPEID::BatchNormBackprop:
+    {
+        cost.flops = 9 * shape_size(node.get_input_shape(2));
+        break;
+    }
+    case OP_TYPEID::LRN:
+    {
+        // Sum the squares of the window, then scale, raise and divide
+        auto lrn = static_cast<const op::LRN*>(&node);
+        cost.flops = elements * (2 * lrn->get_nsize() + 3);
+        break;
+    }
+    }
+#pragma GCC diagnostic pop
+
+    return cost;
+}
+
+OpCost ngraph::get_function_cost(const Function& f)
+{
+    OpCost cost;
+    for (const shared_ptr<Node>& node : f.get_ops())
+    {
+        cost += get_op_cost(*node);
+    }
+    return cost;
+}
+
+MachineModel::MachineModel(double gflops, double gigabytes_per_second)
+    : peak_gflops(gflops)
+    , peak_gigabytes_per_second(gigabytes_per_second)
+{
+}
+
+const MachineModel& MachineModel::get_default()
+{
+    auto get_env = [](const char* name, double default_value) {
+        const char* value = getenv(name);
+        return value ? atof(value) : default_value;
+    };
+    // One core of a recent server: two 8-wide FMA units at about 2.5GHz, and a single
+    // thread's share of the memory bandwidth
+    static const MachineModel machine(get_env("NGRAPH_PEAK_GFLOPS", 80.0),
+                                      get_env("NGRAPH_PEAK_GIGABYTES_PER_SECOND", 12.0));
+    return machine;
+}
+
+double MachineModel::get_attainable_gflops(const OpCost& cost) const
+{
+    return min(peak_gflops, cost.get_arithmetic_intensity() * peak_gigabytes_per_second);
+}
+
+double MachineModel::get_min_microseconds(const OpCost& cost) const
+{
+    // A GFLOP/s is a thousand flops per microsecond, and a GB/s a thousand bytes
+    double compute_us = cost.flops / (peak_gflops * 1e3);
+    double memory_us = cost.get_bytes() / (peak_gigabytes_per_second * 1e3);
+    return max(compute_us, memory_us);
+}
+
+bool MachineModel::is_compute_bound(const OpCost& cost) const
+{
+    return cost.get_arithmetic_intensity() > get_balance();
+}
@@ -0,0 +1,76 @@
+//*****************************************************************************
+// Copyright 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <cstddef>
+
+namespace ngraph
+{
+    class Function;
+    class Node;
+
+    /// \brief The arithmetic an op performs and the data it moves, as estimated from its
+    ///        shapes and attributes.
+    ///
+    /// Every arithmetic operation, comparison or transcendental function on one element counts
+    /// as one flop; a multiply-add counts as two. Bytes are those of the input and output
+    /// tensors, read or written once each, so the counts describe an ideal kernel that never
+    /// rereads an operand from memory.
+    struct OpCost
+    {
+        size_t flops = 0;
+        size_t bytes_read = 0;
+        size_t bytes_written = 0;
+
+        size_t get_bytes() const { return bytes_read + bytes_written; }
+        /// \brief Flops per byte moved; 0 for ops that move no data
+        double get_arithmetic_intensity() const;
+
+        OpCost& operator+=(const OpCost& other);
+    };
+
+    /// \brief Returns the cost of one execution of node. Ops the model does not know are
+    ///        counted as moving their inputs and outputs without arithmetic. Parameters,
+    ///        constants and GetOutputElement cost nothing.
+    OpCost get_op_cost(const Node& node);
+
+    /// \brief Returns the summed cost of the ops of f, not including the functions it calls
+    OpCost get_function_cost(const Function& f);
+
+    /// \brief The peak arithmetic throughput and memory bandwidth of a device, which bound the
+    ///        throughput an op can attain according to the roofline model.
+    struct MachineModel
+    {
+        MachineModel(double peak_gflops, double peak_gigabytes_per_second);
+
+        /// \brief A machine with the peaks set by NGRAPH_PEAK_GFLOPS and
+        ///        NGRAPH_PEAK_GIGABYTES_PER_SECOND, or by a typical server core if unset
+        static const MachineModel& get_default();
+
+        /// \brief The arithmetic intensity at which the compute and memory bounds meet
+        double get_balance() const { return peak_gflops / peak_gigabytes_per_second; }
+        /// \brief The throughput the roofline allows at the intensity of cost
+        double get_attainable_gflops(const OpCost& cost) const;
+        /// \brief The shortest time in which the machine can perform cost
+        double get_min_microseconds(const OpCost& cost) const;
+        /// \brief True if the arithmetic of cost takes longer than moving its data
+        bool is_compute_bound(const OpCost& cost) const;
+
+        double peak_gflops;
+        double peak_gigabytes_per_second;
+    };
+}
@@ -131,6 +131,7 @@ void cpio::Header::write(ostream& stream, const string& name, uint32_t size)
 
 cpio::Writer::Writer()
     : m_stream(nullptr)
+    , m_offset(0)
 {
 }
 
@@ -154,12 +155,16 @@ cpio::Writer::~Writer()
 void cpio::Writer::open(ostream& out)
 {
     m_stream = &out;
+    // Readers seek to the start of the stream so offsets are relative to it
+    streamoff pos = out.tellp();
+    m_offset = pos > 0 ? static_cast<size_t>(pos) : 0;
 }
 
 void cpio::Writer::open(const string& filename)
 {
     m_stream = &m_my_stream;
     m_my_stream.open(filename, ios_base::binary | ios_base::out);
+    m_offset = 0;
 }
 
 void cpio::Writer::close()
@@ -182,6 +187,7 @@ void cpio::Writer::write(const string& record_name, const void* data, uint32_t s
             char ch = 0;
             m_stream->write(&ch, 1);
         }
+        m_offset += header_size(record_name) + size_in_bytes + (size_in_bytes % 2);
     }
     else
     {
@@ -189,6 +195,35 @@ void cpio::Writer::write(const string& record_name, const void* data, uint32_t s
     }
 }
 
+void cpio::Writer::write(const string& record_name,
+                         const void* data,
+                         uint32_t size_in_bytes,
+                         size_t data_alignment)
+{
+    if (data_alignment % 2)
+    {
+        throw runtime_error("cpio data alignment must be a multiple of 2");
+    }
+    const string pad_name = ".pad";
+    size_t data_offset = m_offset + header_size(record_name);
+    if (data_offset % data_alignment != 0)
+    {
+        // Every record has an even size so the pad length always comes out even
+        size_t padded_offset = m_offset + header_size(pad_name) + header_size(record_name);
+        size_t pad = (data_alignment - padded_offset % data_alignment) % data_alignment;
+        vector<char> zeros(pad, 0);
+        write(pad_name, zeros.data(), static_cast<uint32_t>(pad));
+    }
+    write(record_name, data, size_in_bytes);
+}
+
+size_t cpio::Writer::header_size(const string& file_name)
+{
+    // Fixed header fields followed by the name, its terminator and padding to an even size
+    size_t namesize = file_name.size() + 1;
+    return 26 + namesize + (namesize % 2);
+}
+
 cpio::Reader::Reader()
     : m_stream(nullptr)
 {
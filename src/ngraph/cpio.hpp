@@ -88,9 +88,21 @@ public:
     void close();
     void write(const std::string& file_name, const void* data, uint32_t size_in_bytes);
 
+    /// \brief Write a file whose data starts at a multiple of data_alignment bytes from the
+    ///     start of the archive. A padding file named ".pad" is inserted in front of it when
+    ///     needed so the archive remains readable by any cpio reader.
+    /// \param data_alignment Must be a multiple of 2
+    void write(const std::string& file_name,
+               const void* data,
+               uint32_t size_in_bytes,
+               size_t data_alignment);
+
 private:
+    static size_t header_size(const std::string& file_name);
+
     std::ostream* m_stream;
     std::ofstream m_my_stream;
+    size_t m_offset;
 };
 
 class ngraph::cpio::Reader
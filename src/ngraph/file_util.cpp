@@ -21,6 +21,7 @@
 #include <dirent.h>
 #include <ftw.h>
 #include <sys/file.h>
+#include <sys/mman.h>
 #include <sys/time.h>
 #include <unistd.h>
 #endif
@@ -229,6 +230,38 @@ vector<char> file_util::read_file_contents(const string& path)
     return data;
 }
 
+shared_ptr<const char> file_util::map_file_contents(const string& path, size_t& size)
+{
+    size = 0;
+    shared_ptr<const char> rc;
+#ifndef WIN32
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw runtime_error("error opening file '" + path + "'");
+    }
+    size_t file_size = get_file_size(path);
+    if (file_size > 0)
+    {
+        // Kernels that work in place may write to constant data; a private mapping copies
+        // the pages they touch and leaves the file and other processes alone
+        void* p = mmap(nullptr, file_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED)
+        {
+            close(fd);
+            throw runtime_error("error mapping file '" + path + "' " + strerror(errno));
+        }
+        rc = shared_ptr<const char>(static_cast<const char*>(p), [file_size](const char* q) {
+            munmap(const_cast<char*>(q), file_size);
+        });
+        size = file_size;
+    }
+    // The mapping keeps its own reference to the file
+    close(fd);
+#endif
+    return rc;
+}
+
 string file_util::read_file_to_string(const string& path)
 {
     ifstream f(path);
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -77,6 +78,15 @@ namespace ngraph
         /// \return string of the file's contents
         std::string read_file_to_string(const std::string& path);
 
+        /// \brief Maps the contents of a file copy-on-write into memory. Pages are shared with
+        ///     every other process that maps the same file until they are written to; writes
+        ///     never reach the file.
+        /// \param path The path of the file to map
+        /// \param size Set to the size of the mapping in bytes
+        /// \return Pointer to the first byte of the mapping, unmapped when the last copy of
+        ///     the pointer is released. nullptr if the platform does not support mapping.
+        std::shared_ptr<const char> map_file_contents(const std::string& path, size_t& size);
+
         /// \brief Iterate through files and optionally directories. Symbolic links are skipped.
         /// \param path The path to iterate over
         /// \param func A callback function called with each file or directory encountered
@@ -101,7 +101,30 @@ void Function::init()
 
 std::list<shared_ptr<Node>> Function::get_ordered_ops(bool include_control_deps) const
 {
-    return topological_sort(get_ops(include_control_deps), include_control_deps);
+    lock_guard<mutex> lock(m_ordered_ops_mutex);
+    return *sort_ops(include_control_deps);
+}
+
+shared_ptr<const std::list<shared_ptr<Node>>>
+    Function::get_ordered_ops_view(bool include_control_deps) const
+{
+    lock_guard<mutex> lock(m_ordered_ops_mutex);
+    return sort_ops(include_control_deps);
+}
+
+shared_ptr<const std::list<shared_ptr<Node>>>
+    Function::sort_ops(bool include_control_deps) const
+{
+    OrderedOps& cache = m_ordered_ops[include_control_deps];
+    // Read the version first so that edits made while sorting make the result stale
+    size_t graph_version = Node::get_graph_version();
+    if (!cache.ops || cache.graph_version != graph_version)
+    {
+        cache.ops = make_shared<const std::list<shared_ptr<Node>>>(
+            topological_sort(get_ops(include_control_deps), include_control_deps));
+        cache.graph_version = graph_version;
+    }
+    return cache.ops;
 }
 
 const std::string& Function::get_friendly_name() const
@@ -185,4 +208,11 @@ std::list<shared_ptr<Node>> Function::get_ops(bool include_control_deps) const
 void Function::replace_node(std::shared_ptr<Node> old, std::shared_ptr<Node> repl)
 {
     ngraph::replace_node(old, repl);
+
+    // Release the replaced nodes now rather than at the next sort
+    lock_guard<mutex> lock(m_ordered_ops_mutex);
+    for (OrderedOps& cache : m_ordered_ops)
+    {
+        cache.ops.reset();
+    }
 }
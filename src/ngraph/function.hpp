@@ -20,6 +20,7 @@
 #include <initializer_list>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -74,7 +75,15 @@ namespace ngraph
         //  an XLA or regular function
         void set_name(const std::string& name);
         std::list<std::shared_ptr<Node>> get_ops(bool include_control_deps = true) const;
+        /// Return the ops in topological order. The order is cached and only sorted again
+        /// after the graph changes. The list is a copy, so the graph may be edited while
+        /// walking it.
         std::list<std::shared_ptr<Node>> get_ordered_ops(bool include_control_deps = true) const;
+        /// Return the cached topological order without copying it. The snapshot stays valid
+        /// while it is held, even if the graph is edited and sorted again, but it does not
+        /// show later edits. Hold the pointer for as long as the list is walked.
+        std::shared_ptr<const std::list<std::shared_ptr<Node>>>
+            get_ordered_ops_view(bool include_control_deps = true) const;
         friend std::ostream& operator<<(std::ostream&, const Function&);
         size_t get_instance_id() { return m_instance_id; }
         size_t get_temporary_pool_size();
@@ -98,5 +107,21 @@ namespace ngraph
         size_t m_instance_id;
         std::string m_name;
         const std::string m_unique_name;
+
+        struct OrderedOps
+        {
+            // Node::get_graph_version() when ops was sorted
+            size_t graph_version = 0;
+            // Replaced rather than modified, so snapshots handed out stay intact
+            std::shared_ptr<const std::list<std::shared_ptr<Node>>> ops;
+        };
+        // Returns the cached order, sorting again if the graph changed. Called with
+        // m_ordered_ops_mutex held.
+        std::shared_ptr<const std::list<std::shared_ptr<Node>>>
+            sort_ops(bool include_control_deps) const;
+
+        // Indexed by include_control_deps
+        mutable OrderedOps m_ordered_ops[2];
+        mutable std::mutex m_ordered_ops_mutex;
     };
 }
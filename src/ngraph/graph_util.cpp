@@ -136,6 +136,15 @@ void ngraph::traverse_functions(std::shared_ptr<ngraph::Function> p,
     }
 }
 
+// Passes run on the thread that calls pass::Manager::run_passes, which counts their
+// rewrites by the change in this counter.
+static thread_local size_t s_replace_node_count = 0;
+
+size_t ngraph::get_replace_node_count()
+{
+    return s_replace_node_count;
+}
+
 void ngraph::replace_node(std::shared_ptr<Node> target, std::shared_ptr<Node> replacement)
 {
     if (target->is_output())
@@ -151,6 +160,8 @@ void ngraph::replace_node(std::shared_ptr<Node> target, std::shared_ptr<Node> re
     // Fix input/output descriptors
     assert(target->get_outputs().size() == replacement->get_outputs().size());
 
+    s_replace_node_count++;
+
     // For each of target's output O with replacement output O_rep:
     //     For each O's connected downstream input I:
     //         Change I's connected upstream output to O_rep
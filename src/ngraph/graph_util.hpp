@@ -58,6 +58,9 @@ namespace ngraph
 
     void replace_node(std::shared_ptr<Node> target, std::shared_ptr<Node> replacement);
 
+    /// \brief Returns the number of replace_node calls made so far on the calling thread.
+    size_t get_replace_node_count();
+
     template <typename T>
     std::list<std::shared_ptr<Node>> topological_sort(const T& nodes,
                                                       bool include_control_deps = false)
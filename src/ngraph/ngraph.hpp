@@ -129,4 +129,5 @@
 #include "ngraph/runtime/backend.hpp"
 #include "ngraph/runtime/tensor_view.hpp"
 #include "ngraph/shape.hpp"
+#include "ngraph/strided_transform.hpp"
 #include "ngraph/type/element_type.hpp"
@@ -30,6 +30,7 @@ using namespace std;
 using namespace ngraph;
 
 atomic<size_t> Node::m_next_instance_id(0);
+atomic<size_t> Node::m_graph_version(0);
 
 Node::Node(const std::string& node_type, const NodeVector& arguments, size_t output_size)
     : m_node_type(node_type)
@@ -188,6 +189,23 @@ const std::set<std::shared_ptr<Node>>& Node::get_control_dependencies() const
 void Node::add_control_dependency(std::shared_ptr<Node> node)
 {
     m_control_dependencies.insert(node);
+    graph_changed();
+}
+
+void Node::remove_control_dependency(std::shared_ptr<Node> node)
+{
+    m_control_dependencies.erase(node);
+    graph_changed();
+}
+
+size_t Node::get_graph_version()
+{
+    return m_graph_version;
+}
+
+void Node::graph_changed()
+{
+    m_graph_version++;
 }
 
 std::vector<std::shared_ptr<Function>> Node::get_functions() const
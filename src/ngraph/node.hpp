@@ -151,10 +151,11 @@ namespace ngraph
 
         void add_control_dependency(std::shared_ptr<Node> node);
 
-        void remove_control_dependency(std::shared_ptr<Node> node)
-        {
-            m_control_dependencies.erase(node);
-        }
+        void remove_control_dependency(std::shared_ptr<Node> node);
+
+        /// Returns a number that changes whenever an argument or control dependency of any node
+        /// is replaced, added or removed, so that caches of graph structure can detect edits.
+        static size_t get_graph_version();
 
         /// Returns the number of outputs on the for the node.
         size_t get_output_size() const;
@@ -230,12 +231,15 @@ namespace ngraph
     protected:
         std::set<std::shared_ptr<Node>> m_control_dependencies;
         void set_output_size(size_t n);
+        /// Advances the graph version; called by every edit of an argument or control dependency
+        static void graph_changed();
 
         std::string m_node_type;
         size_t m_instance_id;
         std::string m_name;
         const std::string m_unique_name;
         static std::atomic<size_t> m_next_instance_id;
+        static std::atomic<size_t> m_graph_version;
         std::deque<descriptor::Input> m_inputs;
         std::deque<descriptor::Output> m_outputs;
         std::unordered_map<Node*, autodiff::Adjoints> m_adjoint_map;
@@ -54,7 +54,7 @@ string to_cpp_string(T value)
 
 op::Constant::~Constant()
 {
-    if (m_data)
+    if (m_data && !m_data_owner)
     {
         aligned_free(m_data);
     }
@@ -71,6 +71,20 @@ vector<string> op::Constant::get_value_strings() const
             rc.push_back(to_string(value));
         }
     }
+    else if (m_element_type == element::bf16)
+    {
+        for (float value : get_vector<bfloat16>())
+        {
+            rc.push_back(to_cpp_string(value));
+        }
+    }
+    else if (m_element_type == element::f16)
+    {
+        for (float value : get_vector<float16>())
+        {
+            rc.push_back(to_cpp_string(value));
+        }
+    }
     else if (m_element_type == element::f32)
     {
         for (float value : get_vector<float>())
@@ -152,6 +166,10 @@ vector<string> op::Constant::get_value_strings() const
 shared_ptr<Node> op::Constant::copy_with_new_args(const NodeVector& new_args) const
 {
     check_new_args_count(this, new_args);
+    if (m_data_owner)
+    {
+        return make_shared<Constant>(m_element_type, m_shape, m_data, m_data_owner);
+    }
     return make_shared<Constant>(m_element_type, m_shape, m_data);
 }
 
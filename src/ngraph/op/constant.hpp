@@ -104,6 +104,28 @@ namespace ngraph
                 constructor_validate_and_infer_types();
             }
 
+            /// \brief Constructs a tensor constant that refers to existing data without copying
+            ///        it, e.g. weights in a memory mapped model file.
+            ///
+            /// \param type The element type of the tensor constant.
+            /// \param shape The shape of the tensor constant.
+            /// \param data A void* to constant data. Must stay valid and unmodified as long as
+            ///        owner is alive.
+            /// \param owner Keeps the storage behind data alive; shared by every copy of the
+            ///        constant.
+            Constant(const element::Type& type,
+                     const Shape& shape,
+                     const void* data,
+                     const std::shared_ptr<const void>& owner)
+                : Node("Constant", {})
+                , m_element_type(type)
+                , m_shape(shape)
+                , m_data(const_cast<void*>(data))
+                , m_data_owner(owner)
+            {
+                constructor_validate_and_infer_types();
+            }
+
             virtual ~Constant() override;
 
             void validate_and_infer_types() override
@@ -210,6 +232,14 @@ namespace ngraph
                 {
                     write_buffer<char, T>(target, source, target_element_count);
                 }
+                else if (target_type == element::bf16)
+                {
+                    write_buffer<bfloat16, T>(target, source, target_element_count);
+                }
+                else if (target_type == element::f16)
+                {
+                    write_buffer<float16, T>(target, source, target_element_count);
+                }
                 else if (target_type == element::f32)
                 {
                     write_buffer<float, T>(target, source, target_element_count);
@@ -259,6 +289,8 @@ namespace ngraph
             element::Type m_element_type;
             Shape m_shape{};
             void* m_data{nullptr};
+            /// If set, m_data points into storage owned by this rather than by the constant
+            std::shared_ptr<const void> m_data_owner;
             Constant(const Constant&) = delete;
             Constant(Constant&&) = delete;
             Constant operator=(const Constant*) = delete;
@@ -46,7 +46,8 @@ bool pass::CommonFunctionCollection::run_on_module(vector<shared_ptr<Function>>&
     const string function_name = "__f__";
     for (const shared_ptr<Function>& current_function : functions)
     {
-        for (const shared_ptr<Node>& n : current_function->get_ordered_ops())
+        auto ordered_ops = current_function->get_ordered_ops_view();
+        for (const shared_ptr<Node>& n : *ordered_ops)
         {
             if (n->is_constant() || n->is_parameter())
             {
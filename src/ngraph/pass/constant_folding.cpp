@@ -15,18 +15,63 @@
 //*****************************************************************************
 
 #include <stdint.h>
+#include <unordered_map>
 
 #include "constant_folding.hpp"
 #include "ngraph/graph_util.hpp"
 #include "ngraph/op/broadcast.hpp"
 #include "ngraph/op/constant.hpp"
+#include "ngraph/op/dot.hpp"
 #include "ngraph/op/pad.hpp"
 #include "ngraph/op/reshape.hpp"
+#include "ngraph/op/util/arithmetic_reduction.hpp"
 #include "ngraph/pattern/matcher.hpp"
 #include "ngraph/pattern/op/label.hpp"
+#include "ngraph/runtime/reference/abs.hpp"
+#include "ngraph/runtime/reference/acos.hpp"
+#include "ngraph/runtime/reference/add.hpp"
+#include "ngraph/runtime/reference/and.hpp"
+#include "ngraph/runtime/reference/asin.hpp"
+#include "ngraph/runtime/reference/atan.hpp"
 #include "ngraph/runtime/reference/broadcast.hpp"
+#include "ngraph/runtime/reference/ceiling.hpp"
+#include "ngraph/runtime/reference/convert.hpp"
+#include "ngraph/runtime/reference/cos.hpp"
+#include "ngraph/runtime/reference/cosh.hpp"
+#include "ngraph/runtime/reference/divide.hpp"
+#include "ngraph/runtime/reference/dot.hpp"
+#include "ngraph/runtime/reference/equal.hpp"
+#include "ngraph/runtime/reference/exp.hpp"
+#include "ngraph/runtime/reference/floor.hpp"
+#include "ngraph/runtime/reference/greater.hpp"
+#include "ngraph/runtime/reference/greater_eq.hpp"
+#include "ngraph/runtime/reference/less.hpp"
+#include "ngraph/runtime/reference/less_eq.hpp"
+#include "ngraph/runtime/reference/log.hpp"
+#include "ngraph/runtime/reference/max.hpp"
+#include "ngraph/runtime/reference/maximum.hpp"
+#include "ngraph/runtime/reference/min.hpp"
+#include "ngraph/runtime/reference/minimum.hpp"
+#include "ngraph/runtime/reference/multiply.hpp"
+#include "ngraph/runtime/reference/negate.hpp"
+#include "ngraph/runtime/reference/not.hpp"
+#include "ngraph/runtime/reference/not_equal.hpp"
+#include "ngraph/runtime/reference/or.hpp"
 #include "ngraph/runtime/reference/pad.hpp"
+#include "ngraph/runtime/reference/power.hpp"
+#include "ngraph/runtime/reference/product.hpp"
+#include "ngraph/runtime/reference/relu.hpp"
 #include "ngraph/runtime/reference/reshape.hpp"
+#include "ngraph/runtime/reference/select.hpp"
+#include "ngraph/runtime/reference/sigmoid.hpp"
+#include "ngraph/runtime/reference/sign.hpp"
+#include "ngraph/runtime/reference/sin.hpp"
+#include "ngraph/runtime/reference/sinh.hpp"
+#include "ngraph/runtime/reference/sqrt.hpp"
+#include "ngraph/runtime/reference/subtract.hpp"
+#include "ngraph/runtime/reference/sum.hpp"
+#include "ngraph/runtime/reference/tan.hpp"
+#include "ngraph/runtime/reference/tanh.hpp"
 
 using namespace std;
 using namespace ngraph;
@@ -231,3 +276,299 @@ void ngraph::pass::ConstantFolding::construct_constant_broadcast()
     auto broadcast_matcher = make_shared<pattern::Matcher>(broadcast, constant_broadcast_callback);
     this->add_matcher(broadcast_matcher);
 }
+
+// This expands the op list in op_tbl.hpp into a list of enumerations that look like this:
+// Abs,
+// Acos,
+// ...
+// Other files define their own OP_TYPEID, so this one must have internal linkage
+namespace
+{
+#define NGRAPH_OP(a, b) a,
+    enum class OP_TYPEID
+    {
+#include "ngraph/op/op_tbl.hpp"
+        UnknownOp
+    };
+#undef NGRAPH_OP
+}
+
+static OP_TYPEID get_typeid(const Node& node)
+{
+// This expands the op list in op_tbl.hpp into a list of enumerations that look like this:
+// {"Abs", OP_TYPEID::Abs},
+// {"Acos", OP_TYPEID::Acos},
+// ...
+#define NGRAPH_OP(a, b) {#a, OP_TYPEID::a},
+    static const unordered_map<string, OP_TYPEID> typeid_map{
+#include "ngraph/op/op_tbl.hpp"
+    };
+#undef NGRAPH_OP
+    auto it = typeid_map.find(node.description());
+    return it == typeid_map.end() ? OP_TYPEID::UnknownOp : it->second;
+}
+
+template <typename T>
+static void convert_constant(const Node& node, const T* arg, void* out, size_t count)
+{
+    const element::Type& type = node.get_element_type();
+    if (type == element::boolean)
+    {
+        runtime::reference::convert<T>(arg, static_cast<char*>(out), count);
+    }
+    else if (type == element::f32)
+    {
+        runtime::reference::convert<T>(arg, static_cast<float*>(out), count);
+    }
+    else if (type == element::f64)
+    {
+        runtime::reference::convert<T>(arg, static_cast<double*>(out), count);
+    }
+    else if (type == element::i8)
+    {
+        runtime::reference::convert<T>(arg, static_cast<int8_t*>(out), count);
+    }
+    else if (type == element::i16)
+    {
+        runtime::reference::convert<T>(arg, static_cast<int16_t*>(out), count);
+    }
+    else if (type == element::i32)
+    {
+        runtime::reference::convert<T>(arg, static_cast<int32_t*>(out), count);
+    }
+    else if (type == element::i64)
+    {
+        runtime::reference::convert<T>(arg, static_cast<int64_t*>(out), count);
+    }
+    else if (type == element::u8)
+    {
+        runtime::reference::convert<T>(arg, static_cast<uint8_t*>(out), count);
+    }
+    else if (type == element::u16)
+    {
+        runtime::reference::convert<T>(arg, static_cast<uint16_t*>(out), count);
+    }
+    else if (type == element::u32)
+    {
+        runtime::reference::convert<T>(arg, static_cast<uint32_t*>(out), count);
+    }
+    else if (type == element::u64)
+    {
+        runtime::reference::convert<T>(arg, static_cast<uint64_t*>(out), count);
+    }
+    else
+    {
+        throw ngraph_error("Cannot fold Convert to " + type.c_type_string());
+    }
+}
+
+// Computes the output of node from the data of its constant arguments. T is the element type
+// of the data arguments; comparisons produce char and Convert produces the node's type.
+// Returns false for ops that cannot be folded.
+template <typename T>
+static bool evaluate_constant(const Node& node, const vector<const void*>& args, void* out)
+{
+    namespace reference = runtime::reference;
+    auto arg = [&args](size_t i) { return static_cast<const T*>(args.at(i)); };
+    T* result = static_cast<T*>(out);
+    char* predicate = static_cast<char*>(out);
+    size_t count = shape_size(node.get_shape());
+
+    switch (get_typeid(node))
+    {
+    case OP_TYPEID::Abs: reference::abs<T>(arg(0), result, count); break;
+    case OP_TYPEID::Acos: reference::acos<T>(arg(0), result, count); break;
+    case OP_TYPEID::Asin: reference::asin<T>(arg(0), result, count); break;
+    case OP_TYPEID::Atan: reference::atan<T>(arg(0), result, count); break;
+    case OP_TYPEID::Ceiling: reference::ceiling<T>(arg(0), result, count); break;
+    case OP_TYPEID::Cos: reference::cos<T>(arg(0), result, count); break;
+    case OP_TYPEID::Cosh: reference::cosh<T>(arg(0), result, count); break;
+    case OP_TYPEID::Exp: reference::exp<T>(arg(0), result, count); break;
+    case OP_TYPEID::Floor: reference::floor<T>(arg(0), result, count); break;
+    case OP_TYPEID::Log: reference::log<T>(arg(0), result, count); break;
+    case OP_TYPEID::Negative: reference::negate<T>(arg(0), result, count); break;
+    case OP_TYPEID::Not: reference::logical_not<T>(arg(0), result, count); break;
+    case OP_TYPEID::Relu: reference::relu<T>(arg(0), result, count); break;
+    case OP_TYPEID::Sigmoid: reference::sigmoid<T>(arg(0), result, count); break;
+    case OP_TYPEID::Sign: reference::sign<T>(arg(0), result, count); break;
+    case OP_TYPEID::Sin: reference::sin<T>(arg(0), result, count); break;
+    case OP_TYPEID::Sinh: reference::sinh<T>(arg(0), result, count); break;
+    case OP_TYPEID::Sqrt: reference::sqrt<T>(arg(0), result, count); break;
+    case OP_TYPEID::Tan: reference::tan<T>(arg(0), result, count); break;
+    case OP_TYPEID::Tanh: reference::tanh<T>(arg(0), result, count); break;
+    case OP_TYPEID::Add: reference::add<T>(arg(0), arg(1), result, count); break;
+    case OP_TYPEID::And: reference::logical_and<T>(arg(0), arg(1), result, count); break;
+    case OP_TYPEID::Divide: reference::divide<T>(arg(0), arg(1), result, count); break;
+    case OP_TYPEID::Maximum: reference::maximum<T>(arg(0), arg(1), result, count); break;
+    case OP_TYPEID::Minimum: reference::minimum<T>(arg(0), arg(1), result, count); break;
+    case OP_TYPEID::Multiply: reference::multiply<T>(arg(0), arg(1), result, count); break;
+    case OP_TYPEID::Or: reference::logical_or<T>(arg(0), arg(1), result, count); break;
+    case OP_TYPEID::Power: reference::power<T>(arg(0), arg(1), result, count); break;
+    case OP_TYPEID::Subtract: reference::subtract<T>(arg(0), arg(1), result, count); break;
+    case OP_TYPEID::Equal: reference::equal<T>(arg(0), arg(1), predicate, count); break;
+    case OP_TYPEID::Greater: reference::greater<T>(arg(0), arg(1), predicate, count); break;
+    case OP_TYPEID::GreaterEq: reference::greater_eq<T>(arg(0), arg(1), predicate, count); break;
+    case OP_TYPEID::Less: reference::less<T>(arg(0), arg(1), predicate, count); break;
+    case OP_TYPEID::LessEq: reference::less_eq<T>(arg(0), arg(1), predicate, count); break;
+    case OP_TYPEID::NotEqual: reference::not_equal<T>(arg(0), arg(1), predicate, count); break;
+    case OP_TYPEID::Convert: convert_constant<T>(node, arg(0), out, count); break;
+    case OP_TYPEID::Select:
+    {
+        reference::select<T>(
+            static_cast<const char*>(args.at(0)), arg(1), arg(2), result, count);
+        break;
+    }
+    case OP_TYPEID::Sum:
+    case OP_TYPEID::Product:
+    case OP_TYPEID::Max:
+    case OP_TYPEID::Min:
+    {
+        auto reduction = static_cast<const op::util::ArithmeticReduction*>(&node);
+        const Shape& in_shape = node.get_input_shape(0);
+        const Shape& out_shape = node.get_shape();
+        const AxisSet& axes = reduction->get_reduction_axes();
+        switch (get_typeid(node))
+        {
+        case OP_TYPEID::Sum: reference::sum<T>(arg(0), result, in_shape, out_shape, axes); break;
+        case OP_TYPEID::Product:
+            reference::product<T>(arg(0), result, in_shape, out_shape, axes);
+            break;
+        case OP_TYPEID::Max: reference::max<T>(arg(0), result, in_shape, out_shape, axes); break;
+        default: reference::min<T>(arg(0), result, in_shape, out_shape, axes); break;
+        }
+        break;
+    }
+    case OP_TYPEID::Dot:
+    {
+        auto dot = static_cast<const op::Dot*>(&node);
+        reference::dot<T>(arg(0),
+                          arg(1),
+                          result,
+                          node.get_input_shape(0),
+                          node.get_input_shape(1),
+                          node.get_shape(),
+                          dot->get_reduction_axes_count());
+        break;
+    }
+    default: return false;
+    }
+    return true;
+}
+
+static bool evaluate_constant(const element::Type& type,
+                              const Node& node,
+                              const vector<const void*>& args,
+                              void* out)
+{
+    bool rc = false;
+    if (type == element::boolean)
+    {
+        rc = evaluate_constant<char>(node, args, out);
+    }
+    else if (type == element::f32)
+    {
+        rc = evaluate_constant<float>(node, args, out);
+    }
+    else if (type == element::f64)
+    {
+        rc = evaluate_constant<double>(node, args, out);
+    }
+    else if (type == element::i8)
+    {
+        rc = evaluate_constant<int8_t>(node, args, out);
+    }
+    else if (type == element::i16)
+    {
+        rc = evaluate_constant<int16_t>(node, args, out);
+    }
+    else if (type == element::i32)
+    {
+        rc = evaluate_constant<int32_t>(node, args, out);
+    }
+    else if (type == element::i64)
+    {
+        rc = evaluate_constant<int64_t>(node, args, out);
+    }
+    else if (type == element::u8)
+    {
+        rc = evaluate_constant<uint8_t>(node, args, out);
+    }
+    else if (type == element::u16)
+    {
+        rc = evaluate_constant<uint16_t>(node, args, out);
+    }
+    else if (type == element::u32)
+    {
+        rc = evaluate_constant<uint32_t>(node, args, out);
+    }
+    else if (type == element::u64)
+    {
+        rc = evaluate_constant<uint64_t>(node, args, out);
+    }
+    return rc;
+}
+
+void ngraph::pass::ConstantFolding::construct_constant_arithmetic()
+{
+    size_t max_folded_bytes = m_max_folded_bytes;
+    auto is_foldable = [max_folded_bytes](shared_ptr<Node> node) {
+        if (node->is_constant() || node->get_arguments().empty() ||
+            node->get_output_size() != 1)
+        {
+            return false;
+        }
+        size_t arg_bytes = 0;
+        for (auto arg : node->get_arguments())
+        {
+            if (!arg->is_constant() || arg->get_output_size() != 1)
+            {
+                return false;
+            }
+            arg_bytes += shape_size(arg->get_shape()) * arg->get_element_type().size();
+        }
+        // Folding must not grow the graph's constants past the limit
+        size_t out_bytes = shape_size(node->get_shape()) * node->get_element_type().size();
+        return out_bytes <= max_folded_bytes || out_bytes <= arg_bytes;
+    };
+    // The label matches any node that is_foldable accepts, whatever its type
+    auto root = make_shared<pattern::op::Label>(element::f32, Shape{}, is_foldable);
+
+    auto constant_arithmetic_callback = [](pattern::Matcher& m) {
+        NGRAPH_DEBUG << "In callback for constant_arithmetic_callback against node = "
+                     << m.get_match_root()->get_name();
+
+        auto node = m.get_match_root();
+        vector<const void*> args;
+        for (auto arg : node->get_arguments())
+        {
+            args.push_back(static_pointer_cast<op::Constant>(arg)->get_data_ptr());
+        }
+        // Select computes in the type of its data arguments, not of its predicate
+        size_t type_arg = node->description() == "Select" ? 1 : 0;
+        const element::Type& type = node->get_input_element_type(type_arg);
+
+        size_t out_bytes = shape_size(node->get_shape()) * node->get_element_type().size();
+        vector<char> out(out_bytes);
+        try
+        {
+            if (!evaluate_constant(type, *node, args, out.data()))
+            {
+                return false;
+            }
+        }
+        catch (const exception& e)
+        {
+            // e.g. integer division by zero; leave the failure to execution time
+            NGRAPH_DEBUG << "Not folding " << node->get_name() << ": " << e.what();
+            return false;
+        }
+
+        replace_node(node,
+                     make_shared<op::Constant>(
+                         node->get_element_type(), node->get_shape(), out.data()));
+        return true;
+    };
+
+    auto arithmetic_matcher = make_shared<pattern::Matcher>(root, constant_arithmetic_callback);
+    this->add_matcher(arithmetic_matcher);
+}
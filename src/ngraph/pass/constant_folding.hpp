@@ -28,26 +28,36 @@ namespace ngraph
 
 class ngraph::pass::ConstantFolding : public ngraph::pass::GraphRewrite
 {
+public:
     enum class CFTransformations
     {
         RESHAPE,
         BROADCAST,
-        PAD
+        PAD,
+        ARITHMETIC
     };
 
-public:
-    ConstantFolding()
+    /// \brief Default limit on the size of a constant created by ARITHMETIC folding
+    static const size_t s_default_max_folded_bytes = 16 * 1024 * 1024;
+
+    /// \param max_folded_bytes ARITHMETIC folding never creates a constant larger than both
+    ///     this limit and the combined size of the constants it replaces
+    ConstantFolding(size_t max_folded_bytes = s_default_max_folded_bytes)
         : GraphRewrite()
+        , m_max_folded_bytes(max_folded_bytes)
     {
         construct_constant_reshape();
         construct_constant_broadcast();
         construct_constant_pad();
+        construct_constant_arithmetic();
     }
 
     //this allows to specify the order in which matchers will be run
     //and also allows to register the same matcher more than once
-    ConstantFolding(const std::vector<CFTransformations>& transformations)
+    ConstantFolding(const std::vector<CFTransformations>& transformations,
+                    size_t max_folded_bytes = s_default_max_folded_bytes)
         : GraphRewrite()
+        , m_max_folded_bytes(max_folded_bytes)
     {
         for (auto cft : transformations)
         {
@@ -56,6 +66,7 @@ public:
             case CFTransformations::RESHAPE: construct_constant_reshape(); break;
             case CFTransformations::BROADCAST: construct_constant_broadcast(); break;
             case CFTransformations::PAD: construct_constant_pad(); break;
+            case CFTransformations::ARITHMETIC: construct_constant_arithmetic(); break;
             }
         }
     }
@@ -64,4 +75,9 @@ private:
     void construct_constant_reshape();
     void construct_constant_broadcast();
     void construct_constant_pad();
+    /// Evaluates elementwise, comparison, logical, Convert, Select, reduction and Dot ops
+    /// whose arguments are all constants with the reference kernels
+    void construct_constant_arithmetic();
+
+    size_t m_max_folded_bytes;
 };
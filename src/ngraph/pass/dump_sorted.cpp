@@ -39,7 +39,8 @@ bool pass::DumpSorted::run_on_module(vector<shared_ptr<Function>>& functions)
             out << "=====================================================================\n";
             out << f->get_name() << " start\n";
             out << "=====================================================================\n";
-            for (const shared_ptr<Node>& node : f->get_ordered_ops())
+            auto ordered_ops = f->get_ordered_ops_view();
+            for (const shared_ptr<Node>& node : *ordered_ops)
             {
                 out << node->get_name() << "(";
                 vector<string> inputs;
@@ -15,34 +15,106 @@
 //*****************************************************************************
 
 #include <algorithm>
+#include <cstdlib>
+#include <iomanip>
 #include <iostream>
+#include <typeindex>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "graph_rewrite.hpp"
 #include "ngraph/log.hpp"
 #include "ngraph/pattern/matcher.hpp"
+#include "ngraph/util.hpp"
+
+using namespace std;
 
 bool ngraph::pass::GraphRewrite::run_matchers_on_nodes_list(
     const std::list<std::shared_ptr<ngraph::Node>>& nodes,
     const std::vector<std::shared_ptr<pattern::Matcher>>& matchers,
     std::shared_ptr<ngraph::Function> f)
 {
+    bool profile_enabled = getenv("NGRAPH_PROFILE_PASS_ENABLE") != nullptr;
+
+    // A pattern can only match nodes of the type of its root, so every node is only tried
+    // against the matchers for its own type and those whose root matches any type. The
+    // candidates keep the order in which the matchers were added.
+    vector<const type_info*> root_types;
+    for (auto matcher : matchers)
+    {
+        root_types.push_back(matcher->get_root_type());
+    }
+    unordered_map<type_index, vector<size_t>> candidates_by_type;
+
+    vector<stopwatch> timers(profile_enabled ? matchers.size() : 0);
+    vector<size_t> attempt_counts(matchers.size());
+    vector<size_t> match_counts(matchers.size());
+    for (size_t i = 0; i < matchers.size(); i++)
+    {
+        attempt_counts[i] = matchers[i]->get_attempt_count();
+        match_counts[i] = matchers[i]->get_match_count();
+    }
+
     bool rewritten = false;
     for (auto node : nodes)
     {
-        for (auto matcher : matchers)
+        auto p_node = node.get();
+        type_index node_type(typeid(*p_node));
+        auto it = candidates_by_type.find(node_type);
+        if (it == candidates_by_type.end())
+        {
+            vector<size_t> candidates;
+            for (size_t i = 0; i < matchers.size(); i++)
+            {
+                if (!root_types[i] || type_index(*root_types[i]) == node_type)
+                {
+                    candidates.push_back(i);
+                }
+            }
+            it = candidates_by_type.insert({node_type, candidates}).first;
+        }
+
+        for (size_t i : it->second)
         {
+            auto matcher = matchers[i];
             NGRAPH_DEBUG << "Running matcher " << matcher->get_name() << "("
                          << matcher->get_pattern()->get_name() << ") on " << node->get_name();
-            if (matcher->match(node))
+            if (profile_enabled)
+            {
+                timers[i].start();
+            }
+            bool is_match = matcher->match(node);
+            bool is_processed = false;
+            if (is_match)
             {
                 NGRAPH_DEBUG << "Matcher " << matcher << matcher->get_name() << " matched "
                              << node->get_name();
                 rewritten = true;
-                if (matcher->process_match())
-                {
-                    break;
-                }
+                is_processed = matcher->process_match();
+            }
+            if (profile_enabled)
+            {
+                timers[i].stop();
+            }
+            if (is_processed)
+            {
+                break;
+            }
+        }
+    }
+
+    if (profile_enabled)
+    {
+        for (size_t i = 0; i < matchers.size(); i++)
+        {
+            size_t attempts = matchers[i]->get_attempt_count() - attempt_counts[i];
+            if (attempts > 0)
+            {
+                cout << setw(7) << timers[i].get_total_microseconds() << "us "
+                     << matchers[i]->get_name() << "(" << matchers[i]->get_pattern()->get_name()
+                     << ") matched "
+                     << matchers[i]->get_match_count() - match_counts[i] << " of " << attempts
+                     << " nodes\n";
             }
         }
     }
@@ -35,7 +35,8 @@ using namespace ngraph;
 
 bool pass::Liveness::run_on_function(shared_ptr<ngraph::Function> function)
 {
-    list<shared_ptr<Node>> ops = function->get_ordered_ops();
+    auto ordered_ops = function->get_ordered_ops_view();
+    const list<shared_ptr<Node>>& ops = *ordered_ops;
 
     unordered_set<descriptor::Tensor*> persistent_tensors;
     unordered_set<descriptor::Tensor*> output_tensors;
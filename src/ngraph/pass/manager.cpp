@@ -19,6 +19,7 @@
 #else
 #include <cxxabi.h>
 #endif
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <memory>
@@ -33,6 +34,7 @@
 #include "ngraph/pass/serialize.hpp"
 #include "ngraph/pass/visualize_tree.hpp"
 #include "ngraph/util.hpp"
+#include "nlohmann/json.hpp"
 
 using namespace std;
 using namespace ngraph;
@@ -49,6 +51,11 @@ ngraph::pass::Manager::Manager()
     {
         m_serialize = true;
     }
+    static const auto npt = std::getenv("NGRAPH_PASS_TRACING");
+    if (npt)
+    {
+        m_trace = true;
+    }
 }
 
 ngraph::pass::Manager::~Manager()
@@ -61,7 +68,8 @@ void ngraph::pass::Manager::initialize_default_passes()
 
 void ngraph::pass::Manager::run_passes(shared_ptr<Function> func, bool transitive)
 {
-    bool profile_enabled = getenv("NGRAPH_PROFILE_PASS_ENABLE") != nullptr;
+    bool print_profile = getenv("NGRAPH_PROFILE_PASS_ENABLE") != nullptr;
+    bool profile_enabled = m_profile || m_trace || print_profile;
 
     vector<shared_ptr<Function>> fs;
     if (transitive)
@@ -76,12 +84,29 @@ void ngraph::pass::Manager::run_passes(shared_ptr<Function> func, bool transitiv
     set<shared_ptr<Function>> tfs(begin(fs), end(fs));
     get_state().set_functions(tfs);
 
+    auto count_nodes = [&fs]() {
+        size_t node_count = 0;
+        for (shared_ptr<Function> f : fs)
+        {
+            node_count += f->get_ops().size();
+        }
+        return node_count;
+    };
+    m_pass_profiles.clear();
+
     size_t index = 0;
     stopwatch pass_timer;
     stopwatch overall_timer;
     overall_timer.start();
     for (shared_ptr<PassBase> pass : m_pass_list)
     {
+        PassProfile profile;
+        if (profile_enabled)
+        {
+            profile.node_count_before = count_nodes();
+            profile.replaced_node_count = get_replace_node_count();
+            profile.start = overall_timer.get_microseconds();
+        }
         pass_timer.start();
         pass->set_state(get_state());
         auto module_pass = dynamic_pointer_cast<ModulePass>(pass);
@@ -154,15 +179,59 @@ void ngraph::pass::Manager::run_passes(shared_ptr<Function> func, bool transitiv
             string name = typeid(*p).name();
 #ifndef WIN32
             int status;
-            name = abi::__cxa_demangle(name.c_str(), 0, 0, &status);
+            char* demangled = abi::__cxa_demangle(name.c_str(), 0, 0, &status);
+            if (demangled)
+            {
+                name = demangled;
+                free(demangled);
+            }
 #endif
-            cout << setw(7) << pass_timer.get_milliseconds() << "ms " << name << "\n";
+            profile.pass_name = name;
+            profile.duration = pass_timer.get_microseconds();
+            profile.node_count_after = count_nodes();
+            profile.replaced_node_count = get_replace_node_count() - profile.replaced_node_count;
+            m_pass_profiles.push_back(profile);
+        }
+        if (print_profile)
+        {
+            const PassProfile& profile = m_pass_profiles.back();
+            cout << setw(7) << profile.duration / 1000 << "ms " << profile.pass_name << " ("
+                 << profile.node_count_before << " -> " << profile.node_count_after
+                 << " nodes, " << profile.replaced_node_count << " replaced)\n";
         }
     }
-    if (profile_enabled)
+    if (print_profile)
     {
         cout << "passes done in " << overall_timer.get_milliseconds() << "ms\n";
     }
+    if (m_trace)
+    {
+        write_pass_timeline(fs.at(0)->get_name() + ".passes.timeline.json");
+    }
+}
+
+void ngraph::pass::Manager::write_pass_timeline(const string& file_name) const
+{
+    nlohmann::json trace = nlohmann::json::array();
+    for (const PassProfile& profile : m_pass_profiles)
+    {
+        trace.push_back({{"ph", "X"},
+                         {"cat", "Pass"},
+                         {"name", profile.pass_name},
+                         {"pid", 0},
+                         {"tid", 0},
+                         {"ts", profile.start},
+                         {"dur", profile.duration},
+                         {"args",
+                          {{"node_count_before", profile.node_count_before},
+                           {"node_count_after", profile.node_count_after},
+                           {"replaced_node_count", profile.replaced_node_count}}}});
+    }
+
+    nlohmann::json timeline;
+    timeline["traceEvents"] = trace;
+    ofstream out(file_name);
+    out << timeline;
 }
 
 ngraph::pass::ManagerState& ngraph::pass::Manager::get_state()
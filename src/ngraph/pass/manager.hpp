@@ -16,8 +16,10 @@
 
 #pragma once
 
+#include <cstdint>
 #include <list>
 #include <memory>
+#include <string>
 #include <typeinfo>
 #include <vector>
 
@@ -30,9 +32,24 @@ namespace ngraph
     {
         class Manager;
         class ManagerState;
+        struct PassProfile;
     }
 }
 
+/// \brief What pass::Manager measured while running one pass, over all the functions it ran on
+struct ngraph::pass::PassProfile
+{
+    std::string pass_name;
+    /// Microseconds from the start of run_passes to the start of the pass
+    int64_t start;
+    /// Wall time of the pass in microseconds, including graph validation after it
+    int64_t duration;
+    size_t node_count_before;
+    size_t node_count_after;
+    /// The number of nodes the pass replaced with replace_node
+    size_t replaced_node_count;
+};
+
 class ngraph::pass::Manager
 {
 public:
@@ -48,10 +65,7 @@ public:
         auto pass = std::make_shared<T>(std::forward<Args>(args)...);
         auto pass_base = std::static_pointer_cast<PassBase>(pass);
         m_pass_list.push_back(pass_base);
-        if (m_visualize || m_serialize)
-        {
-            m_pass_names.push_back(typeid(T).name());
-        }
+        m_pass_names.push_back(typeid(T).name());
     }
 
     void run_passes(std::shared_ptr<Function>, bool transitive = true);
@@ -59,10 +73,23 @@ public:
     ManagerState& get_state();
     void set_pass_visualization(bool new_state) { m_visualize = new_state; }
     void set_pass_serialization(bool new_state) { m_serialize = new_state; }
+    /// \brief Records a PassProfile for every pass run by run_passes. Profiling is also on
+    ///        while NGRAPH_PROFILE_PASS_ENABLE or NGRAPH_PASS_TRACING is set.
+    void set_pass_profiling(bool new_state) { m_profile = new_state; }
+    /// \brief The profiles of the passes run by the last call to run_passes, in order
+    const std::vector<PassProfile>& get_pass_profiles() const { return m_pass_profiles; }
+    /// \brief Writes the pass profiles as a Chrome trace (chrome://tracing). If
+    ///        NGRAPH_PASS_TRACING is set, run_passes writes one named after the outermost
+    ///        function, <function name>.passes.timeline.json.
+    void write_pass_timeline(const std::string& file_name) const;
+
 private:
     std::vector<std::string> m_pass_names;
     std::vector<std::shared_ptr<PassBase>> m_pass_list;
     ManagerState m_state;
     bool m_visualize = false;
     bool m_serialize = false;
+    bool m_profile = false;
+    bool m_trace = false;
+    std::vector<PassProfile> m_pass_profiles;
 };
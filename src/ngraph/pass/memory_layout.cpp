@@ -14,11 +14,16 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <algorithm>
 #include <exception>
+#include <limits>
+#include <map>
+#include <set>
 #include <sstream>
+#include <unordered_map>
 
 #include "ngraph/log.hpp"
-#include "ngraph/log.hpp"
+#include "ngraph/op/op.hpp"
 #include "ngraph/pass/liveness.hpp"
 #include "ngraph/pass/manager.hpp"
 #include "ngraph/pass/memory_layout.hpp"
@@ -27,40 +32,106 @@
 using namespace std;
 using namespace ngraph;
 
-pass::MemoryLayout::MemoryLayout(size_t alignment, bool disable_memory_sharing)
+pass::MemoryLayout::MemoryLayout(size_t alignment,
+                                 bool disable_memory_sharing,
+                                 bool offline_planning)
     : m_alignment(alignment)
     , m_disable_memory_sharing(disable_memory_sharing)
+    , m_offline_planning(offline_planning)
 {
 }
 
-bool pass::MemoryLayout::run_on_function(shared_ptr<ngraph::Function> function)
+// Input tensors whose memory the outputs of this node take over, keyed by output
+static map<descriptor::Tensor*, descriptor::Tensor*> get_in_place_outputs(Node& node)
 {
-    MemoryManager mm(m_alignment, m_disable_memory_sharing);
-    for (shared_ptr<Node> node : function->get_ordered_ops())
+    map<descriptor::Tensor*, descriptor::Tensor*> in_place_outputs;
+    if (auto op = dynamic_cast<op::Op*>(&node))
     {
-        std::map<descriptor::Tensor*, descriptor::Tensor*> in_place_outputs;
-        std::set<const descriptor::Tensor*> reused_inputs;
-
-        if (auto op = std::dynamic_pointer_cast<op::Op>(node))
+        if (auto op_annotations = op->get_op_annotations())
         {
-            if (auto op_annotations = op->get_op_annotations())
+            for (auto oi_pair : op_annotations->get_in_place_oi_pairs())
             {
-                for (auto oi_pair : op_annotations->get_in_place_oi_pairs())
+                auto output = &node.get_outputs().at(oi_pair.output).get_tensor();
+                auto input = &node.get_inputs().at(oi_pair.input).get_tensor();
+
+                // an input tensor can be reused if this is the last use
+                if (node.liveness_free_list.count(input) != 0 &&
+                    node.liveness_new_list.count(output) != 0)
                 {
-                    auto output = &node->get_outputs().at(oi_pair.output).get_tensor();
-                    auto input = &node->get_inputs().at(oi_pair.input).get_tensor();
-                    auto input_node = node->get_inputs().at(oi_pair.input).get_output().get_node();
-
-                    // an input tensor can be reused if this is the last use
-                    if (node->liveness_free_list.count(input) != 0 &&
-                        node->liveness_new_list.count(output) != 0)
-                    {
-                        in_place_outputs.insert({output, input});
-                        reused_inputs.insert(input);
-                    }
+                    in_place_outputs.insert({output, input});
                 }
             }
         }
+    }
+    return in_place_outputs;
+}
+
+void pass::MemoryLayout::plan_offline(shared_ptr<ngraph::Function> function)
+{
+    // Tensors sharing memory in place form one buffer that lives until the last of them dies
+    MemoryPlanner planner(m_alignment);
+    unordered_map<descriptor::Tensor*, size_t> buffer_ids;
+    size_t step = 0;
+    auto ordered_ops = function->get_ordered_ops_view();
+    for (const shared_ptr<Node>& node : *ordered_ops)
+    {
+        auto in_place_outputs = get_in_place_outputs(*node);
+        set<const descriptor::Tensor*> reused_inputs;
+        for (descriptor::Tensor* tensor : node->liveness_new_list)
+        {
+            auto it = in_place_outputs.find(tensor);
+            if (it != in_place_outputs.end())
+            {
+                size_t id = buffer_ids.at(it->second);
+                planner.extend_buffer(id, tensor->size(), numeric_limits<size_t>::max());
+                buffer_ids[tensor] = id;
+                reused_inputs.insert(it->second);
+            }
+            else
+            {
+                buffer_ids[tensor] =
+                    planner.add_buffer(tensor->size(), step, numeric_limits<size_t>::max());
+            }
+        }
+        for (descriptor::Tensor* tensor : node->liveness_free_list)
+        {
+            if (reused_inputs.count(tensor) == 0)
+            {
+                planner.extend_buffer(buffer_ids.at(tensor), 0, step);
+            }
+        }
+        step++;
+    }
+
+    planner.plan();
+    for (auto& p : buffer_ids)
+    {
+        p.first->set_pool_offset(planner.get_offset(p.second));
+    }
+    function->set_temporary_pool_size(planner.max_allocated());
+    NGRAPH_DEBUG << "Temporary pool of " << function->get_name() << ": "
+                 << planner.max_allocated() << " bytes, at least " << planner.lower_bound()
+                 << " bytes live at once";
+}
+
+bool pass::MemoryLayout::run_on_function(shared_ptr<ngraph::Function> function)
+{
+    if (m_offline_planning && !m_disable_memory_sharing)
+    {
+        plan_offline(function);
+        return false;
+    }
+
+    MemoryManager mm(m_alignment, m_disable_memory_sharing);
+    auto ordered_ops = function->get_ordered_ops_view();
+    for (const shared_ptr<Node>& node : *ordered_ops)
+    {
+        auto in_place_outputs = get_in_place_outputs(*node);
+        set<const descriptor::Tensor*> reused_inputs;
+        for (auto& p : in_place_outputs)
+        {
+            reused_inputs.insert(p.second);
+        }
 
         for (descriptor::Tensor* tensor : node->liveness_new_list)
         {
@@ -248,6 +319,127 @@ void pass::MemoryManager::dump(ostream& out)
     }
 }
 
+pass::MemoryPlanner::MemoryPlanner(size_t alignment)
+    : m_alignment(alignment)
+    , m_max_allocated(0)
+{
+}
+
+size_t pass::MemoryPlanner::add_buffer(size_t size, size_t first, size_t last)
+{
+    m_buffers.push_back({MemoryManager::align(size, m_alignment), first, last, 0});
+    return m_buffers.size() - 1;
+}
+
+void pass::MemoryPlanner::extend_buffer(size_t id, size_t size, size_t last)
+{
+    Buffer& buffer = m_buffers.at(id);
+    buffer.size = max(buffer.size, MemoryManager::align(size, m_alignment));
+    buffer.last = last;
+}
+
+void pass::MemoryPlanner::plan()
+{
+    vector<size_t> order(m_buffers.size());
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        order[i] = i;
+    }
+    // Largest first; equal sizes in order of birth, which is optimal when all sizes match
+    stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+        return m_buffers[a].size > m_buffers[b].size ||
+               (m_buffers[a].size == m_buffers[b].size &&
+                m_buffers[a].first < m_buffers[b].first);
+    });
+
+    m_max_allocated = 0;
+    // Placed buffers by the step they are born at. A placed buffer that dies can only conflict
+    // if it was born at most max_lifetime steps before this one, so only that window of steps
+    // is searched; buffers that live to the end conflict with every later-born buffer.
+    const size_t forever = numeric_limits<size_t>::max();
+    multimap<size_t, const Buffer*> placed;
+    multimap<size_t, const Buffer*> placed_forever;
+    size_t max_lifetime = 0;
+    vector<const Buffer*> conflicts;
+    for (size_t id : order)
+    {
+        Buffer& buffer = m_buffers[id];
+
+        // Placed buffers that are live at the same time, by offset
+        conflicts.clear();
+        size_t window = buffer.first > max_lifetime ? buffer.first - max_lifetime : 0;
+        for (auto it = placed.lower_bound(window);
+             it != placed.end() && it->first <= buffer.last;
+             ++it)
+        {
+            if (buffer.first <= it->second->last)
+            {
+                conflicts.push_back(it->second);
+            }
+        }
+        for (auto it = placed_forever.begin();
+             it != placed_forever.end() && it->first <= buffer.last;
+             ++it)
+        {
+            conflicts.push_back(it->second);
+        }
+        sort(conflicts.begin(), conflicts.end(), [](const Buffer* a, const Buffer* b) {
+            return a->offset < b->offset;
+        });
+
+        // Smallest gap that fits, or the end of the highest conflicting buffer
+        size_t offset = 0;
+        size_t best_offset = numeric_limits<size_t>::max();
+        size_t best_gap = numeric_limits<size_t>::max();
+        for (const Buffer* other : conflicts)
+        {
+            if (other->offset > offset)
+            {
+                size_t gap = other->offset - offset;
+                if (gap >= buffer.size && gap < best_gap)
+                {
+                    best_gap = gap;
+                    best_offset = offset;
+                }
+            }
+            offset = max(offset, other->offset + other->size);
+        }
+        buffer.offset = best_offset == numeric_limits<size_t>::max() ? offset : best_offset;
+        m_max_allocated = max(m_max_allocated, buffer.offset + buffer.size);
+        if (buffer.last == forever)
+        {
+            placed_forever.insert({buffer.first, &buffer});
+        }
+        else
+        {
+            placed.insert({buffer.first, &buffer});
+            max_lifetime = max(max_lifetime, buffer.last - buffer.first);
+        }
+    }
+}
+
+size_t pass::MemoryPlanner::lower_bound() const
+{
+    // Net change in live bytes at each step
+    map<size_t, int64_t> deltas;
+    for (const Buffer& buffer : m_buffers)
+    {
+        deltas[buffer.first] += buffer.size;
+        if (buffer.last != numeric_limits<size_t>::max())
+        {
+            deltas[buffer.last + 1] -= buffer.size;
+        }
+    }
+    int64_t live = 0;
+    int64_t peak = 0;
+    for (auto& p : deltas)
+    {
+        live += p.second;
+        peak = max(peak, live);
+    }
+    return peak;
+}
+
 size_t pass::MemoryManager::align(size_t size, size_t alignment)
 {
     if (size == 0)
@@ -19,6 +19,7 @@
 #include <limits>
 #include <list>
 #include <sstream>
+#include <vector>
 
 #include "ngraph/pass/pass.hpp"
 
@@ -29,18 +30,69 @@ namespace ngraph
         class MemoryLayout;
         class MemoryNode;
         class MemoryManager;
+        class MemoryPlanner;
     }
 }
 
+/// \brief Assigns every temporary tensor an offset in the function's temporary pool.
+///
+/// When memory sharing is enabled the lifetimes from pass::Liveness are planned offline by
+/// MemoryPlanner. Otherwise, or when `offline_planning` is false, tensors are placed greedily
+/// in execution order by a first-fit MemoryManager.
 class ngraph::pass::MemoryLayout : public FunctionPass
 {
 public:
-    MemoryLayout(size_t alignment = 1, bool disable_memory_sharing = false);
+    MemoryLayout(size_t alignment = 1,
+                 bool disable_memory_sharing = false,
+                 bool offline_planning = true);
     bool run_on_function(std::shared_ptr<ngraph::Function>) override;
 
 private:
+    void plan_offline(std::shared_ptr<ngraph::Function> function);
+
     size_t m_alignment;
     bool m_disable_memory_sharing;
+    bool m_offline_planning;
+};
+
+/// \brief Places buffers whose lifetimes are all known before any of them is placed.
+///
+/// Buffers are placed largest first, each in the smallest gap between already placed
+/// buffers whose lifetimes overlap its own. Lifetimes are inclusive ranges of steps.
+/// Finding those buffers searches only the steps the longest finite lifetime can reach back
+/// over, so with short lifetimes the cost follows the number of overlapping pairs rather than
+/// the square of the buffer count.
+class ngraph::pass::MemoryPlanner
+{
+public:
+    MemoryPlanner(size_t alignment = 1);
+
+    /// \brief Add a buffer that is live from step `first` through step `last`
+    /// \returns The id used to look up the buffer's offset
+    size_t add_buffer(size_t size, size_t first, size_t last);
+
+    /// \brief Extend the lifetime of a buffer and grow it to at least `size` bytes
+    void extend_buffer(size_t id, size_t size, size_t last);
+
+    void plan();
+
+    size_t get_offset(size_t id) const { return m_buffers.at(id).offset; }
+    size_t max_allocated() const { return m_max_allocated; }
+    /// \brief The largest number of bytes live at any one step. No placement can use less.
+    size_t lower_bound() const;
+
+private:
+    struct Buffer
+    {
+        size_t size;
+        size_t first;
+        size_t last;
+        size_t offset;
+    };
+
+    std::vector<Buffer> m_buffers;
+    size_t m_alignment;
+    size_t m_max_allocated;
 };
 
 class ngraph::pass::MemoryManager
@@ -40,7 +40,8 @@ bool pass::MemoryVisualize::run_on_module(vector<shared_ptr<ngraph::Function>>&
     {
         for (shared_ptr<Function> f : functions)
         {
-            list<shared_ptr<Node>> nodes = f->get_ordered_ops();
+            auto ordered_ops = f->get_ordered_ops_view();
+            const list<shared_ptr<Node>>& nodes = *ordered_ops;
             file << "<!DOCTYPE html>\n<html>\n";
             file << "<head>\n";
             file << "    <style>\n";
@@ -82,6 +83,34 @@ bool pass::MemoryVisualize::run_on_module(vector<shared_ptr<ngraph::Function>>&
             // file << temp_max_size << "</td></tr>\n";
             // file << "</table>\n";
 
+            // The planned pool against the most bytes live at any op, which no plan can beat
+            size_t live_size = 0;
+            size_t max_live_size = 0;
+            for (shared_ptr<Node> node : nodes)
+            {
+                for (descriptor::Tensor* tensor : node->liveness_new_list)
+                {
+                    live_size += tensor->size();
+                }
+                max_live_size = max(max_live_size, live_size);
+                for (descriptor::Tensor* tensor : node->liveness_free_list)
+                {
+                    live_size -= tensor->size();
+                }
+            }
+            size_t pool_size = f->get_temporary_pool_size();
+            file << "<table>\n";
+            file << "<tr><td>Temporary pool size</td><td align=\"right\">";
+            file << pool_size << "</td></tr>\n";
+            file << "<tr><td>Maximum live temporaries</td><td align=\"right\">";
+            file << max_live_size << "</td></tr>\n";
+            file << "<tr><td>Pool overhead</td><td align=\"right\">";
+            file << (max_live_size > 0 && pool_size > max_live_size
+                         ? (pool_size - max_live_size) * 100 / max_live_size
+                         : 0)
+                 << "%</td></tr>\n";
+            file << "</table>\n";
+
             file << "<hr>\n";
             draw_tensor_weight(file, nodes);
             // file << "<hr>\n";
@@ -276,9 +276,11 @@ namespace ngraph
             NGRAPH_DEBUG << "[MATCHER] Starting match pattern = " << m_pattern_node->get_name()
                          << " , graph_node = " << graph_node->get_name();
 
+            m_attempt_count++;
             bool is_match = match_node(m_pattern_node, graph_node, m_pattern_map);
             if (is_match)
             {
+                m_match_count++;
                 m_match_root = graph_node;
             }
             return is_match;
@@ -302,14 +304,37 @@ namespace ngraph
             NGRAPH_DEBUG << "[MATCHER] Starting match pattern = " << m_pattern_node->get_name()
                          << " , graph_node = " << graph_node->get_name();
 
+            m_attempt_count++;
             bool is_match = match_node(m_pattern_node, graph_node, m_pattern_map);
             if (is_match)
             {
+                m_match_count++;
                 m_match_root = graph_node;
             }
             return is_match;
         }
 
+        const std::type_info* Matcher::get_root_type()
+        {
+            // A Label with an argument matches whatever its argument matches.
+            std::shared_ptr<Node> root = m_pattern_node;
+            while (std::dynamic_pointer_cast<op::Label>(root) &&
+                   root->get_arguments().size() == 1)
+            {
+                root = root->get_argument(0);
+            }
+
+            if (!root || std::dynamic_pointer_cast<op::Label>(root) ||
+                std::dynamic_pointer_cast<op::Skip>(root) ||
+                std::dynamic_pointer_cast<op::Any>(root))
+            {
+                return nullptr;
+            }
+
+            auto p_root = root.get();
+            return &typeid(*p_root);
+        }
+
         bool RecurrentMatcher::match(std::shared_ptr<Node> graph)
         {
             bool matched = false;
@@ -19,6 +19,7 @@
 #include <cassert>
 #include <functional>
 #include <memory.h>
+#include <typeinfo>
 
 #include "ngraph/node.hpp"
 #include "ngraph/op/constant.hpp"
@@ -72,6 +73,8 @@ namespace ngraph
                 , m_callback(callback)
                 , m_depth(0)
                 , m_name(name)
+                , m_attempt_count(0)
+                , m_match_count(0)
             {
             }
 
@@ -87,6 +90,17 @@ namespace ngraph
             /// \param previous_matches contains previous mappings from labels to nodes to use
             bool match(const std::shared_ptr<Node>& graph_node, const PatternMap& previous_matches);
 
+            /// \brief Returns the type of the graph nodes the pattern can match at its root, or
+            ///        nullptr if the root is a Skip, an Any or a Label without an argument, which
+            ///        can match nodes of any type. GraphRewrite only tries the matcher on nodes of
+            ///        this type.
+            virtual const std::type_info* get_root_type();
+
+            /// \brief The number of calls to match since the matcher was constructed.
+            size_t get_attempt_count() const { return m_attempt_count; }
+            /// \brief The number of calls to match that found a match.
+            size_t get_match_count() const { return m_match_count; }
+
             template <typename T>
             static std::shared_ptr<T> unique_match(std::shared_ptr<Node> node)
             {
@@ -167,6 +181,8 @@ namespace ngraph
             graph_rewrite_callback m_callback;
             size_t m_depth;
             std::string m_name;
+            size_t m_attempt_count;
+            size_t m_match_count;
         };
 
         class RecurrentMatcher
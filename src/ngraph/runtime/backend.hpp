@@ -112,6 +112,12 @@ public:
     /// \param func The function to collect perfomance data on.
     /// \param enable Set to true to enable or false to disable data collection
     virtual void enable_performance_data(std::shared_ptr<Function> func, bool enable) {}
+    /// \brief Allow the ops of a Function that do not depend on each other to execute
+    ///     concurrently. Backends without inter-op parallelism ignore this.
+    /// \param func The function to configure.
+    /// \param enable Set to true to execute independent ops in parallel or false to execute
+    ///     them one after the other
+    virtual void enable_parallel_execution(std::shared_ptr<Function> func, bool enable) {}
     /// \brief Collect performance information gathered on a Function.
     /// \param func The function to get collected data.
     /// \returns Vector of PerformanceCounter information.
@@ -162,8 +162,10 @@ namespace ngraph
 
                 std::function<decltype(runtime::cpu::kernel::broadcast<float, 2>)> kernel;
 
-                SELECT_KERNEL_BY_RANK(
-                    kernel, args[0].get_element_type(), out_rank, runtime::cpu::kernel::broadcast);
+                SELECT_KERNEL_BY_RANK(kernel,
+                                      storage_element_type(args[0].get_element_type()),
+                                      out_rank,
+                                      runtime::cpu::kernel::broadcast);
 
                 auto functor =
                     [&, kernel, expanded_input_shape, out_shape](CPURuntimeContext* ctx) {
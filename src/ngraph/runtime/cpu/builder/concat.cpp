@@ -86,7 +86,7 @@ namespace ngraph
                     std::function<decltype(runtime::cpu::kernel::concat<float, 1>)> kernel;
 
                     SELECT_KERNEL_BY_RANK(kernel,
-                                          out[0].get_element_type(),
+                                          storage_element_type(out[0].get_element_type()),
                                           out[0].get_shape().size(),
                                           runtime::cpu::kernel::concat);
 
@@ -39,7 +39,49 @@ namespace ngraph
 
                 std::function<decltype(runtime::cpu::kernel::convert<float, int>)> kernel;
 
-                if (out[0].get_element_type() == element::boolean)
+                auto& input_type = args[0].get_element_type();
+                if (out[0].get_element_type() == element::bf16)
+                {
+                    if (input_type == element::bf16)
+                    {
+                        kernel = runtime::cpu::kernel::convert_to_bf16<bfloat16>;
+                    }
+                    else if (input_type == element::f16)
+                    {
+                        kernel = runtime::cpu::kernel::convert_to_bf16<float16>;
+                    }
+                    else
+                    {
+                        SELECT_KERNEL(kernel, input_type, runtime::cpu::kernel::convert_to_bf16);
+                    }
+                }
+                else if (out[0].get_element_type() == element::f16)
+                {
+                    if (input_type == element::bf16)
+                    {
+                        kernel = runtime::cpu::kernel::convert_to_f16<bfloat16>;
+                    }
+                    else if (input_type == element::f16)
+                    {
+                        kernel = runtime::cpu::kernel::convert_to_f16<float16>;
+                    }
+                    else
+                    {
+                        SELECT_KERNEL(kernel, input_type, runtime::cpu::kernel::convert_to_f16);
+                    }
+                }
+                else if (input_type == element::bf16)
+                {
+                    SELECT_KERNEL(kernel,
+                                  out[0].get_element_type(),
+                                  runtime::cpu::kernel::convert_from_bf16);
+                }
+                else if (input_type == element::f16)
+                {
+                    SELECT_KERNEL(
+                        kernel, out[0].get_element_type(), runtime::cpu::kernel::convert_from_f16);
+                }
+                else if (out[0].get_element_type() == element::boolean)
                 {
                     SELECT_KERNEL(
                         kernel, args[0].get_element_type(), runtime::cpu::kernel::convert_to_i8);
@@ -0,0 +1,131 @@
+//*****************************************************************************
+// Copyright 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <typeindex>
+#include <unordered_map>
+
+#include "ngraph/runtime/cpu/kernel/loop_kernel.hpp"
+#include "ngraph/op/abs.hpp"
+#include "ngraph/op/add.hpp"
+#include "ngraph/op/get_output_element.hpp"
+#include "ngraph/op/maximum.hpp"
+#include "ngraph/op/minimum.hpp"
+#include "ngraph/op/negative.hpp"
+#include "ngraph/op/relu.hpp"
+#include "ngraph/op/subtract.hpp"
+#include "ngraph/runtime/cpu/cpu_builder.hpp"
+#include "ngraph/runtime/cpu/op/loop_kernel.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            using Instruction = runtime::cpu::kernel::LoopKernelInstruction;
+
+            // GOEE doesn't see GOEs in subgraphs that are hidden inside LoopKernels
+            static const descriptor::Output* get_source_output(const descriptor::Output* output)
+            {
+                while (auto goe =
+                           dynamic_pointer_cast<ngraph::op::GetOutputElement>(output->get_node()))
+                {
+                    output = &goe->get_inputs().at(goe->get_n()).get_output();
+                }
+                return output;
+            }
+
+            template <>
+            void Builder::BUILDER_DECL(ngraph::runtime::cpu::op::LoopKernel)
+            {
+                static const unordered_map<type_index, Instruction::Opcode> opcodes{
+                    {type_index(typeid(ngraph::op::Abs)), Instruction::Opcode::Abs},
+                    {type_index(typeid(ngraph::op::Add)), Instruction::Opcode::Add},
+                    {type_index(typeid(ngraph::op::Maximum)), Instruction::Opcode::Maximum},
+                    {type_index(typeid(ngraph::op::Minimum)), Instruction::Opcode::Minimum},
+                    {type_index(typeid(ngraph::op::Negative)), Instruction::Opcode::Negative},
+                    {type_index(typeid(ngraph::op::Relu)), Instruction::Opcode::Relu},
+                    {type_index(typeid(ngraph::op::Subtract)), Instruction::Opcode::Subtract}};
+
+                auto& functors = external_function->get_functors();
+                auto loop_kernel = static_cast<const ngraph::runtime::cpu::op::LoopKernel*>(node);
+
+                // Registers 0..args.size() - 1 hold the kernel's inputs and the following
+                // out.size() registers its outputs, so those ops write straight to memory
+                unordered_map<const descriptor::Output*, size_t> registers;
+                vector<reference_wrapper<void*>> tensors;
+                for (size_t i = 0; i < args.size(); i++)
+                {
+                    registers.insert({&loop_kernel->get_inputs().at(i).get_output(), i});
+                    tensors.emplace_back(external_function->get_tensor_data(args[i].get_name()));
+                }
+                const NodeVector& output_nodes = loop_kernel->get_kernel_outputs();
+                for (size_t i = 0; i < out.size(); i++)
+                {
+                    // CPULoopKernelFusion only fuses single-output ops
+                    registers.insert({&output_nodes.at(i)->get_outputs().at(0), tensors.size()});
+                    tensors.emplace_back(external_function->get_tensor_data(out[i].get_name()));
+                }
+
+                // Every other op of the kernel gets a temporary register
+                vector<Instruction> program;
+                size_t register_count = tensors.size();
+                for (const shared_ptr<Node>& op_node : loop_kernel->get_node_list())
+                {
+                    const Node& n = *op_node;
+                    auto opcode = opcodes.find(type_index(typeid(n)));
+                    if (opcode == opcodes.end())
+                    {
+                        throw ngraph_error("Unsupported op '" + n.description() +
+                                           "' in LoopKernel");
+                    }
+
+                    Instruction instruction;
+                    instruction.opcode = opcode->second;
+                    auto result = registers.find(&op_node->get_outputs().at(0));
+                    if (result == registers.end())
+                    {
+                        result =
+                            registers.insert({&op_node->get_outputs().at(0), register_count++})
+                                .first;
+                    }
+                    instruction.result = result->second;
+
+                    const auto& inputs = op_node->get_inputs();
+                    instruction.arg0 = registers.at(get_source_output(&inputs.at(0).get_output()));
+                    instruction.arg1 =
+                        inputs.size() > 1
+                            ? registers.at(get_source_output(&inputs.at(1).get_output()))
+                            : instruction.arg0;
+                    program.push_back(instruction);
+                }
+
+                std::function<decltype(runtime::cpu::kernel::loop_kernel<float>)> kernel;
+                SELECT_KERNEL(kernel, out[0].get_element_type(), runtime::cpu::kernel::loop_kernel);
+
+                auto element_count = out[0].get_size();
+                auto functor = [&, kernel, program, tensors, register_count, element_count](
+                    CPURuntimeContext* ctx) {
+                    kernel(program, tensors, register_count, element_count);
+                };
+                functors.emplace_back(functor);
+            }
+        }
+    }
+}
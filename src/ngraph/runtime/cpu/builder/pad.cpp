@@ -51,7 +51,7 @@ namespace ngraph
                     std::function<decltype(runtime::cpu::kernel::pad<float, 1>)> kernel;
 
                     SELECT_KERNEL_BY_RANK(kernel,
-                                          args[0].get_element_type(),
+                                          storage_element_type(args[0].get_element_type()),
                                           arg_shape.size(),
                                           runtime::cpu::kernel::pad);
 
@@ -73,7 +73,9 @@ namespace ngraph
 
                     std::function<decltype(runtime::cpu::kernel::pad<float>)> kernel;
 
-                    SELECT_KERNEL(kernel, args[0].get_element_type(), runtime::cpu::kernel::pad);
+                    SELECT_KERNEL(kernel,
+                                  storage_element_type(args[0].get_element_type()),
+                                  runtime::cpu::kernel::pad);
 
                     auto functor = [&,
                                     kernel,
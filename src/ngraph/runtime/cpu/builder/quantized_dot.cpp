@@ -0,0 +1,96 @@
+//*****************************************************************************
+// Copyright 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include "ngraph/runtime/cpu/op/quantized_dot.hpp"
+#include "ngraph/runtime/cpu/cpu_builder.hpp"
+#include "ngraph/runtime/cpu/cpu_kernels.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            template <>
+            void Builder::BUILDER_DECL(ngraph::op::QuantizedDot)
+            {
+                auto qdot = static_cast<const ngraph::op::QuantizedDot*>(node);
+                auto& functors = external_function->get_functors();
+                auto& arg0_tensor = external_function->get_tensor_data(args[0].get_name());
+                auto& arg1_tensor = external_function->get_tensor_data(args[1].get_name());
+                void** bias_tensor = qdot->has_bias()
+                                         ? &external_function->get_tensor_data(args[8].get_name())
+                                         : nullptr;
+                auto& out_tensor = external_function->get_tensor_data(out[0].get_name());
+                auto& out1_tensor = external_function->get_tensor_data(out[1].get_name());
+                auto& out2_tensor = external_function->get_tensor_data(out[2].get_name());
+
+                size_t rows = args[0].get_shape()[0];
+                size_t inner = args[0].get_shape()[1];
+                size_t columns = out[0].get_shape()[1];
+                float dequantize_scale = qdot->get_dequantize_scale();
+                float requantize_scale = qdot->get_requantize_scale();
+                float min_freezed_output = qdot->get_freezed_output_min();
+                float max_freezed_output = qdot->get_freezed_output_max();
+                bool with_relu = qdot->with_relu();
+
+                auto functor = [&,
+                                bias_tensor,
+                                rows,
+                                inner,
+                                columns,
+                                dequantize_scale,
+                                requantize_scale,
+                                min_freezed_output,
+                                max_freezed_output,
+                                with_relu](CPURuntimeContext* ctx) {
+                    const float* bias = bias_tensor ? static_cast<float*>(*bias_tensor) : nullptr;
+                    if (with_relu)
+                    {
+                        cpu::kernel::quantized_dot(static_cast<uint8_t*>(arg0_tensor),
+                                                   static_cast<int8_t*>(arg1_tensor),
+                                                   bias,
+                                                   static_cast<uint8_t*>(out_tensor),
+                                                   rows,
+                                                   inner,
+                                                   columns,
+                                                   dequantize_scale,
+                                                   requantize_scale);
+                    }
+                    else
+                    {
+                        cpu::kernel::quantized_dot(static_cast<uint8_t*>(arg0_tensor),
+                                                   static_cast<int8_t*>(arg1_tensor),
+                                                   bias,
+                                                   static_cast<int8_t*>(out_tensor),
+                                                   rows,
+                                                   inner,
+                                                   columns,
+                                                   dequantize_scale,
+                                                   requantize_scale);
+                    }
+                    *(static_cast<float*>(out1_tensor)) = min_freezed_output;
+                    *(static_cast<float*>(out2_tensor)) = max_freezed_output;
+                };
+                functors.emplace_back(functor);
+            }
+            REGISTER_OP_BUILDER(QuantizedDot);
+        }
+    }
+}
@@ -74,7 +74,7 @@ namespace ngraph
                         kernel;
 
                     SELECT_KERNEL_BY_RANK(kernel,
-                                          args[0].get_element_type(),
+                                          storage_element_type(args[0].get_element_type()),
                                           arg0_shape.size(),
                                           runtime::cpu::kernel::strided_replace_slice);
 
@@ -97,7 +97,7 @@ namespace ngraph
                     std::function<decltype(runtime::cpu::kernel::replace_slice<float, 2>)> kernel;
 
                     SELECT_KERNEL_BY_RANK(kernel,
-                                          args[0].get_element_type(),
+                                          storage_element_type(args[0].get_element_type()),
                                           arg0_shape.size(),
                                           runtime::cpu::kernel::replace_slice);
 
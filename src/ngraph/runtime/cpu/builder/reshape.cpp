@@ -72,7 +72,7 @@ namespace ngraph
 
                 auto result_shape = out[0].get_shape();
                 auto result_rank = result_shape.size();
-                auto& result_element_type = out[0].get_element_type();
+                auto& result_element_type = storage_element_type(out[0].get_element_type());
 
                 auto input_order = reshape->get_input_order();
 
@@ -43,7 +43,9 @@ namespace ngraph
 
                 std::function<decltype(runtime::cpu::kernel::reverse<float>)> kernel;
 
-                SELECT_KERNEL(kernel, out[0].get_element_type(), runtime::cpu::kernel::reverse);
+                SELECT_KERNEL(kernel,
+                              storage_element_type(out[0].get_element_type()),
+                              runtime::cpu::kernel::reverse);
 
                 auto functor =
                     [&, kernel, arg_shape, result_shape, reversed_axes](CPURuntimeContext* ctx) {
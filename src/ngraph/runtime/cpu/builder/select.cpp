@@ -42,7 +42,9 @@ namespace ngraph
 
                 std::function<decltype(runtime::cpu::kernel::select<float>)> kernel;
 
-                SELECT_KERNEL(kernel, out[0].get_element_type(), runtime::cpu::kernel::select);
+                SELECT_KERNEL(kernel,
+                              storage_element_type(out[0].get_element_type()),
+                              runtime::cpu::kernel::select);
 
                 auto functor = [&, kernel, element_count](CPURuntimeContext* ctx) {
                     kernel(arg0_tensor, arg1_tensor, arg2_tensor, out_tensor, element_count);
@@ -21,6 +21,8 @@
 #include "ngraph/runtime/cpu/cpu_backend.hpp"
 #include "ngraph/runtime/cpu/cpu_call_frame.hpp"
 #include "ngraph/runtime/cpu/cpu_external_function.hpp"
+#include "ngraph/runtime/cpu/cpu_op_profiler.hpp"
+#include "ngraph/runtime/cpu/cpu_perf_events.hpp"
 #include "ngraph/runtime/cpu/cpu_tensor_view.hpp"
 #include "ngraph/util.hpp"
 
@@ -72,18 +74,53 @@ shared_ptr<runtime::TensorView> runtime::cpu::CPU_Backend::create_tensor(
     return make_shared<runtime::cpu::CPUTensorView>(element_type, shape, memory_pointer);
 }
 
-bool runtime::cpu::CPU_Backend::compile(shared_ptr<Function> func)
+shared_ptr<runtime::cpu::CPU_Backend::FunctionInstance>
+    runtime::cpu::CPU_Backend::get_function_instance(shared_ptr<Function> func)
+{
+    lock_guard<mutex> lock(m_function_map_mutex);
+    shared_ptr<FunctionInstance>& instance = m_function_map[func];
+    if (instance == nullptr)
+    {
+        instance = make_shared<FunctionInstance>();
+    }
+    return instance;
+}
+
+void runtime::cpu::CPU_Backend::compile_function_instance(shared_ptr<Function> func,
+                                                          FunctionInstance& instance)
 {
-    FunctionInstance& instance = m_function_map[func];
-    if (instance.m_external_function == nullptr)
+    bool performance_counters_enabled;
     {
-        instance.m_external_function = make_shared<CPU_ExternalFunction>(func);
+        lock_guard<mutex> lock(m_function_map_mutex);
+        instance.m_compile_started = true;
+        performance_counters_enabled = instance.m_performance_counters_enabled;
+    }
+
+    auto external_function = make_shared<CPU_ExternalFunction>(func);
 #if !defined(NGRAPH_DEX_ONLY)
-        instance.m_external_function->m_emit_timing = instance.m_performance_counters_enabled;
+    external_function->m_emit_timing = performance_counters_enabled;
 #endif
-        auto cf = instance.m_external_function->make_call_frame();
-        instance.m_call_frame = dynamic_pointer_cast<CPU_CallFrame>(cf);
+    // DEX functions time every call when performance data or hardware counters are
+    // requested, and one call in NGRAPH_CPU_PROFILE_INTERVAL calls otherwise
+    size_t profiling_interval = OpProfiler::get_default_interval();
+    if ((performance_counters_enabled || PerfEventGroup::is_enabled()) && profiling_interval == 0)
+    {
+        profiling_interval = 1;
     }
+    external_function->set_profiling_interval(profiling_interval);
+    auto call_frame = dynamic_pointer_cast<CPU_CallFrame>(external_function->make_call_frame());
+
+    lock_guard<mutex> lock(m_function_map_mutex);
+    // Parallel execution may have been toggled while the function compiled
+    external_function->set_parallel_execution(instance.m_parallel_execution_enabled);
+    instance.m_external_function = external_function;
+    instance.m_call_frame = call_frame;
+}
+
+bool runtime::cpu::CPU_Backend::compile(shared_ptr<Function> func)
+{
+    shared_ptr<FunctionInstance> instance = get_function_instance(func);
+    call_once(instance->m_compiled, [&]() { compile_function_instance(func, *instance); });
     return true;
 }
 
@@ -93,66 +130,96 @@ bool runtime::cpu::CPU_Backend::call(shared_ptr<Function> func,
 {
     bool rc = true;
 
-    FunctionInstance& instance = m_function_map[func];
-    if (instance.m_external_function == nullptr)
+    shared_ptr<CPU_CallFrame> call_frame;
+    {
+        lock_guard<mutex> lock(m_function_map_mutex);
+        auto it = m_function_map.find(func);
+        if (it != m_function_map.end())
+        {
+            call_frame = it->second->m_call_frame;
+        }
+    }
+    if (call_frame == nullptr)
     {
-        rc = compile(func);
+        shared_ptr<FunctionInstance> instance = get_function_instance(func);
+        call_once(instance->m_compiled, [&]() { compile_function_instance(func, *instance); });
+        lock_guard<mutex> lock(m_function_map_mutex);
+        call_frame = instance->m_call_frame;
     }
 
-    instance.m_call_frame->call(outputs, inputs);
+    call_frame->call(outputs, inputs);
 
     return rc;
 }
 
 void runtime::cpu::CPU_Backend::remove_compiled_function(shared_ptr<Function> func)
 {
+    lock_guard<mutex> lock(m_function_map_mutex);
     m_function_map.erase(func);
 }
 
-#if !defined(NGRAPH_DEX_ONLY)
+void runtime::cpu::CPU_Backend::enable_parallel_execution(shared_ptr<Function> func, bool enable)
+{
+    shared_ptr<FunctionInstance> instance = get_function_instance(func);
+    lock_guard<mutex> lock(m_function_map_mutex);
+    instance->m_parallel_execution_enabled = enable;
+    if (instance->m_external_function != nullptr)
+    {
+        instance->m_external_function->set_parallel_execution(enable);
+    }
+}
 
 void runtime::cpu::CPU_Backend::enable_performance_data(shared_ptr<Function> func, bool enable)
 {
-    FunctionInstance& instance = m_function_map[func];
-    if (instance.m_external_function != nullptr)
+    shared_ptr<FunctionInstance> instance = get_function_instance(func);
+    lock_guard<mutex> lock(m_function_map_mutex);
+    if (instance->m_compile_started)
     {
         throw runtime_error("Performance data collection must be enabled prior to compiling.");
     }
-    instance.m_performance_counters_enabled = enable;
+    instance->m_performance_counters_enabled = enable;
 }
 
 vector<runtime::PerformanceCounter>
     runtime::cpu::CPU_Backend::get_performance_data(shared_ptr<Function> func) const
 {
     vector<runtime::PerformanceCounter> rc;
-    auto it = m_function_map.find(func);
-    if (it != m_function_map.end())
+    shared_ptr<CPU_ExternalFunction> external_function;
+    {
+        lock_guard<mutex> lock(m_function_map_mutex);
+        auto it = m_function_map.find(func);
+        if (it != m_function_map.end())
+        {
+            external_function = it->second->m_external_function;
+        }
+    }
+    if (external_function != nullptr)
     {
-        const FunctionInstance& instance = it->second;
-        if (instance.m_external_function != nullptr)
+        if (auto profiler = external_function->get_op_profiler())
+        {
+            return profiler->get_performance_data();
+        }
+#if !defined(NGRAPH_DEX_ONLY)
+        auto* engine = external_function->m_execution_engine.get();
+        if (engine)
         {
-            auto* engine = instance.m_external_function->m_execution_engine.get();
-            if (engine)
+            auto get_count = engine->find_function<size_t()>("get_debug_timer_count");
+            auto get_name = engine->find_function<const char*(size_t)>("get_debug_timer_name");
+            auto get_microseconds =
+                engine->find_function<size_t(size_t)>("get_debug_timer_microseconds");
+            auto get_call_count =
+                engine->find_function<size_t(size_t)>("get_debug_timer_call_count");
+
+            if (get_count && get_name && get_microseconds && get_call_count)
             {
-                auto get_count = engine->find_function<size_t()>("get_debug_timer_count");
-                auto get_name = engine->find_function<const char*(size_t)>("get_debug_timer_name");
-                auto get_microseconds =
-                    engine->find_function<size_t(size_t)>("get_debug_timer_microseconds");
-                auto get_call_count =
-                    engine->find_function<size_t(size_t)>("get_debug_timer_call_count");
-
-                if (get_count && get_name && get_microseconds && get_call_count)
+                size_t count = get_count();
+                for (size_t i = 0; i < count; i++)
                 {
-                    size_t count = get_count();
-                    for (size_t i = 0; i < count; i++)
-                    {
-                        rc.push_back({get_name(i), get_microseconds(i), get_call_count(i)});
-                    }
+                    rc.push_back({get_name(i), get_microseconds(i), get_call_count(i)});
                 }
             }
         }
+#endif
     }
     return rc;
 }
-
-#endif
@@ -18,6 +18,7 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 
 #include "ngraph/runtime/backend.hpp"
 
@@ -53,11 +54,17 @@ namespace ngraph
 
                 void remove_compiled_function(std::shared_ptr<Function> func) override;
 
-#if !defined(NGRAPH_DEX_ONLY)
+                void enable_parallel_execution(std::shared_ptr<Function> func,
+                                               bool enable) override;
+
+                /// \brief Codegen functions time every op on every call. DEX functions time
+                ///        every call; set NGRAPH_CPU_PROFILE_INTERVAL=N instead to time one call
+                ///        in N, with or without enabling performance data. DEX counters also
+                ///        hold p50, p99 and maximum op times, and hardware event counts when
+                ///        NGRAPH_CPU_PERF_EVENTS is set.
                 void enable_performance_data(std::shared_ptr<Function> func, bool enable) override;
                 std::vector<PerformanceCounter>
                     get_performance_data(std::shared_ptr<Function> func) const override;
-#endif
 
             private:
                 class FunctionInstance
@@ -66,9 +73,22 @@ namespace ngraph
                     std::shared_ptr<CPU_ExternalFunction> m_external_function;
                     std::shared_ptr<CPU_CallFrame> m_call_frame;
                     bool m_performance_counters_enabled = false;
+                    bool m_parallel_execution_enabled = false;
+                    bool m_compile_started = false;
+                    // Callers compiling the same function wait for the first one
+                    std::once_flag m_compiled;
                 };
 
-                std::map<std::shared_ptr<Function>, FunctionInstance> m_function_map;
+                std::shared_ptr<FunctionInstance>
+                    get_function_instance(std::shared_ptr<Function> func);
+                void compile_function_instance(std::shared_ptr<Function> func,
+                                               FunctionInstance& instance);
+
+                // Guards m_function_map and the fields of its instances. It is only held to
+                // look up or update an instance, never while a function compiles.
+                mutable std::mutex m_function_map_mutex;
+                std::map<std::shared_ptr<Function>, std::shared_ptr<FunctionInstance>>
+                    m_function_map;
             };
         }
     }
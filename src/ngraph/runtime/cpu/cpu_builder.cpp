@@ -98,6 +98,7 @@
 #include "ngraph/runtime/cpu/kernel/tan.hpp"
 #include "ngraph/runtime/cpu/kernel/tanh.hpp"
 #include "ngraph/runtime/cpu/op/convert_layout.hpp"
+#include "ngraph/runtime/cpu/op/loop_kernel.hpp"
 #include "ngraph/type/element_type.hpp"
 #include "ngraph/util.hpp"
 
@@ -283,6 +284,21 @@ namespace ngraph
             template <>
             void Builder::BUILDER_DECL(ngraph::op::Result)
             {
+                // Results only copy their input, so 16-bit floats are copied as uint16_t
+                auto& element_type = args[0].get_element_type();
+                if (element_type == element::bf16 || element_type == element::f16)
+                {
+                    auto& functors = external_function->get_functors();
+                    auto element_count = out[0].get_size();
+                    auto& arg0_tensor = external_function->get_tensor_data(args[0].get_name());
+                    auto& out0_tensor = external_function->get_tensor_data(out[0].get_name());
+                    auto functor = [&, element_count](CPURuntimeContext* ctx) {
+                        runtime::cpu::kernel::result<uint16_t>(
+                            arg0_tensor, out0_tensor, element_count);
+                    };
+                    functors.emplace_back(functor);
+                    return;
+                }
                 BUILD_UNARY_ELEMWISE_FUNCTOR(runtime::cpu::kernel::result);
             }
 
@@ -340,7 +356,7 @@ namespace ngraph
                 auto& functors = external_function->get_functors();
 
                 vector<void**> dest;
-                for (auto& result : external_function->get_function()->get_results())
+                for (auto& result : external_function->get_dex_results())
                 {
                     if (result.get() == node)
                     {
@@ -367,7 +383,9 @@ namespace ngraph
                 static BuildOpMap build_dispatcher{
                     {TI(ngraph::op::Parameter), &runtime::cpu::Builder::nop},
                     {TI(ngraph::runtime::cpu::op::ConvertLayout),
-                     &runtime::cpu::Builder::build<ngraph::runtime::cpu::op::ConvertLayout>}};
+                     &runtime::cpu::Builder::build<ngraph::runtime::cpu::op::ConvertLayout>},
+                    {TI(ngraph::runtime::cpu::op::LoopKernel),
+                     &runtime::cpu::Builder::build<ngraph::runtime::cpu::op::LoopKernel>}};
 
                 return build_dispatcher;
             }
@@ -243,6 +243,12 @@ namespace ngraph
 
             using BuildOpMap = std::unordered_map<std::type_index, BuildOpFunction>;
 
+            // Kernels that only copy elements move 16-bit floats as uint16_t
+            inline const element::Type& storage_element_type(const element::Type& type)
+            {
+                return type == element::bf16 || type == element::f16 ? element::u16 : type;
+            }
+
             BuildOpMap& GetGlobalBuildDispatcher();
 
             class Builder
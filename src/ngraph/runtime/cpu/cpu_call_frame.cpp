@@ -15,27 +15,99 @@
 //*****************************************************************************
 
 #include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <thread>
 
 #include "ngraph/runtime/aligned_buffer.hpp"
 #include "ngraph/runtime/cpu/cpu_call_frame.hpp"
 #include "ngraph/runtime/cpu/cpu_external_function.hpp"
 #include "ngraph/runtime/cpu/cpu_tensor_view.hpp"
 #include "ngraph/runtime/cpu/cpu_tracing.hpp"
+#include "ngraph/runtime/memory_arena.hpp"
 
 using namespace std;
 using namespace ngraph;
 
+// Number of runtime contexts that may run a function concurrently
+static size_t get_max_contexts()
+{
+    const char* env_concurrency = std::getenv("NGRAPH_CPU_CONCURRENCY");
+    if (env_concurrency == nullptr)
+    {
+        return max(std::thread::hardware_concurrency(), 1u);
+    }
+    char* end = nullptr;
+    errno = 0;
+    unsigned long concurrency = std::strtoul(env_concurrency, &end, 10);
+    if (!isdigit(static_cast<unsigned char>(env_concurrency[0])) || *end != '\0' ||
+        errno == ERANGE || concurrency == 0)
+    {
+        throw ngraph_error("NGRAPH_CPU_CONCURRENCY must be a positive integer, got '" +
+                           string(env_concurrency) + "'");
+    }
+    return concurrency;
+}
+
 runtime::cpu::CPU_CallFrame::CPU_CallFrame(std::shared_ptr<CPU_ExternalFunction> external_function,
                                            EntryPoint compiled_function)
     : m_external_function(external_function)
     , m_compiled_function(compiled_function)
 {
-    setup_runtime_context();
+    m_max_contexts = get_max_contexts();
+
+    // Always have one context ready so single-threaded callers never pay setup cost
+    m_all_contexts.push_back(setup_runtime_context());
+    m_idle_contexts.push_back(m_all_contexts.back());
+    m_context_count = 1;
 }
 
 runtime::cpu::CPU_CallFrame::~CPU_CallFrame()
 {
-    cleanup_runtime_context();
+    for (auto ctx : m_all_contexts)
+    {
+        cleanup_runtime_context(ctx);
+    }
+}
+
+runtime::cpu::CPURuntimeContext* runtime::cpu::CPU_CallFrame::acquire_runtime_context()
+{
+    std::unique_lock<std::mutex> lock(m_ctx_mutex);
+    if (m_idle_contexts.empty() && m_context_count < m_max_contexts)
+    {
+        // Setting up a context allocates its buffers and primitives; other calls keep
+        // taking and returning contexts meanwhile
+        m_context_count++;
+        lock.unlock();
+        CPURuntimeContext* ctx = nullptr;
+        try
+        {
+            ctx = setup_runtime_context();
+        }
+        catch (...)
+        {
+            lock.lock();
+            m_context_count--;
+            throw;
+        }
+        lock.lock();
+        m_all_contexts.push_back(ctx);
+        return ctx;
+    }
+    m_ctx_available.wait(lock, [this] { return !m_idle_contexts.empty(); });
+    auto ctx = m_idle_contexts.back();
+    m_idle_contexts.pop_back();
+    return ctx;
+}
+
+void runtime::cpu::CPU_CallFrame::release_runtime_context(CPURuntimeContext* ctx)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_ctx_mutex);
+        m_idle_contexts.push_back(ctx);
+    }
+    m_ctx_available.notify_one();
 }
 
 void runtime::cpu::CPU_CallFrame::call(
@@ -47,6 +119,12 @@ void runtime::cpu::CPU_CallFrame::call(
 
     propagate_layouts(output_tvs, m_external_function->get_result_layout_descriptors());
 
+    auto ctx = acquire_runtime_context();
+    if (m_external_function->borrows_scratch_memory())
+    {
+        lend_scratch_memory(ctx);
+    }
+
     for (size_t i = 0; i < input_tvs.size(); i++)
     {
         shared_ptr<runtime::cpu::CPUTensorView> tv =
@@ -61,21 +139,80 @@ void runtime::cpu::CPU_CallFrame::call(
         outputs.push_back(tv->get_data_ptr());
     }
 
-    // Invoke compiled computation
-    if (!m_external_function->is_direct_execution())
+    try
+    {
+        // Generated code shares its MKLDNN primitives, and so their data handles, between
+        // runtime contexts; those functions still have to be run one at a time
+        std::unique_lock<std::mutex> exec_lock(m_external_function->get_execution_mutex(),
+                                               std::defer_lock);
+        if (!m_external_function->is_reentrant())
+        {
+            exec_lock.lock();
+        }
+
+        // Invoke compiled computation
+        if (!m_external_function->is_direct_execution())
+        {
+            m_compiled_function(inputs.data(), outputs.data(), ctx);
+        }
+        else
+        {
+            m_external_function->get_executor()(ctx, inputs, outputs);
+        }
+
+        if (runtime::cpu::IsTracingEnabled())
+        {
+            GenerateTimeline(m_external_function->get_op_attrs(),
+                             ctx->op_durations,
+                             m_external_function->get_function_name() + ".timeline.json",
+                             ctx->op_events);
+        }
+    }
+    catch (...)
     {
-        m_compiled_function(inputs.data(), outputs.data(), ctx);
+        if (m_external_function->borrows_scratch_memory())
+        {
+            return_scratch_memory(ctx);
+        }
+        release_runtime_context(ctx);
+        throw;
     }
-    else
+    if (m_external_function->borrows_scratch_memory())
     {
-        m_external_function->get_executor()(ctx, inputs, outputs);
+        return_scratch_memory(ctx);
     }
+    release_runtime_context(ctx);
+}
 
-    if (runtime::cpu::IsTracingEnabled())
+void runtime::cpu::CPU_CallFrame::lend_scratch_memory(CPURuntimeContext* ctx)
+{
+    auto& arena = runtime::MemoryArena::get_process_arena();
+    const auto& buffer_sizes = m_external_function->get_memory_buffer_sizes();
+    for (size_t i = 0; i < buffer_sizes.size(); i++)
+    {
+        bool intact;
+        ctx->memory_buffers[i] =
+            arena.acquire(buffer_sizes[i],
+                          runtime::cpu::CPU_ExternalFunction::s_memory_pool_alignment,
+                          ctx->scratch_tickets[i],
+                          intact);
+        ctx->scratch_tickets[i] = 0;
+        // Values kept from an earlier call, such as constant-derived results, survive only
+        // if this context gets its own buffers back untouched
+        if (!intact)
+        {
+            ctx->first_iteration = true;
+        }
+    }
+}
+
+void runtime::cpu::CPU_CallFrame::return_scratch_memory(CPURuntimeContext* ctx)
+{
+    auto& arena = runtime::MemoryArena::get_process_arena();
+    for (size_t i = 0; i < ctx->memory_buffers.size(); i++)
     {
-        GenerateTimeline(m_external_function->get_op_attrs(),
-                         ctx->op_durations,
-                         m_external_function->get_function_name() + ".timeline.json");
+        ctx->scratch_tickets[i] = arena.release(ctx->memory_buffers[i]);
+        ctx->memory_buffers[i] = nullptr;
     }
 }
 
@@ -99,31 +236,58 @@ void runtime::cpu::CPU_CallFrame::propagate_layouts(
     }
 }
 
-void runtime::cpu::CPU_CallFrame::setup_runtime_context()
+runtime::cpu::CPURuntimeContext* runtime::cpu::CPU_CallFrame::setup_runtime_context()
 {
-    ctx = new CPURuntimeContext;
+    auto ctx = new CPURuntimeContext;
 
     ctx->op_durations = nullptr;
     if (runtime::cpu::IsTracingEnabled())
     {
         ctx->op_durations = new int64_t[m_external_function->get_op_attrs().size()];
     }
+    // Only DEX functions read hardware counters
+    ctx->op_events = nullptr;
+    if (runtime::cpu::IsTracingEnabled() && runtime::cpu::PerfEventGroup::is_enabled() &&
+        m_external_function->is_direct_execution())
+    {
+        ctx->op_events = new PerfEventCounts[m_external_function->get_op_attrs().size()];
+    }
     ctx->p_en = new bool[m_external_function->get_parameter_layout_descriptors().size()];
 
+    const auto& t_en_sizes = m_external_function->get_tensor_enable_sizes();
+    ctx->t_en = new bool*[t_en_sizes.size()];
+    for (size_t i = 0; i < t_en_sizes.size(); i++)
+    {
+        ctx->t_en[i] = new bool[t_en_sizes[i]]();
+    }
+
     ctx->first_iteration = true;
 
     // Create temporary buffer pools
     size_t alignment = runtime::cpu::CPU_ExternalFunction::s_memory_pool_alignment;
     for (auto buffer_size : m_external_function->get_memory_buffer_sizes())
     {
-        auto buffer = new AlignedBuffer(buffer_size, alignment);
+        // Borrowed pools are only attached for the duration of a call
+        auto buffer = m_external_function->borrows_scratch_memory()
+                          ? nullptr
+                          : new AlignedBuffer(buffer_size, alignment);
         ctx->memory_buffers.push_back(buffer);
+        ctx->scratch_tickets.push_back(0);
+    }
+    // DEX contexts run their own functors with their own tensor pointers and MKLDNN primitives
+    ctx->dex_program = nullptr;
+    MKLDNNEmitter* mkldnn_emitter = m_external_function->get_mkldnn_emitter().get();
+    if (m_external_function->is_direct_execution())
+    {
+        ctx->dex_program = m_external_function->make_dex_program().release();
+        mkldnn_emitter = ctx->dex_program->mkldnn_emitter.get();
     }
-    const auto& mkldnn_emitter = m_external_function->get_mkldnn_emitter();
     ctx->mkldnn_primitives = mkldnn_emitter->get_mkldnn_primitives().data();
     ctx->mkldnn_workspaces = mkldnn_emitter->get_mkldnn_workspaces().data();
 
-    if (std::getenv("NGRAPH_CPU_USE_TBB") != nullptr)
+    // Only generated code builds TBB flow graphs; DEX schedules ops on the kernel thread pool
+    if (!m_external_function->is_direct_execution() &&
+        std::getenv("NGRAPH_CPU_USE_TBB") != nullptr)
     {
         ctx->G = new tbb::flow::graph;
         const auto envParallelism = std::getenv("NGRAPH_INTER_OP_PARALLELISM");
@@ -131,17 +295,26 @@ void runtime::cpu::CPU_CallFrame::setup_runtime_context()
         ctx->c = new tbb::global_control(tbb::global_control::max_allowed_parallelism, parallelism);
         ctx->init = new tbb::task_scheduler_init(parallelism);
     }
+    return ctx;
 }
 
-void runtime::cpu::CPU_CallFrame::cleanup_runtime_context()
+void runtime::cpu::CPU_CallFrame::cleanup_runtime_context(CPURuntimeContext* ctx)
 {
     delete[] ctx->op_durations;
+    delete[] ctx->op_events;
     delete[] ctx->p_en;
+    for (size_t i = 0; i < m_external_function->get_tensor_enable_sizes().size(); i++)
+    {
+        delete[] ctx->t_en[i];
+    }
+    delete[] ctx->t_en;
     for (auto buffer : ctx->memory_buffers)
     {
         delete buffer;
     }
-    if (std::getenv("NGRAPH_CPU_USE_TBB") != nullptr)
+    delete ctx->dex_program;
+    if (!m_external_function->is_direct_execution() &&
+        std::getenv("NGRAPH_CPU_USE_TBB") != nullptr)
     {
         // delete graph G and nodes in G
         ctx->G->wait_for_all();
@@ -16,8 +16,10 @@
 
 #pragma once
 
+#include <condition_variable>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "ngraph/function.hpp"
@@ -49,19 +51,37 @@ namespace ngraph
                 /// \brief Invoke the function with values matching the signature of the function.
                 ///
                 /// Tuples will be expanded into their tensor views to build the call frame.
+                /// Safe to invoke from several threads at once; each invocation runs on its
+                /// own runtime context taken from the call frame's pool.
                 void call(const std::vector<std::shared_ptr<runtime::TensorView>>& outputs,
                           const std::vector<std::shared_ptr<runtime::TensorView>>& inputs);
 
                 void propagate_layouts(const std::vector<std::shared_ptr<runtime::TensorView>>& tvs,
                                        const LayoutDescriptorPtrs& layouts) const;
 
-                void setup_runtime_context();
-                void cleanup_runtime_context();
+                CPURuntimeContext* setup_runtime_context();
+                void cleanup_runtime_context(CPURuntimeContext* ctx);
 
             protected:
+                // Take an idle runtime context from the pool, creating a new one if the
+                // pool has not yet reached m_max_contexts, or block until one is returned
+                CPURuntimeContext* acquire_runtime_context();
+                void release_runtime_context(CPURuntimeContext* ctx);
+                // Attach scratch pools from the process-wide arena for one call, and give
+                // them back afterwards
+                void lend_scratch_memory(CPURuntimeContext* ctx);
+                void return_scratch_memory(CPURuntimeContext* ctx);
+
                 std::shared_ptr<CPU_ExternalFunction> m_external_function;
                 EntryPoint m_compiled_function;
-                CPURuntimeContext* ctx;
+
+                std::mutex m_ctx_mutex;
+                std::condition_variable m_ctx_available;
+                std::vector<CPURuntimeContext*> m_all_contexts;
+                std::vector<CPURuntimeContext*> m_idle_contexts;
+                // Contexts in m_all_contexts plus those being set up outside m_ctx_mutex
+                size_t m_context_count;
+                size_t m_max_contexts;
             };
         }
     }
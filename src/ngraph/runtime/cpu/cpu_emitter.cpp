@@ -17,6 +17,8 @@
 #include "ngraph/runtime/cpu/cpu_emitter.hpp"
 #include <algorithm>
 #include <cmath>
+#include <iomanip>
+#include <limits>
 #include <numeric>
 #include <string>
 #include <typeindex>
@@ -109,6 +111,7 @@
 #include "ngraph/runtime/cpu/op/matmul_bias.hpp"
 #include "ngraph/runtime/cpu/op/max_pool_with_indices.hpp"
 #include "ngraph/runtime/cpu/op/quantized_avg_pool.hpp"
+#include "ngraph/runtime/cpu/op/quantized_dot.hpp"
 #include "ngraph/runtime/cpu/op/quantized_max_pool.hpp"
 #include "ngraph/runtime/cpu/op/rnn.hpp"
 #include "ngraph/runtime/cpu/op/sigmoid.hpp"
@@ -378,6 +381,16 @@ namespace ngraph
                 return writer.str();
             }
 
+            // A float literal that reads back as exactly the same value
+            static std::string emit_float(float value)
+            {
+                std::stringstream ss;
+                ss << std::scientific
+                   << std::setprecision(std::numeric_limits<float>::max_digits10 - 1) << value
+                   << "f";
+                return ss.str();
+            }
+
             template <>
             void CPU_Emitter::EMITTER_DECL(ngraph::op::MatmulBias)
             {
@@ -1522,6 +1535,36 @@ namespace ngraph
             void CPU_Emitter::EMITTER_DECL(ngraph::op::Convert)
             {
                 auto& result_element_type = out[0].get_element_type();
+                auto& input_element_type = args[0].get_element_type();
+
+                // Conversions between float and 16-bit floats have vectorized kernels
+                string kernel;
+                if (input_element_type == element::f32 && result_element_type == element::bf16)
+                {
+                    kernel = "convert_f32_to_bf16";
+                }
+                else if (input_element_type == element::bf16 &&
+                         result_element_type == element::f32)
+                {
+                    kernel = "convert_bf16_to_f32";
+                }
+                else if (input_element_type == element::f32 &&
+                         result_element_type == element::f16)
+                {
+                    kernel = "convert_f32_to_f16";
+                }
+                else if (input_element_type == element::f16 &&
+                         result_element_type == element::f32)
+                {
+                    kernel = "convert_f16_to_f32";
+                }
+                if (!kernel.empty())
+                {
+                    writer << "cpu::kernel::" << kernel << "(" << args[0].get_name() << ", "
+                           << out[0].get_name() << ", " << out[0].get_size() << ");
+";
+                    return;
+                }
 
                 writer.block_begin();
 #if USE_EIGEN_CORE_INLINE == 1
@@ -2676,9 +2719,11 @@ namespace ngraph
                     writer << "cpu::mkldnn_utils::set_memory_ptr(ctx, " << to_string(deps[2])
                            << ", " << out[0].get_name() << ");\n";
                     writer << "*(" << out[1].get_name()
-                           << ") = " << qconvolution->get_freezed_output_min() << ";\n";
+                           << ") = " << emit_float(qconvolution->get_freezed_output_min())
+                           << ";\n";
                     writer << "*(" << out[2].get_name()
-                           << ") = " << qconvolution->get_freezed_output_max() << ";\n";
+                           << ") = " << emit_float(qconvolution->get_freezed_output_max())
+                           << ";\n";
                     writer << "cpu::mkldnn_utils::mkldnn_invoke_primitive(ctx, "
                            << to_string(conv_index) << ");\n";
                 }
@@ -2688,6 +2733,28 @@ namespace ngraph
                 }
             }
 
+            template <>
+            void CPU_Emitter::EMITTER_DECL(ngraph::op::QuantizedDot)
+            {
+                auto qdot = static_cast<const ngraph::op::QuantizedDot*>(node);
+                writer << "cpu::kernel::quantized_dot(" << args[0].get_name() << ",\n";
+                writer << "                           " << args[1].get_name() << ",\n";
+                writer << "                           "
+                       << (qdot->has_bias() ? args[8].get_name() : "nullptr") << ",\n";
+                writer << "                           " << out[0].get_name() << ",\n";
+                writer << "                           " << args[0].get_shape()[0] << ",\n";
+                writer << "                           " << args[0].get_shape()[1] << ",\n";
+                writer << "                           " << out[0].get_shape()[1] << ",\n";
+                writer << "                           "
+                       << emit_float(qdot->get_dequantize_scale()) << ",\n";
+                writer << "                           "
+                       << emit_float(qdot->get_requantize_scale()) << ");\n";
+                writer << "*(" << out[1].get_name()
+                       << ") = " << emit_float(qdot->get_freezed_output_min()) << ";\n";
+                writer << "*(" << out[2].get_name()
+                       << ") = " << emit_float(qdot->get_freezed_output_max()) << ";\n";
+            }
+
             template <>
             void CPU_Emitter::EMITTER_DECL(ngraph::op::GroupConvolution)
             {
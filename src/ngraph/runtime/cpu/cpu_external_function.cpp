@@ -14,10 +14,15 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <condition_variable>
 #include <cstdlib>
+#include <deque>
+#include <exception>
 #include <fstream>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <typeindex>
 #include <typeinfo>
@@ -34,8 +39,8 @@
 
 #include <tbb/flow_graph.h>
 
-#if !defined(NGRAPH_DEX_ONLY)
 #include "ngraph/codegen/code_writer.hpp"
+#if !defined(NGRAPH_DEX_ONLY)
 #include "ngraph/codegen/compiler.hpp"
 #include "ngraph/codegen/execution_engine.hpp"
 #endif
@@ -117,6 +122,7 @@
 #include "ngraph/op/topk.hpp"
 #include "ngraph/pass/algebraic_simplification.hpp"
 #include "ngraph/pass/common_function_collection.hpp"
+#include "ngraph/pass/constant_folding.hpp"
 #include "ngraph/pass/core_fusion.hpp"
 #include "ngraph/pass/cse.hpp"
 #include "ngraph/pass/dump_sorted.hpp"
@@ -132,8 +138,11 @@
 #include "ngraph/runtime/cpu/cpu_call_frame.hpp"
 #include "ngraph/runtime/cpu/cpu_emitter.hpp"
 #include "ngraph/runtime/cpu/cpu_external_function.hpp"
+#include "ngraph/runtime/cpu/cpu_op_profiler.hpp"
+#include "ngraph/runtime/cpu/cpu_perf_events.hpp"
 #include "ngraph/runtime/cpu/cpu_tensor_view.hpp"
 #include "ngraph/runtime/cpu/cpu_tracing.hpp"
+#include "ngraph/runtime/cpu/kernel/eigen_thread_pool.hpp"
 #include "ngraph/runtime/cpu/cpu_visualize_tree.hpp"
 #include "ngraph/runtime/cpu/mkldnn_utils.hpp"
 #include "ngraph/runtime/cpu/op/batch_dot.hpp"
@@ -152,6 +161,7 @@
 #include "ngraph/runtime/cpu/op/quantize.hpp"
 #include "ngraph/runtime/cpu/op/quantized_avg_pool.hpp"
 #include "ngraph/runtime/cpu/op/quantized_conv.hpp"
+#include "ngraph/runtime/cpu/op/quantized_dot.hpp"
 #include "ngraph/runtime/cpu/op/quantized_max_pool.hpp"
 #include "ngraph/runtime/cpu/op/rnn.hpp"
 #include "ngraph/runtime/cpu/op/sigmoid.hpp"
@@ -164,6 +174,7 @@
 #include "ngraph/runtime/cpu/pass/cpu_layout.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_mat_fusion.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_post_layout_optimizations.hpp"
+#include "ngraph/runtime/cpu/pass/cpu_reduced_precision_fallback.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_rnn_fusion.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_workspace_insertion.hpp"
 
@@ -179,27 +190,45 @@ runtime::cpu::CPU_ExternalFunction::CPU_ExternalFunction(
     : m_function(function)
     , m_release_function(release_function)
     , m_use_tbb(std::getenv("NGRAPH_CPU_USE_TBB") != nullptr)
+    , m_parallel_execution(false)
+    , m_max_parallel_ops(0)
     , m_compiled_function(nullptr)
 #if !defined(NGRAPH_DEX_ONLY)
     , m_is_compiled(false)
-    , m_emit_timing(false)
 #endif
+    , m_emit_timing(false)
+    , m_emit_standalone(false)
     , m_function_name(function->get_name())
+    , m_building_program(nullptr)
+    , m_dex_has_temporaries(false)
+    , m_profiling_interval(0)
     , m_is_built(false)
 #if !defined(NGRAPH_DEX_ONLY)
     , m_direct_execution(std::getenv("NGRAPH_DEX") != nullptr)
 #else
     , m_direct_execution(true)
 #endif
+    , m_borrow_scratch(true)
 {
+    // Values cached between calls for cacheable parameters and TBB flow graphs built on the
+    // first call both live in the scratch pool, so those functions keep a pool per context
+    if (m_use_tbb && !m_direct_execution)
+    {
+        m_borrow_scratch = false;
+    }
+    for (auto& param : function->get_parameters())
+    {
+        if (param->get_cacheable())
+        {
+            m_borrow_scratch = false;
+        }
+    }
 }
 
 runtime::cpu::CPU_ExternalFunction::~CPU_ExternalFunction()
 {
 }
 
-#if !defined(NGRAPH_DEX_ONLY)
-
 static const string s_output_dir = "cpu_codegen";
 
 class StaticInitializers
@@ -240,6 +269,40 @@ static string emit_string_array(const vector<string>& s, size_t max_line_length)
     return ss.str();
 }
 
+// Smallest number of ops worth compiling in a translation unit of its own, unless
+// NGRAPH_CODEGEN_MIN_OPS_PER_PARTITION sets another
+static const size_t s_min_ops_per_partition = 64;
+
+static size_t get_codegen_thread_count()
+{
+    const char* env_threads = std::getenv("NGRAPH_CODEGEN_THREADS");
+    size_t threads = env_threads ? std::atoi(env_threads) : std::thread::hardware_concurrency();
+    return max<size_t>(threads, 1);
+}
+
+static size_t get_min_ops_per_partition()
+{
+    const char* env_ops = std::getenv("NGRAPH_CODEGEN_MIN_OPS_PER_PARTITION");
+    size_t ops = env_ops ? std::atoi(env_ops) : s_min_ops_per_partition;
+    return max<size_t>(ops, 1);
+}
+
+static void emit_constant_data(codegen::CodeWriter& writer,
+                               const string& name,
+                               const uint8_t* data,
+                               size_t size)
+{
+    writer << "alignas(" << runtime::cpu::CPU_ExternalFunction::s_memory_pool_alignment
+           << ") static uint8_t " << name << "[" << max(size, size_t(1)) << "] = {";
+    stringstream ss;
+    ss << hex;
+    for (size_t i = 0; i < size; i++)
+    {
+        ss << (i % 32 == 0 ? "\n" : "") << "0x" << static_cast<unsigned>(data[i]) << ",";
+    }
+    writer << ss.str() << "};\n";
+}
+
 static StaticInitializers s_static_initializers(s_output_dir);
 
 #define TI(x) type_index(typeid(x))
@@ -310,6 +373,7 @@ static const runtime::cpu::OpMap dispatcher{
     {TI(ngraph::op::ConvolutionRelu), &runtime::cpu::CPU_Emitter::emit<op::ConvolutionRelu>},
     {TI(ngraph::op::QuantizedConvolution),
      &runtime::cpu::CPU_Emitter::emit<op::QuantizedConvolution>},
+    {TI(ngraph::op::QuantizedDot), &runtime::cpu::CPU_Emitter::emit<op::QuantizedDot>},
     {TI(ngraph::op::ConvolutionBiasAdd), &runtime::cpu::CPU_Emitter::emit<op::ConvolutionBiasAdd>},
     // conv+bias backprop for data share the same implementation as ConvolutionBackpropData
     {TI(ngraph::op::ConvolutionBiasBackpropFiltersBias),
@@ -377,6 +441,10 @@ void runtime::cpu::CPU_ExternalFunction::register_common_passes(ngraph::pass::Ma
 {
     pass_manager.register_pass<ngraph::pass::LikeReplacement>();
     pass_manager.register_pass<ngraph::pass::NopElimination>();
+    pass_manager.register_pass<ngraph::pass::ConstantFolding>(
+        vector<ngraph::pass::ConstantFolding::CFTransformations>{
+            ngraph::pass::ConstantFolding::CFTransformations::ARITHMETIC});
+    pass_manager.register_pass<runtime::cpu::pass::CPUReducedPrecisionFallback>();
     // TODO (pruthvi): Enable all the disabeled RNN fusion graph pass after fixing
     // failing mxnet unit tests.
     // pass_manager.register_pass<runtime::cpu::pass::LSTMFusion>();
@@ -387,18 +455,28 @@ void runtime::cpu::CPU_ExternalFunction::register_common_passes(ngraph::pass::Ma
     pass_manager.register_pass<runtime::cpu::pass::CPUBatchFusion>();
     pass_manager.register_pass<ngraph::pass::CommonSubexpressionElimination>();
     pass_manager.register_pass<ngraph::pass::CoreFusion>();
-    pass_manager.register_pass<runtime::cpu::pass::CPUFusion>();
-    pass_manager.register_pass<runtime::cpu::pass::CPUHorizontalFusion>();
+    // Standalone libraries cannot create MKLDNN primitives, so they skip the fusions into
+    // MKLDNN-only ops and the assignment of ops to MKLDNN kernels
+    if (!m_emit_standalone)
+    {
+        pass_manager.register_pass<runtime::cpu::pass::CPUFusion>();
+        pass_manager.register_pass<runtime::cpu::pass::CPUHorizontalFusion>();
+    }
     pass_manager.register_pass<runtime::cpu::pass::CPUCollapseDims>();
-    NodeVector nv_cwi; // We dont need CPUWorkspaceInsertion to return list of indices
-    pass_manager.register_pass<runtime::cpu::pass::CPUWorkspaceInsertion>(nv_cwi, false);
-    pass_manager.register_pass<runtime::cpu::pass::CPUAssignment>(this);
+    if (!m_emit_standalone)
+    {
+        NodeVector nv_cwi; // We dont need CPUWorkspaceInsertion to return list of indices
+        pass_manager.register_pass<runtime::cpu::pass::CPUWorkspaceInsertion>(nv_cwi, false);
+        pass_manager.register_pass<runtime::cpu::pass::CPUAssignment>(this);
+    }
     pass_manager.register_pass<runtime::cpu::pass::CPULayout>(this);
     pass_manager.register_pass<runtime::cpu::pass::CPUPostLayoutOptimizations>();
     pass_manager.register_pass<ngraph::pass::GetOutputElementElimination>();
     pass_manager.get_state().set_visualize_tree_ops_map(runtime::cpu::get_visualize_tree_ops_map());
 }
 
+#if !defined(NGRAPH_DEX_ONLY)
+
 void runtime::cpu::CPU_ExternalFunction::compile()
 {
     if (m_is_compiled)
@@ -406,6 +484,165 @@ void runtime::cpu::CPU_ExternalFunction::compile()
         return;
     }
 
+    string code = emit_code();
+
+    m_compiler.reset(new codegen::Compiler());
+    m_execution_engine.reset(new codegen::ExecutionEngine());
+
+    m_compiler->set_precompiled_header_source(m_pch_header_source);
+    if (const char* cache_dir = std::getenv("NGRAPH_CPU_CODEGEN_CACHE"))
+    {
+        m_compiler->set_cache_directory(cache_dir);
+    }
+
+    vector<string> sources{code};
+    sources.insert(sources.end(), m_code_partitions.begin(), m_code_partitions.end());
+    vector<unique_ptr<codegen::Module>> codegen_modules;
+    if (sources.size() == 1)
+    {
+        codegen_modules.push_back(m_compiler->compile(code));
+    }
+    else
+    {
+        codegen_modules = m_compiler->compile(sources, get_codegen_thread_count());
+    }
+
+    for (auto& codegen_module : codegen_modules)
+    {
+        if (codegen_module == nullptr)
+        {
+            throw runtime_error("function failed to compile");
+        }
+        m_execution_engine->add_module(codegen_module);
+    }
+    m_execution_engine->finalize();
+    m_compiled_function = m_execution_engine->find_function<EntryPoint_t>(m_function_name);
+
+    if (m_compiled_function == nullptr)
+    {
+        throw runtime_error("could not find compiled function");
+    }
+
+    auto init_constants =
+        m_execution_engine->find_function<void(void**)>(m_function_name + "_init_constants");
+    if (init_constants == nullptr)
+    {
+        throw runtime_error("could not find constant initializer in compiled function");
+    }
+    vector<void*> constant_ptrs;
+    for (auto& node : m_active_constants)
+    {
+        constant_ptrs.push_back(
+            const_cast<void*>(static_pointer_cast<ngraph::op::Constant>(node)->get_data_ptr()));
+    }
+    init_constants(constant_ptrs.data());
+
+    store_layouts();
+
+    m_is_compiled = true;
+    if (m_release_function)
+    {
+        release_function();
+    }
+}
+
+#endif
+
+string runtime::cpu::CPU_ExternalFunction::emit_standalone_source()
+{
+    if (m_use_tbb || m_emit_timing)
+    {
+        throw ngraph_error(
+            "TBB flow graphs and debug timers are not supported in standalone libraries");
+    }
+
+    m_emit_standalone = true;
+    string code = emit_code();
+    m_emit_standalone = false;
+
+    if (!m_mkldnn_emitter->get_mkldnn_primitives().empty())
+    {
+        throw ngraph_error("Function " + m_function_name +
+                           " has ops without a kernel outside MKLDNN, whose primitives only "
+                           "exist in the compiling process");
+    }
+
+    store_layouts();
+    for (auto& layouts : {parameter_layout_descriptors, result_layout_descriptors})
+    {
+        for (auto& layout : layouts)
+        {
+            if (layout->is_mkldnn_layout())
+            {
+                throw ngraph_error(
+                    "Standalone libraries require default layouts for parameters and results");
+            }
+        }
+    }
+
+    codegen::CodeWriter writer;
+    writer += code;
+    writer << "// Standalone entry points\n";
+    writer << "extern \"C\" size_t ngraph_get_input_count() { return "
+           << parameter_layout_descriptors.size() << "; }\n";
+    writer << "extern \"C\" size_t ngraph_get_output_count() { return "
+           << result_layout_descriptors.size() << "; }\n\n";
+
+    writer << "extern \"C\" void* ngraph_create_context()\n";
+    writer << "{\n";
+    writer.indent++;
+    writer << "cpu::CPURuntimeContext* ctx = new cpu::CPURuntimeContext();\n";
+    writer << "ctx->first_iteration = true;\n";
+    // Every input is treated as modified on every call
+    writer << "ctx->p_en = new bool[" << max(parameter_layout_descriptors.size(), size_t(1))
+           << "];\n";
+    writer << "std::fill(ctx->p_en, ctx->p_en + " << parameter_layout_descriptors.size()
+           << ", true);\n";
+    for (size_t size : m_memory_buffer_sizes)
+    {
+        writer << "ctx->memory_buffers.push_back(new AlignedBuffer(" << size << ", "
+               << s_memory_pool_alignment << "));\n";
+    }
+    writer << "ctx->t_en = new bool*[" << m_tensor_enable_sizes.size() << "];\n";
+    for (size_t i = 0; i < m_tensor_enable_sizes.size(); i++)
+    {
+        writer << "ctx->t_en[" << i << "] = new bool[" << m_tensor_enable_sizes[i] << "]();\n";
+    }
+    writer << "return ctx;\n";
+    writer.indent--;
+    writer << "}\n\n";
+
+    writer << "extern \"C\" void ngraph_destroy_context(void* context)\n";
+    writer << "{\n";
+    writer.indent++;
+    writer << "cpu::CPURuntimeContext* ctx = static_cast<cpu::CPURuntimeContext*>(context);\n";
+    writer << "delete[] ctx->p_en;\n";
+    for (size_t i = 0; i < m_tensor_enable_sizes.size(); i++)
+    {
+        writer << "delete[] ctx->t_en[" << i << "];\n";
+    }
+    writer << "delete[] ctx->t_en;\n";
+    writer << "for (auto buffer : ctx->memory_buffers)\n";
+    writer << "{\n";
+    writer << "    delete buffer;\n";
+    writer << "}\n";
+    writer << "delete ctx;\n";
+    writer.indent--;
+    writer << "}\n\n";
+
+    writer << "extern \"C\" void ngraph_call(void* context, void** inputs, void** outputs)\n";
+    writer << "{\n";
+    writer.indent++;
+    writer << m_function_name
+           << "(inputs, outputs, static_cast<cpu::CPURuntimeContext*>(context));\n";
+    writer.indent--;
+    writer << "}\n";
+
+    return writer.get_code();
+}
+
+string runtime::cpu::CPU_ExternalFunction::emit_code()
+{
     m_mkldnn_emitter.reset(new MKLDNNEmitter());
 
     ngraph::pass::Manager pass_manager;
@@ -428,6 +665,29 @@ void runtime::cpu::CPU_ExternalFunction::compile()
         function_ordered_ops.insert({current_function, current_function->get_ordered_ops()});
     }
 
+    // Large functions are split into several translation units which are compiled
+    // concurrently. TBB flow graphs, tracing and debug timers keep state in locals of the
+    // generated function, so those modes always use a single translation unit.
+    m_code_partitions.clear();
+    size_t partition_count = 1;
+    size_t ops_per_partition = 0;
+    if (!m_use_tbb && !m_emit_timing && !m_emit_standalone && !runtime::cpu::IsTracingEnabled())
+    {
+        size_t op_count = 0;
+        for (auto& node : function_ordered_ops.at(m_function))
+        {
+            if (!node->is_parameter() && !node->is_constant())
+            {
+                op_count++;
+            }
+        }
+        partition_count =
+            max<size_t>(1, min(get_codegen_thread_count(), op_count / get_min_ops_per_partition()));
+        ops_per_partition = (op_count + partition_count - 1) / partition_count;
+    }
+    vector<size_t> partition_offsets;
+    bool partition_temporaries_used = false;
+
     codegen::CodeWriter writer;
 
     writer << "// Generated by the nGraph CPU backend\n";
@@ -479,10 +739,14 @@ void runtime::cpu::CPU_ExternalFunction::compile()
 #include "ngraph/runtime/reference/topk.hpp"
 #include "ngraph/shape.hpp"
 #include "ngraph/strides.hpp"
+#include "ngraph/type/bfloat16.hpp"
+#include "ngraph/type/float16.hpp"
 #include "ngraph/util.hpp"
 
 using namespace ngraph::runtime::cpu::eigen;
 using namespace ngraph::runtime;
+using ngraph::bfloat16;
+using ngraph::float16;
 
 )";
 
@@ -490,14 +754,17 @@ using namespace ngraph::runtime;
     writer << "#include <mpi.h>\n\n";
 #endif
 
-    string pch_header_source = writer.get_code();
+    m_pch_header_source = writer.get_code();
 
     // The "dso_handle" symbol is required by __cxa_atexit()
     // which is enabled because the JIT uses it as the default mechanism
     // to register cleanup handlers. We use it, and not atexit(), because
     // atexit() happens too late, when the JIT is no longer alive
 
-    writer << "void *__dso_handle = 0;\n\n";
+    if (!m_emit_standalone)
+    {
+        writer << "void *__dso_handle = 0;\n\n";
+    }
 
     if (m_emit_timing)
     {
@@ -564,14 +831,44 @@ using namespace ngraph::runtime;
                 m_active_constants.push_back(node);
                 shared_ptr<descriptor::TensorView> tv = node->get_outputs()[0].get_tensor_ptr();
                 string type = tv->get_element_type().c_type_string();
-                writer << "static " << type << "* " << tv->get_name() << " = ((" << type << "*)("
-                       << c->get_data_ptr() << "));\n";
+                if (m_emit_standalone)
+                {
+                    // Standalone libraries carry their own copy of the constant data
+                    emit_constant_data(writer,
+                                       tv->get_name() + "_data",
+                                       static_cast<const uint8_t*>(c->get_data_ptr()),
+                                       shape_size(c->get_shape()) *
+                                           c->get_element_type().size());
+                    writer << "static " << type << "* " << tv->get_name() << " = reinterpret_cast<"
+                           << type << "*>(" << tv->get_name() << "_data);\n";
+                }
+                else
+                {
+                    // Other translation units refer to constants of a partitioned function
+                    writer << (partition_count > 1 ? "" : "static ") << type << "* "
+                           << tv->get_name() << ";\n";
+                }
                 m_variable_name_map[tv->get_name()] = tv->get_name();
                 m_tensor_roles[tv->get_name()] = CPUTensorRole::CONSTANT;
             }
         }
     }
 
+    // Constant addresses are bound at load time rather than emitted as literals so the
+    // generated code is identical across processes and can be cached
+    writer << "extern \"C\" void " << m_function_name << "_init_constants(void** constants)\n";
+    writer << "{\n";
+    writer.indent++;
+    for (size_t i = 0; i < m_active_constants.size(); i++)
+    {
+        shared_ptr<descriptor::TensorView> tv =
+            m_active_constants[i]->get_outputs()[0].get_tensor_ptr();
+        string type = tv->get_element_type().c_type_string();
+        writer << tv->get_name() << " = static_cast<" << type << "*>(constants[" << i << "]);\n";
+    }
+    writer.indent--;
+    writer << "}\n\n";
+
     writer << "// Declare all functions\n";
     for (shared_ptr<Function> f : pass_manager.get_state().get_functions())
     {
@@ -636,7 +933,22 @@ using namespace ngraph::runtime;
             }
         }
 
-        writer << "bool " << current_function->get_name() << "_t_en[" << tensor_index << "];\n";
+        // Tensor enable flags live in the runtime context so concurrent calls on separate
+        // contexts do not share them
+        size_t t_en_index = m_tensor_enable_sizes.size();
+        m_tensor_enable_sizes.push_back(tensor_index);
+
+        bool partitioned = partition_count > 1 && current_function == m_function;
+        if (partitioned)
+        {
+            for (size_t i = 1; i < partition_count; i++)
+            {
+                writer << "extern \"C\" void " << current_function->get_name() << "_part" << i
+                       << "(void** inputs, void** outputs, cpu::CPURuntimeContext* ctx, "
+                          "bool* t_en, size_t pool_base_ptr);\n";
+            }
+            partition_temporaries_used = temporaries_used;
+        }
 
         writer << "extern \"C\" void " << current_function->get_name();
         writer << "(void** inputs, void** outputs, cpu::CPURuntimeContext* ctx)\n";
@@ -670,7 +982,7 @@ using namespace ngraph::runtime;
             }
         }
 
-        writer << "bool* t_en = (bool*)" << current_function->get_name() << "_t_en;\n";
+        writer << "bool* t_en = ctx->t_en[" << t_en_index << "];\n";
 
         if (m_use_tbb)
         {
@@ -731,8 +1043,21 @@ using namespace ngraph::runtime;
             }
         }
 
+        size_t emitted_op_count = 0;
+        if (partitioned)
+        {
+            partition_offsets.push_back(writer.get_code().size());
+        }
         for (shared_ptr<Node> node : ordered_ops)
         {
+            if (partitioned && !node->is_parameter() && !node->is_constant())
+            {
+                if (emitted_op_count > 0 && emitted_op_count % ops_per_partition == 0)
+                {
+                    partition_offsets.push_back(writer.get_code().size());
+                }
+                emitted_op_count++;
+            }
             auto& n = *node; // Work around a compiler warning (*node inside typeid may have effects
             // with shared pointers, which is fine here but clang doesn't like it.)
             auto handler = dispatcher.find(type_index(typeid(n)));
@@ -851,8 +1176,9 @@ using namespace ngraph::runtime;
                 writer << func_name << "(" << join(names) << ", ctx);\n";
             }
 
+            // The checks live in libngraph, which standalone libraries do not link.
             // skip multi-output nodes since they would be covered by GetOutputElement
-            if (node->get_output_size() == 1 &&
+            if (!m_emit_standalone && node->get_output_size() == 1 &&
                 // skip non-FP nodes
                 (node->get_element_type() == element::f32 ||
                  node->get_element_type() == element::f64))
@@ -904,6 +1230,10 @@ using namespace ngraph::runtime;
                 }
             }
         }
+        if (partitioned)
+        {
+            partition_offsets.push_back(writer.get_code().size());
+        }
 
         if (m_use_tbb)
         {
@@ -947,31 +1277,61 @@ using namespace ngraph::runtime;
         writer += "}\n\n";
     }
 
-    // TODO: Cleanup and make this a utility function
-    string filename = file_util::path_join(s_output_dir, m_function_name + "_codegen.cpp");
     string code = writer.get_code();
-    runtime::cpu::CPU_ExternalFunction::write_to_file(writer.get_code(), s_output_dir, filename);
-
-    m_compiler.reset(new codegen::Compiler());
-    m_execution_engine.reset(new codegen::ExecutionEngine());
-
-    m_compiler->set_precompiled_header_source(pch_header_source);
-
-    auto codegen_module = m_compiler->compile(code);
-
-    if (codegen_module == nullptr)
+    if (partition_offsets.size() > 2)
     {
-        throw runtime_error("function failed to compile");
+        // Every partition gets the headers and declarations of the main translation unit
+        stringstream partition_header;
+        partition_header << m_pch_header_source;
+        for (auto& node : m_active_constants)
+        {
+            shared_ptr<descriptor::TensorView> tv = node->get_outputs()[0].get_tensor_ptr();
+            partition_header << "extern " << tv->get_element_type().c_type_string() << "* "
+                             << tv->get_name() << ";\n";
+        }
+        for (shared_ptr<Function> f : pass_manager.get_state().get_functions())
+        {
+            partition_header << "extern \"C\" void " << f->get_name()
+                             << "(void** inputs, void** outputs, cpu::CPURuntimeContext* ctx);\n";
+        }
+        partition_header << common_function_string << "\n";
+
+        // Partition 0 stays in the main function, which calls the others in order
+        stringstream calls;
+        for (size_t i = 1; i + 1 < partition_offsets.size(); i++)
+        {
+            stringstream partition;
+            partition << partition_header.str();
+            partition << "extern \"C\" void " << m_function_name << "_part" << i
+                      << "(void** inputs, void** outputs, cpu::CPURuntimeContext* ctx, "
+                         "bool* t_en, size_t pool_base_ptr)\n{\n";
+            partition << code.substr(partition_offsets[i],
+                                     partition_offsets[i + 1] - partition_offsets[i]);
+            partition << "}\n";
+            m_code_partitions.push_back(partition.str());
+
+            calls << "    " << m_function_name << "_part" << i << "(inputs, outputs, ctx, t_en, "
+                  << (partition_temporaries_used ? "pool_base_ptr" : "0") << ");\n";
+        }
+        code = code.substr(0, partition_offsets[1]) + calls.str() +
+               code.substr(partition_offsets.back());
     }
-    m_execution_engine->add_module(codegen_module);
-    m_execution_engine->finalize();
-    m_compiled_function = m_execution_engine->find_function<EntryPoint_t>(m_function_name);
 
-    if (m_compiled_function == nullptr)
+    // TODO: Cleanup and make this a utility function
+    string filename = file_util::path_join(s_output_dir, m_function_name + "_codegen.cpp");
+    runtime::cpu::CPU_ExternalFunction::write_to_file(code, s_output_dir, filename);
+    for (size_t i = 0; i < m_code_partitions.size(); i++)
     {
-        throw runtime_error("could not find compiled function");
+        filename = file_util::path_join(
+            s_output_dir, m_function_name + "_codegen_part" + to_string(i + 1) + ".cpp");
+        runtime::cpu::CPU_ExternalFunction::write_to_file(
+            m_code_partitions[i], s_output_dir, filename);
     }
+    return code;
+}
 
+void runtime::cpu::CPU_ExternalFunction::store_layouts()
+{
     // Store layouts assigned for arguments
     for (const auto& parameter : m_function->get_parameters())
     {
@@ -1007,16 +1367,8 @@ using namespace ngraph::runtime;
                 static_pointer_cast<runtime::cpu::LayoutDescriptor>(tv->get_tensor_layout()));
         }
     }
-
-    m_is_compiled = true;
-    if (m_release_function)
-    {
-        release_function();
-    }
 }
 
-#endif
-
 bool runtime::cpu::CPU_ExternalFunction::computes_result(Node* node)
 {
     for (size_t i = 0; i < node->get_output_size(); i++)
@@ -1144,83 +1496,43 @@ void runtime::cpu::CPU_ExternalFunction::build()
     pass_manager.register_pass<ngraph::pass::MemoryLayout>(size_t(s_memory_pool_alignment), true);
     pass_manager.run_passes(m_function, false);
 
-    // Store layouts assigned for arguments
-    for (const auto& parameter : m_function->get_parameters())
-    {
-        for (size_t i = 0; i < parameter->get_output_size(); ++i)
-        {
-            auto tv = parameter->get_output_tensor_ptr(i);
-            if (tv->get_tensor_layout() == nullptr)
-            {
-                throw ngraph_error("layout missing on function parameter's tensor view: " +
-                                   tv->get_name());
-            }
-            parameter_layout_descriptors.emplace_back(
-                static_pointer_cast<runtime::cpu::LayoutDescriptor>(tv->get_tensor_layout()));
-        }
-    }
+    store_layouts();
 
-    // Store layouts assigned for results
-    if (!result_layout_descriptors.empty())
-    {
-        throw ngraph_error("Function output layouts should not be pre-assigned");
-    }
-    for (size_t i = 0; i < m_function->get_output_size(); ++i)
-    {
-        const auto& output = m_function->get_output_op(i);
-        for (size_t j = 0; j < output->get_output_size(); ++j)
-        {
-            auto tv = output->get_output_tensor_ptr(j);
-            if (tv->get_tensor_layout() == nullptr)
-            {
-                throw ngraph_error("layout missing on function output tensor: " + tv->get_name());
-            }
-            result_layout_descriptors.emplace_back(
-                static_pointer_cast<runtime::cpu::LayoutDescriptor>(tv->get_tensor_layout()));
-        }
-    }
+    // Hold one snapshot of the order so every table below is built from the same list
+    auto ordered_ops = m_function->get_ordered_ops_view();
 
-    // Build executor
     // Intermediates
     if (m_function->get_temporary_pool_size())
     {
         m_memory_buffer_sizes.push_back(m_function->get_temporary_pool_size());
 
-        for (auto& node : m_function->get_ordered_ops())
+        for (auto& node : *ordered_ops)
         {
             for (auto tensor : node->liveness_new_list)
             {
-                intermediates_offsets.emplace_back(tensor_data[tensor->get_name()],
-                                                   tensor->get_pool_offset());
                 m_tensor_roles[tensor->get_name()] = CPUTensorRole::INTERMEDIATE;
             }
         }
     }
 
     // Constants
-    for (auto& node : m_function->get_ordered_ops())
+    for (auto& node : *ordered_ops)
     {
         if (node->is_constant())
         {
             auto tv = node->get_outputs()[0].get_tensor_ptr();
-            tensor_data[tv->get_name()] =
-                const_cast<void*>(static_pointer_cast<ngraph::op::Constant>(node)->get_data_ptr());
             m_tensor_roles[tv->get_name()] = CPUTensorRole::CONSTANT;
         }
     }
 
     // Inputs
-    size_t arg_index = 0;
     for (auto& param : m_function->get_parameters())
     {
         for (size_t i = 0; i < param->get_output_size(); ++i)
         {
             shared_ptr<descriptor::TensorView> tv = param->get_output_tensor_ptr(i);
-            function_input_index.emplace_back(
-                tensor_data[tv->get_name()], arg_index, tensor_stale[tv->get_name()]);
             m_tensor_roles[tv->get_name()] = CPUTensorRole::INPUT;
             propagate_in_place_input(&param->get_outputs().at(i), tv->get_name(), true);
-            arg_index++;
         }
     }
 
@@ -1229,7 +1541,6 @@ void runtime::cpu::CPU_ExternalFunction::build()
     {
         shared_ptr<Node> op = m_function->get_output_op(i);
         shared_ptr<descriptor::TensorView> tv = op->get_output_tensor_ptr();
-        function_output_index.emplace_back(tensor_data[tv->get_name()], i);
         m_tensor_roles[tv->get_name()] = CPUTensorRole::OUTPUT;
 
         //keep assigning different outputs to a result descriptor
@@ -1241,7 +1552,6 @@ void runtime::cpu::CPU_ExternalFunction::build()
         {
             shared_ptr<descriptor::TensorView> itv =
                 res->get_inputs().at(0).get_output().get_tensor_ptr();
-            function_output_index.emplace_back(tensor_data[itv->get_name()], i);
             m_tensor_roles[itv->get_name()] = CPUTensorRole::OUTPUT;
             tensor_alias[itv->get_name()] = tv->get_name();
             propagate_in_place_output(
@@ -1249,96 +1559,86 @@ void runtime::cpu::CPU_ExternalFunction::build()
         }
     }
 
-    for (shared_ptr<Node> node : m_function->get_ordered_ops())
+    vector<string> op_names;
+    for (const shared_ptr<Node>& node : *ordered_ops)
     {
         if (node->is_parameter() || node->is_constant())
         {
             continue;
         }
-        auto& n = *node; // Work around a compiler warning (*node inside typeid may have effects
-        // with shared pointers, which is fine here but clang doesn't like it.)
-        auto handler = GetGlobalBuildDispatcher().find(type_index(typeid(n)));
-        if (handler == GetGlobalBuildDispatcher().end())
-        {
-            throw unsupported_op(node->description());
-        }
-        vector<TensorViewWrapper> in;
         vector<string> in_names;
         for (const descriptor::Input& input : node->get_inputs())
         {
-            const descriptor::Output& output = input.get_output();
-            shared_ptr<descriptor::TensorView> tv = output.get_tensor_ptr();
-            in.push_back(TensorViewWrapper(tv, tv->get_name()));
-            in_names.push_back(tv->get_name());
+            in_names.push_back(input.get_output().get_tensor_ptr()->get_name());
         }
-        vector<TensorViewWrapper> out;
         vector<string> out_names;
-
         for (const descriptor::Output& output : node->get_outputs())
         {
-            shared_ptr<descriptor::TensorView> tv = output.get_tensor_ptr();
-            out.push_back(TensorViewWrapper(tv, tv->get_name()));
-            out_names.push_back(tv->get_name());
+            out_names.push_back(output.get_tensor_ptr()->get_name());
         }
-
         m_op_attrs.emplace_back(node->description(), out_names, in_names);
+        op_names.push_back(node->get_name());
+    }
 
-        handler->second(this, node.get(), in, out);
-
-        bool disable_caching = computes_result(node.get()) || possibly_overwritten(node.get());
+    // The first runtime context takes this program; later ones build their own
+    {
+        lock_guard<mutex> lock(m_build_mutex);
+        m_dex_ordered_ops = ordered_ops;
+        m_dex_parameters = m_function->get_parameters();
+        m_dex_results = m_function->get_results();
+        m_dex_has_temporaries = m_function->get_temporary_pool_size() != 0;
+        m_dex_program = build_dex_program();
+    }
 
-        vector<reference_wrapper<bool>> in_stale, out_stale;
-        for (const auto& name : in_names)
+    // Dependency graph used to run independent functors concurrently
+    unordered_map<Node*, size_t> op_index;
+    for (const shared_ptr<Node>& node : *ordered_ops)
+    {
+        if (!node->is_parameter() && !node->is_constant())
         {
-            if (tensor_alias.count(name))
-            {
-                in_stale.emplace_back(tensor_stale[tensor_alias[name]]);
-            }
-            else
-            {
-                in_stale.emplace_back(tensor_stale[name]);
-            }
+            op_index.insert({node.get(), op_index.size()});
         }
-        for (const auto& name : out_names)
+    }
+    m_op_successors.assign(op_index.size(), {});
+    m_op_predecessor_counts.assign(op_index.size(), 0);
+    auto add_dependency = [this, &op_index](Node* from, Node* to) {
+        auto from_it = op_index.find(from);
+        if (from_it != op_index.end() && from != to)
         {
-            out_stale.emplace_back(tensor_stale[name]);
+            auto& successors = m_op_successors[from_it->second];
+            size_t to_index = op_index.at(to);
+            if (find(successors.begin(), successors.end(), to_index) == successors.end())
+            {
+                successors.push_back(to_index);
+                m_op_predecessor_counts[to_index]++;
+            }
         }
-
-        function<bool(CPURuntimeContext*)> enable;
-        if (disable_caching)
+    };
+    for (auto& p : op_index)
+    {
+        Node* node = p.first;
+        for (const descriptor::Input& input : node->get_inputs())
         {
-            enable = [in_stale, out_stale](CPURuntimeContext* ctx) -> bool {
-                for (auto& stale : out_stale)
-                {
-                    stale.get() = true;
-                }
-                return true;
-            };
+            add_dependency(input.get_output().get_node().get(), node);
         }
-        else
+        // An in-place kernel overwrites its input, so it must wait for every other reader
+        // of that input, not only for the producer
+        if (auto op = dynamic_cast<ngraph::op::Op*>(node))
         {
-            enable = [in_stale, out_stale](CPURuntimeContext* ctx) -> bool {
-                bool en = false;
-                for (const auto& stale : in_stale)
+            if (auto op_annotations = op->get_op_annotations())
+            {
+                for (auto oi_pair : op_annotations->get_in_place_oi_pairs())
                 {
-                    if (stale)
+                    const descriptor::Output& output =
+                        node->get_inputs().at(oi_pair.input).get_output();
+                    for (descriptor::Input* reader : output.get_inputs())
                     {
-                        en = true;
-                        break;
+                        add_dependency(reader->get_node().get(), node);
                     }
                 }
-                for (auto& stale : out_stale)
-                {
-                    stale.get() = en;
-                }
-                return en;
-            };
+            }
         }
-
-        enables.emplace_back(enable);
-        enable_nodename_list.emplace_back(make_pair(enable, node->get_name()));
     }
-
     if ((std::getenv("NGRAPH_DEX_DEBUG") != nullptr))
     {
         string filename = file_util::path_join(s_debug_dir, m_function_name + "_debug.txt");
@@ -1364,7 +1664,8 @@ void runtime::cpu::CPU_ExternalFunction::build()
 
         //dump the op's order of execution along with the address of
         //tensor_data which holds the base address of each tensor.
-        for (shared_ptr<Node> node : m_function->get_ordered_ops())
+        auto& tensor_data = m_dex_program->tensor_data;
+        for (const shared_ptr<Node>& node : *ordered_ops)
         {
             std::vector<string> node_inputs;
             std::vector<string> node_outputs;
@@ -1399,124 +1700,46 @@ void runtime::cpu::CPU_ExternalFunction::build()
         }
     }
     //This check ensures we have exactly one functor for Op.
-    assert(m_op_attrs.size() == functors.size());
+    assert(m_op_attrs.size() == m_dex_program->functors.size());
+
+    if (m_profiling_interval > 0)
+    {
+        m_op_profiler.reset(new OpProfiler(op_names, m_profiling_interval));
+    }
 
-    executor = [&](CPURuntimeContext* ctx, vector<void*>& inputs, vector<void*>& outputs) {
+    executor = [this](CPURuntimeContext* ctx, vector<void*>& inputs, vector<void*>& outputs) {
+        DEXProgram& program = *ctx->dex_program;
         cpu::Timestamp start_ts;
         int profiler_count = 0;
+        bool sample = m_op_profiler && m_op_profiler->sample_call();
+        bool count_events = PerfEventGroup::is_enabled() && (sample || ctx->op_events);
 
-        if (ctx->first_iteration)
+        // Borrowed pools can differ from call to call, so rebind intermediates every time
+        for (auto& p : program.intermediates_offsets)
         {
-            for (auto& p : intermediates_offsets)
-            {
-                p.first.get() = static_cast<uint8_t*>(ctx->memory_buffers[0]->get_ptr()) + p.second;
-            }
+            p.first.get() = static_cast<uint8_t*>(ctx->memory_buffers[0]->get_ptr()) + p.second;
         }
 
-        for (const auto& p : function_input_index)
+        for (const auto& p : program.function_input_index)
         {
             get<0>(p).get() = inputs[get<1>(p)];
             get<2>(p).get() = ctx->p_en[get<1>(p)];
         }
 
-        for (const auto& p : function_output_index)
+        for (const auto& p : program.function_output_index)
         {
             p.first.get() = outputs[p.second];
         }
 
-        auto functor = functors.begin();
-        if (m_use_tbb)
+        auto functor = program.functors.begin();
+        if (m_parallel_execution && program.functors.size() > 1)
         {
-            // Build the flow graph
-            if (ctx->first_iteration)
-            {
-                std::unordered_map<
-                    std::string,
-                    tbb::flow::continue_node<tbb::flow::continue_msg, tbb::flow::lightweight>*>
-                    nodename_tbbnode_map;
-                tbb::flow::continue_node<tbb::flow::continue_msg,
-                                         tbb::flow::lightweight>* flowgraph_node_start =
-                    new tbb::flow::continue_node<tbb::flow::continue_msg, tbb::flow::lightweight>(
-                        *(ctx->G), [&](const tbb::flow::continue_msg& msg) {});
-                auto it = enable_nodename_list.begin();
-                for (const auto& p : enables)
-                {
-                    tbb::flow::continue_node<tbb::flow::continue_msg, tbb::flow::lightweight>*
-                        flowgraph_node = new tbb::flow::continue_node<tbb::flow::continue_msg,
-                                                                      tbb::flow::lightweight>(
-                            *(ctx->G), [&](const tbb::flow::continue_msg& msg) {
-                                if (p(ctx) || ctx->first_iteration)
-                                {
-                                    if (runtime::cpu::IsTracingEnabled())
-                                    {
-                                        start_ts = cpu::Clock::now();
-                                    }
-                                    (*functor)(ctx);
-                                    if (runtime::cpu::IsTracingEnabled())
-                                    {
-                                        ctx->op_durations[profiler_count++] =
-                                            (std::chrono::duration_cast<cpu::Timescale>(
-                                                 cpu::Clock::now() - start_ts))
-                                                .count();
-                                    }
-                                }
-                                else
-                                {
-                                    if (runtime::cpu::IsTracingEnabled())
-                                    {
-                                        ctx->op_durations[profiler_count++] = 0;
-                                    }
-                                }
-                                std::advance(functor, 1);
-                            });
-                    nodename_tbbnode_map.insert({it->second, flowgraph_node});
-                    it++;
-                }
-
-                traverse_nodes(
-                    m_function, [&flowgraph_node_start, &nodename_tbbnode_map](shared_ptr<Node> n) {
-                        if (!n->is_parameter() && !n->is_constant())
-                        {
-                            bool is_head = true;
-                            for (auto arg : n->get_arguments())
-                            {
-                                if (!arg->is_parameter() && !arg->is_constant())
-                                {
-                                    is_head = false;
-                                    tbb::flow::make_edge(*(nodename_tbbnode_map[arg->get_name()]),
-                                                         *(nodename_tbbnode_map[n->get_name()]));
-                                }
-                            }
-                            if (is_head)
-                            {
-                                tbb::flow::make_edge(*flowgraph_node_start,
-                                                     *(nodename_tbbnode_map[n->get_name()]));
-                            }
-                        }
-                    });
-
-                if (m_release_function)
-                {
-                    release_function();
-                }
-            }
-            // Execute the flow graph
-            (static_cast<
-                 tbb::flow::continue_node<tbb::flow::continue_msg, tbb::flow::lightweight>*>(
-                 &(*(ctx->G->begin()))))
-                ->try_put(tbb::flow::continue_msg());
-            try
-            {
-                ctx->G->wait_for_all();
-            }
-            catch (...)
-            {
-                throw;
-            }
+            execute_in_parallel(ctx, sample, count_events);
         }
         else
         {
-            for (const auto& p : enables)
+            size_t op_index = 0;
+            for (const auto& p : program.enables)
             {
                 if (p(ctx) || ctx->first_iteration)
                 {
@@ -1526,7 +1749,21 @@ void runtime::cpu::CPU_ExternalFunction::build()
                     {
                         start_ts = cpu::Clock::now();
                     }
+                    PerfEventCounts start_events;
+                    if (count_events)
+                    {
+                        start_events = PerfEventGroup::get_thread_group().read();
+                    }
+                    uint64_t start_ticks = sample ? OpProfiler::read_clock() : 0;
                     (*functor)(ctx);
+                    if (sample)
+                    {
+                        m_op_profiler->record(op_index, OpProfiler::read_clock() - start_ticks);
+                    }
+                    if (count_events)
+                    {
+                        record_events(ctx, op_index, sample, start_events);
+                    }
                     if (runtime::cpu::IsTracingEnabled())
                     {
                         ctx->op_durations[profiler_count++] =
@@ -1541,29 +1778,405 @@ void runtime::cpu::CPU_ExternalFunction::build()
                     {
                         ctx->op_durations[profiler_count++] = 0;
                     }
+                    if (ctx->op_events)
+                    {
+                        ctx->op_events[op_index] = PerfEventCounts();
+                        ctx->op_events[op_index].available =
+                            PerfEventGroup::get_thread_group().is_open();
+                    }
                 }
                 std::advance(functor, 1);
+                op_index++;
+            }
+
+            if (runtime::cpu::IsTracingEnabled())
+            {
+                assert(m_op_attrs.size() == profiler_count);
             }
         }
         ctx->first_iteration = false;
+    };
+
+    m_is_built = true;
+    if (m_release_function)
+    {
+        release_function();
+    }
+}
+
+unique_ptr<runtime::cpu::DEXProgram> runtime::cpu::CPU_ExternalFunction::make_dex_program()
+{
+    lock_guard<mutex> lock(m_build_mutex);
+    if (m_dex_program)
+    {
+        return move(m_dex_program);
+    }
+    return build_dex_program();
+}
+
+unique_ptr<runtime::cpu::DEXProgram> runtime::cpu::CPU_ExternalFunction::build_dex_program()
+{
+    unique_ptr<DEXProgram> program(new DEXProgram());
+    program->mkldnn_emitter.reset(new MKLDNNEmitter());
+    auto& tensor_data = program->tensor_data;
+    auto& tensor_stale = program->tensor_stale;
+    auto& ordered_ops = m_dex_ordered_ops;
+
+    // Intermediates
+    if (m_dex_has_temporaries)
+    {
+        for (auto& node : *ordered_ops)
+        {
+            for (auto tensor : node->liveness_new_list)
+            {
+                program->intermediates_offsets.emplace_back(tensor_data[tensor->get_name()],
+                                                            tensor->get_pool_offset());
+            }
+        }
+    }
+
+    // Constants
+    for (auto& node : *ordered_ops)
+    {
+        if (node->is_constant())
+        {
+            auto tv = node->get_outputs()[0].get_tensor_ptr();
+            tensor_data[tv->get_name()] =
+                const_cast<void*>(static_pointer_cast<ngraph::op::Constant>(node)->get_data_ptr());
+        }
+    }
+
+    // Inputs
+    size_t arg_index = 0;
+    for (auto& param : m_dex_parameters)
+    {
+        for (size_t i = 0; i < param->get_output_size(); ++i)
+        {
+            shared_ptr<descriptor::TensorView> tv = param->get_output_tensor_ptr(i);
+            program->function_input_index.emplace_back(
+                tensor_data[tv->get_name()], arg_index, tensor_stale[tv->get_name()]);
+            arg_index++;
+        }
+    }
+
+    // Outputs
+    for (size_t i = 0; i < m_dex_results.size(); ++i)
+    {
+        shared_ptr<Node> op = m_dex_results.at(i);
+        shared_ptr<descriptor::TensorView> tv = op->get_output_tensor_ptr();
+        program->function_output_index.emplace_back(tensor_data[tv->get_name()], i);
+
+        auto input_node = op->get_inputs().at(0).get_output().get_node();
+        if (!input_node->is_constant() && !input_node->is_parameter())
+        {
+            shared_ptr<descriptor::TensorView> itv =
+                op->get_inputs().at(0).get_output().get_tensor_ptr();
+            program->function_output_index.emplace_back(tensor_data[itv->get_name()], i);
+        }
+    }
+
+    m_building_program = program.get();
+    try
+    {
+        for (const shared_ptr<Node>& node : *ordered_ops)
+        {
+            if (node->is_parameter() || node->is_constant())
+            {
+                continue;
+            }
+            // Work around a compiler warning (*node inside typeid may have effects with shared
+            // pointers, which is fine here but clang doesn't like it.)
+            auto& n = *node;
+            auto handler = GetGlobalBuildDispatcher().find(type_index(typeid(n)));
+            if (handler == GetGlobalBuildDispatcher().end())
+            {
+                throw unsupported_op(node->description());
+            }
+            vector<TensorViewWrapper> in;
+            vector<string> in_names;
+            for (const descriptor::Input& input : node->get_inputs())
+            {
+                const descriptor::Output& output = input.get_output();
+                shared_ptr<descriptor::TensorView> tv = output.get_tensor_ptr();
+                in.push_back(TensorViewWrapper(tv, tv->get_name()));
+                in_names.push_back(tv->get_name());
+            }
+            vector<TensorViewWrapper> out;
+            vector<string> out_names;
 
-        if (runtime::cpu::IsTracingEnabled())
+            for (const descriptor::Output& output : node->get_outputs())
+            {
+                shared_ptr<descriptor::TensorView> tv = output.get_tensor_ptr();
+                out.push_back(TensorViewWrapper(tv, tv->get_name()));
+                out_names.push_back(tv->get_name());
+            }
+
+            handler->second(this, node.get(), in, out);
+
+            bool disable_caching = computes_result(node.get()) || possibly_overwritten(node.get());
+
+            vector<reference_wrapper<bool>> in_stale, out_stale;
+            for (const auto& name : in_names)
+            {
+                if (tensor_alias.count(name))
+                {
+                    in_stale.emplace_back(tensor_stale[tensor_alias[name]]);
+                }
+                else
+                {
+                    in_stale.emplace_back(tensor_stale[name]);
+                }
+            }
+            for (const auto& name : out_names)
+            {
+                out_stale.emplace_back(tensor_stale[name]);
+            }
+
+            function<bool(CPURuntimeContext*)> enable;
+            if (disable_caching)
+            {
+                enable = [in_stale, out_stale](CPURuntimeContext* ctx) -> bool {
+                    for (auto& stale : out_stale)
+                    {
+                        stale.get() = true;
+                    }
+                    return true;
+                };
+            }
+            else
+            {
+                enable = [in_stale, out_stale](CPURuntimeContext* ctx) -> bool {
+                    bool en = false;
+                    for (const auto& stale : in_stale)
+                    {
+                        if (stale)
+                        {
+                            en = true;
+                            break;
+                        }
+                    }
+                    for (auto& stale : out_stale)
+                    {
+                        stale.get() = en;
+                    }
+                    return en;
+                };
+            }
+
+            program->enables.emplace_back(enable);
+        }
+    }
+    catch (...)
+    {
+        m_building_program = nullptr;
+        throw;
+    }
+    m_building_program = nullptr;
+
+    for (auto& functor : program->functors)
+    {
+        program->op_functors.push_back(&functor);
+    }
+    for (auto& enable : program->enables)
+    {
+        program->op_enables.push_back(&enable);
+    }
+    return program;
+}
+
+void runtime::cpu::CPU_ExternalFunction::record_events(CPURuntimeContext* ctx,
+                                                       size_t op,
+                                                       bool sample,
+                                                       const PerfEventCounts& start_events)
+{
+    // Counters are per thread, so this has to run on the thread that ran the op
+    PerfEventCounts counts = PerfEventGroup::get_thread_group().read() - start_events;
+    if (sample)
+    {
+        m_op_profiler->record_events(op, counts);
+    }
+    if (ctx->op_events)
+    {
+        ctx->op_events[op] = counts;
+    }
+}
+
+// Functors of all parallel calls in the process that are running on the kernel pool
+static atomic<size_t> s_pool_functors{0};
+
+// Claim a pool worker for a functor. A functor blocks its worker while it waits for its own
+// Eigen tasks, so the functors of every call together must leave one worker free of them for
+// those tasks to make progress.
+static bool reserve_pool_functor(const Eigen::ThreadPool& pool)
+{
+    size_t limit = pool.NumThreads() - 1;
+    size_t running = s_pool_functors;
+    while (running < limit)
+    {
+        if (s_pool_functors.compare_exchange_weak(running, running + 1))
         {
-            assert(m_op_attrs.size() == profiler_count);
+            return true;
         }
+    }
+    return false;
+}
 
+void runtime::cpu::CPU_ExternalFunction::execute_in_parallel(CPURuntimeContext* ctx,
+                                                             bool sample,
+                                                             bool count_events)
+{
+    // Ops are scheduled on the same work-stealing pool that runs the Eigen kernels, so inter-op
+    // and intra-op parallelism never add up to more threads than the pool has. When the pool
+    // has no worker to spare, the calling thread runs the next ready op itself.
+    Eigen::ThreadPool& pool = eigen::global_thread_pool;
+
+    DEXProgram& program = *ctx->dex_program;
+    size_t op_count = program.op_functors.size();
+    vector<size_t> pending(m_op_predecessor_counts);
+    deque<size_t> ready;
+    for (size_t i = 0; i < op_count; i++)
+    {
+        if (pending[i] == 0)
+        {
+            ready.push_back(i);
+        }
+    }
+
+    mutex state_mutex;
+    condition_variable state_changed;
+    size_t running = 0;
+    size_t completed = 0;
+    exception_ptr error;
+    // Functors executing right now, as opposed to scheduled ones still queued in the pool
+    atomic<size_t> active{0};
+
+    auto run_op = [this, &program, ctx, sample, count_events](size_t i) {
+        if ((*program.op_enables[i])(ctx) || ctx->first_iteration)
+        {
+            cpu::Timestamp start_ts;
+            if (runtime::cpu::IsTracingEnabled())
+            {
+                start_ts = cpu::Clock::now();
+            }
+            PerfEventCounts start_events;
+            if (count_events)
+            {
+                start_events = PerfEventGroup::get_thread_group().read();
+            }
+            uint64_t start_ticks = sample ? OpProfiler::read_clock() : 0;
+            (*program.op_functors[i])(ctx);
+            if (sample)
+            {
+                m_op_profiler->record(i, OpProfiler::read_clock() - start_ticks);
+            }
+            if (count_events)
+            {
+                record_events(ctx, i, sample, start_events);
+            }
+            if (runtime::cpu::IsTracingEnabled())
+            {
+                ctx->op_durations[i] =
+                    (std::chrono::duration_cast<cpu::Timescale>(cpu::Clock::now() - start_ts))
+                        .count();
+            }
+        }
+        else
+        {
+            if (runtime::cpu::IsTracingEnabled())
+            {
+                ctx->op_durations[i] = 0;
+            }
+            if (ctx->op_events)
+            {
+                ctx->op_events[i] = PerfEventCounts();
+                ctx->op_events[i].available = PerfEventGroup::get_thread_group().is_open();
+            }
+        }
     };
 
-    m_is_built = true;
+    // Runs op i without state_mutex held
+    auto execute_op = [&](size_t i) {
+        size_t now_active = ++active;
+        size_t max_active = m_max_parallel_ops;
+        while (now_active > max_active &&
+               !m_max_parallel_ops.compare_exchange_weak(max_active, now_active))
+        {
+        }
+        exception_ptr op_error;
+        try
+        {
+            run_op(i);
+        }
+        catch (...)
+        {
+            op_error = current_exception();
+        }
+        active--;
+        return op_error;
+    };
+    // Records that op i is done; state_mutex must be held
+    auto complete_op = [&](size_t i, exception_ptr op_error) {
+        running--;
+        completed++;
+        if (op_error && !error)
+        {
+            error = op_error;
+        }
+        for (size_t successor : m_op_successors[i])
+        {
+            if (--pending[successor] == 0)
+            {
+                ready.push_back(successor);
+            }
+        }
+    };
 
-    if (m_release_function && !m_use_tbb)
+    unique_lock<mutex> lock(state_mutex);
+    while (completed < op_count)
     {
-        release_function();
+        while (!ready.empty() && !error && reserve_pool_functor(pool))
+        {
+            size_t i = ready.front();
+            ready.pop_front();
+            running++;
+            pool.Schedule([&, i]() {
+                exception_ptr op_error = execute_op(i);
+                s_pool_functors--;
+                // Notify while holding the lock; the waiting thread owns everything captured
+                lock_guard<mutex> op_lock(state_mutex);
+                complete_op(i, op_error);
+                state_changed.notify_one();
+            });
+        }
+        if (!ready.empty() && !error)
+        {
+            size_t i = ready.front();
+            ready.pop_front();
+            running++;
+            lock.unlock();
+            exception_ptr op_error = execute_op(i);
+            lock.lock();
+            complete_op(i, op_error);
+            continue;
+        }
+        if (error && running == 0)
+        {
+            rethrow_exception(error);
+        }
+        if (completed < op_count)
+        {
+            state_changed.wait(lock);
+        }
+    }
+    if (error)
+    {
+        rethrow_exception(error);
     }
 }
 
 void*& runtime::cpu::CPU_ExternalFunction::get_tensor_data(const std::string& name)
 {
+    auto& tensor_data = m_building_program->tensor_data;
     if (tensor_alias.count(name))
     {
         return tensor_data[tensor_alias[name]];
@@ -1574,6 +2187,11 @@ void*& runtime::cpu::CPU_ExternalFunction::get_tensor_data(const std::string& na
     }
 }
 
+bool runtime::cpu::CPU_ExternalFunction::is_reentrant() const
+{
+    return m_direct_execution || m_mkldnn_emitter->get_mkldnn_primitives().empty();
+}
+
 shared_ptr<ngraph::runtime::cpu::CPU_CallFrame>
     runtime::cpu::CPU_ExternalFunction::make_call_frame()
 {
@@ -1617,8 +2235,6 @@ void runtime::cpu::CPU_ExternalFunction::write_to_file(const std::string& code,
     out.close();
 }
 
-#if !defined(NGRAPH_DEX_ONLY)
-
 void runtime::cpu::CPU_ExternalFunction::emit_debug_function_entry(
     codegen::CodeWriter& writer,
     Node* node,
@@ -1751,5 +2367,3 @@ string runtime::cpu::CPU_ExternalFunction::strip_comments(const string& s)
     }
     return out.str();
 }
-
-#endif
@@ -16,10 +16,12 @@
 
 #pragma once
 
+#include <atomic>
 #include <functional>
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <typeindex>
 #include <typeinfo>
@@ -27,9 +29,10 @@
 #include <utility>
 #include <vector>
 
+#include "ngraph/codegen/code_writer.hpp"
+
 #if !defined(NGRAPH_DEX_ONLY)
 
-#include "ngraph/codegen/code_writer.hpp"
 #include "ngraph/codegen/compiler.hpp"
 #include "ngraph/codegen/execution_engine.hpp"
 
@@ -39,6 +42,7 @@
 #include "ngraph/pass/manager.hpp"
 #include "ngraph/runtime/cpu/cpu_call_frame.hpp"
 #include "ngraph/runtime/cpu/cpu_layout_descriptor.hpp"
+#include "ngraph/runtime/cpu/cpu_op_profiler.hpp"
 #include "ngraph/runtime/cpu/cpu_tensor_view_wrapper.hpp"
 #include "ngraph/runtime/cpu/mkldnn_emitter.hpp"
 
@@ -52,8 +56,6 @@ namespace ngraph
             class CPU_Emitter;
             class CPU_CallFrame;
 
-#if !defined(NGRAPH_DEX_ONLY)
-
             using OpFunction = std::function<void(CPU_ExternalFunction* external_function,
                                                   codegen::CodeWriter&,
                                                   const ngraph::Node*,
@@ -61,7 +63,6 @@ namespace ngraph
                                                   const std::vector<TensorViewWrapper>& outputs)>;
 
             using OpMap = std::unordered_map<std::type_index, OpFunction>;
-#endif
 
             struct OpAttributes
             {
@@ -78,6 +79,26 @@ namespace ngraph
                 }
             };
 
+            // The functors of a DEX function together with the tensor pointer table and the
+            // MKLDNN primitives they use. Each runtime context runs its own program, so calls
+            // in different contexts never share tensor pointers or MKLDNN data handles.
+            struct DEXProgram
+            {
+                std::unique_ptr<MKLDNNEmitter> mkldnn_emitter;
+                std::list<std::function<void(CPURuntimeContext*)>> functors;
+                std::list<std::function<bool(CPURuntimeContext*)>> enables;
+                std::unordered_map<std::string, void*> tensor_data;
+                std::unordered_map<std::string, bool> tensor_stale;
+                std::list<std::pair<std::reference_wrapper<void*>, size_t>> intermediates_offsets;
+                std::list<
+                    std::tuple<std::reference_wrapper<void*>, size_t, std::reference_wrapper<bool>>>
+                    function_input_index;
+                std::list<std::pair<std::reference_wrapper<void*>, size_t>> function_output_index;
+                // Functors and enables indexed in execution order
+                std::vector<std::function<void(CPURuntimeContext*)>*> op_functors;
+                std::vector<std::function<bool(CPURuntimeContext*)>*> op_enables;
+            };
+
             class CPU_ExternalFunction : public std::enable_shared_from_this<CPU_ExternalFunction>
             {
                 friend class CPU_Backend;
@@ -102,10 +123,17 @@ namespace ngraph
                 {
                     return m_memory_buffer_sizes;
                 }
+                // Number of tensor enable flags used by each generated function
+                const std::vector<size_t>& get_tensor_enable_sizes() const
+                {
+                    return m_tensor_enable_sizes;
+                }
                 const std::vector<OpAttributes>& get_op_attrs() const { return m_op_attrs; }
+                // The emitter of the DEX program being built, or the codegen emitter
                 const std::unique_ptr<MKLDNNEmitter>& get_mkldnn_emitter() const
                 {
-                    return m_mkldnn_emitter;
+                    return m_building_program ? m_building_program->mkldnn_emitter
+                                              : m_mkldnn_emitter;
                 }
 
                 const std::string& get_function_name() const { return m_function_name; }
@@ -113,12 +141,20 @@ namespace ngraph
                 // Temporary Memory Pool alignment
                 static constexpr size_t s_memory_pool_alignment = 4096;
 
+                // Builders add their functors and look up tensors in the DEX program that is
+                // being built
                 std::list<std::function<void(CPURuntimeContext*)>>& get_functors()
                 {
-                    return functors;
+                    return m_building_program->functors;
+                }
+                std::unordered_map<std::string, void*>& get_tensor_data()
+                {
+                    return m_building_program->tensor_data;
                 }
-                std::unordered_map<std::string, void*>& get_tensor_data() { return tensor_data; }
                 void*& get_tensor_data(const std::string& name);
+                const ResultVector& get_dex_results() const { return m_dex_results; }
+                // Build the functors of a DEX function for one more runtime context
+                std::unique_ptr<DEXProgram> make_dex_program();
                 std::function<void(CPURuntimeContext*, std::vector<void*>&, std::vector<void*>&)>&
                     get_executor()
                 {
@@ -130,18 +166,64 @@ namespace ngraph
                     return callees;
                 }
                 bool is_direct_execution() const { return m_direct_execution; }
+                // True if each call borrows its scratch pools from the process-wide memory
+                // arena instead of keeping them in the runtime context between calls
+                bool borrows_scratch_memory() const { return m_borrow_scratch; }
+                // Run independent DEX functors concurrently on the shared kernel thread pool.
+                // Takes effect on the next call; codegen functions ignore it.
+                void set_parallel_execution(bool enable) { m_parallel_execution = enable; }
+                // The most functors that have run at the same time under parallel execution
+                size_t get_max_parallel_ops() const { return m_max_parallel_ops; }
+                // Time one DEX call in every interval calls, op by op; 0 disables sampling.
+                // Takes effect when the function is built; codegen functions ignore it.
+                void set_profiling_interval(size_t interval) { m_profiling_interval = interval; }
+                // The sampled op times, or nullptr if sampling is disabled
+                const OpProfiler* get_op_profiler() const { return m_op_profiler.get(); }
+                // True if several runtime contexts may execute this function concurrently.
+                // Generated code shares its MKLDNN primitives, which carry the data handles,
+                // between contexts; DEX functions give every context its own.
+                bool is_reentrant() const;
+                std::mutex& get_execution_mutex() { return m_execution_mutex; }
                 void write_to_file(const std::string& code,
                                    const std::string& directory,
                                    const std::string& filename);
 
+                /// \brief Run the codegen pipeline and return self-contained C++ source for a
+                ///     shared library instead of JIT compiling it. The library embeds the
+                ///     constant data and exports a plain C interface: ngraph_create_context,
+                ///     ngraph_call, ngraph_destroy_context, ngraph_get_input_count and
+                ///     ngraph_get_output_count. Ops run on the codegen and reference kernels
+                ///     rather than MKLDNN, whose primitives cannot be emitted as source.
+                ///     Functions with ops that only have MKLDNN kernels, such as quantized
+                ///     ops, or with non-default parameter/result layouts are rejected.
+                std::string emit_standalone_source();
+
+#if !defined(NGRAPH_DEX_ONLY)
+
+                // The translation units the generated code was split into for compilation
+                size_t get_code_partition_count() const { return m_code_partitions.size() + 1; }
+                // The threads that compiled those translation units; 0 until compiled
+                size_t get_compile_thread_count() const
+                {
+                    return m_compiler ? m_compiler->get_compile_thread_count() : 0;
+                }
+
+#endif
+
             protected:
                 void build();
+                // Run the builders into a new program; m_build_mutex must be held
+                std::unique_ptr<DEXProgram> build_dex_program();
 
 #if !defined(NGRAPH_DEX_ONLY)
 
                 void compile();
 
 #endif
+                // Run the passes and emit the generated source for the function
+                std::string emit_code();
+                // Record the layouts assigned to parameters and results
+                void store_layouts();
 
             private:
                 // Register passes that are common to codegen and DEX
@@ -159,7 +241,6 @@ namespace ngraph
                                                bool dex);
                 bool computes_result(Node* node);
 
-#if !defined(NGRAPH_DEX_ONLY)
                 void emit_debug_function_entry(codegen::CodeWriter& writer,
                                                Node* node,
                                                const std::vector<TensorViewWrapper>& in,
@@ -180,12 +261,20 @@ namespace ngraph
                 std::string emit_op_as_function(const Node&, const std::string& function_name);
                 std::string strip_comments(const std::string&);
 
-#endif
+                void execute_in_parallel(CPURuntimeContext* ctx, bool sample, bool count_events);
+                // Reads the hardware counters of the calling thread after op ran and stores
+                // their increase since start_events
+                void record_events(CPURuntimeContext* ctx,
+                                   size_t op,
+                                   bool sample,
+                                   const PerfEventCounts& start_events);
                 void release_function() { m_function = nullptr; }
                 std::shared_ptr<ngraph::Function> m_function;
                 bool m_release_function;
 
                 bool m_use_tbb;
+                std::atomic<bool> m_parallel_execution;
+                std::atomic<size_t> m_max_parallel_ops;
 
                 EntryPoint m_compiled_function;
                 std::unordered_map<std::string, std::string> m_variable_name_map;
@@ -195,7 +284,13 @@ namespace ngraph
                 bool m_is_compiled;
                 std::unique_ptr<codegen::Compiler> m_compiler;
                 std::unique_ptr<codegen::ExecutionEngine> m_execution_engine;
+
+#endif
                 bool m_emit_timing;
+                bool m_emit_standalone;
+                std::string m_pch_header_source;
+                // Extra translation units of a function split for parallel compilation
+                std::vector<std::string> m_code_partitions;
 
                 std::map<std::string, size_t> m_name_index_map;
 
@@ -204,35 +299,40 @@ namespace ngraph
                 // so they don't get freed before we are done with them
                 std::vector<std::shared_ptr<Node>> m_active_constants;
 
-#endif
                 std::unordered_map<std::string, CPUTensorRole> m_tensor_roles;
 
                 LayoutDescriptorPtrs parameter_layout_descriptors;
                 LayoutDescriptorPtrs result_layout_descriptors;
                 std::vector<size_t> m_memory_buffer_sizes;
+                std::vector<size_t> m_tensor_enable_sizes;
                 std::vector<OpAttributes> m_op_attrs;
 
                 std::unique_ptr<MKLDNNEmitter> m_mkldnn_emitter;
 
                 std::string m_function_name;
 
-                std::list<std::function<void(CPURuntimeContext*)>> functors;
-                std::list<std::function<bool(CPURuntimeContext*)>> enables;
-                std::list<std::pair<std::function<bool(CPURuntimeContext*)>, std::string>>
-                    enable_nodename_list;
                 std::function<void(CPURuntimeContext*, std::vector<void*>&, std::vector<void*>&)>
                     executor;
-                std::unordered_map<std::string, void*> tensor_data;
-                std::unordered_map<std::string, bool> tensor_stale;
                 std::unordered_map<std::string, std::string> tensor_alias;
-                std::list<std::pair<std::reference_wrapper<void*>, size_t>> intermediates_offsets;
-                std::list<
-                    std::tuple<std::reference_wrapper<void*>, size_t, std::reference_wrapper<bool>>>
-                    function_input_index;
-                std::list<std::pair<std::reference_wrapper<void*>, size_t>> function_output_index;
+                // The program built with the function, handed to the first runtime context
+                std::unique_ptr<DEXProgram> m_dex_program;
+                DEXProgram* m_building_program;
+                std::mutex m_build_mutex;
+                // What build_dex_program reads from the function, kept after it is released
+                std::shared_ptr<const std::list<std::shared_ptr<Node>>> m_dex_ordered_ops;
+                op::ParameterVector m_dex_parameters;
+                ResultVector m_dex_results;
+                bool m_dex_has_temporaries;
+                // Dependencies between functors, indexed in execution order
+                std::vector<std::vector<size_t>> m_op_successors;
+                std::vector<size_t> m_op_predecessor_counts;
                 std::unordered_map<std::string, std::shared_ptr<CPU_ExternalFunction>> callees;
+                size_t m_profiling_interval;
+                std::unique_ptr<OpProfiler> m_op_profiler;
                 bool m_is_built;
                 bool m_direct_execution;
+                bool m_borrow_scratch;
+                std::mutex m_execution_mutex;
             };
         }
     }
@@ -127,6 +127,8 @@ namespace ngraph
     class Shape;
     class AxisSet;
     class AxisVector;
+    class bfloat16;
+    class float16;
 
     namespace runtime
     {
@@ -142,6 +144,33 @@ namespace ngraph
                                     const Shape& padding_below,
                                     const Shape& padding_above);
 
+                // Vectorized conversions between float and 16-bit floats; they round to
+                // nearest even exactly like the scalar conversions of bfloat16 and float16
+                void convert_f32_to_bf16(const float* input, bfloat16* output, size_t count);
+                void convert_bf16_to_f32(const bfloat16* input, float* output, size_t count);
+                void convert_f32_to_f16(const float* input, float16* output, size_t count);
+                void convert_f16_to_f32(const float16* input, float* output, size_t count);
+
+                void quantized_dot(const uint8_t* data,
+                                   const int8_t* weights,
+                                   const float* bias,
+                                   int8_t* output,
+                                   size_t rows,
+                                   size_t inner,
+                                   size_t columns,
+                                   float dequantize_scale,
+                                   float requantize_scale);
+
+                void quantized_dot(const uint8_t* data,
+                                   const int8_t* weights,
+                                   const float* bias,
+                                   uint8_t* output,
+                                   size_t rows,
+                                   size_t inner,
+                                   size_t columns,
+                                   float dequantize_scale,
+                                   float requantize_scale);
+
                 void reduce_sum_all_1d_float32(float* input,
                                                float* output,
                                                const Shape& input_shape,
@@ -0,0 +1,163 @@
+//*****************************************************************************
+// Copyright 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include "ngraph/runtime/cpu/cpu_op_profiler.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+runtime::cpu::OpProfiler::OpProfiler(const vector<string>& op_names, size_t interval)
+    : m_op_names(op_names)
+    , m_histograms(new Histogram[op_names.size()])
+    , m_interval(max(interval, size_t(1)))
+    , m_call_count(0)
+    , m_start_ticks(read_clock())
+    , m_start_time(chrono::steady_clock::now())
+{
+    for (size_t op = 0; op < op_names.size(); op++)
+    {
+        Histogram& histogram = m_histograms[op];
+        for (size_t bucket = 0; bucket < s_bucket_count; bucket++)
+        {
+            histogram.m_buckets[bucket] = 0;
+        }
+        histogram.m_count = 0;
+        histogram.m_total = 0;
+        histogram.m_max = 0;
+        histogram.m_cycles = 0;
+        histogram.m_instructions = 0;
+        histogram.m_llc_misses = 0;
+        histogram.m_flops = 0;
+    }
+}
+
+size_t runtime::cpu::OpProfiler::get_default_interval()
+{
+    static const char* interval = getenv("NGRAPH_CPU_PROFILE_INTERVAL");
+    return interval ? strtoul(interval, nullptr, 10) : 0;
+}
+
+size_t runtime::cpu::OpProfiler::get_bucket(uint64_t ticks)
+{
+    const uint64_t sub_bucket_count = 1 << s_sub_bucket_bits;
+    if (ticks < sub_bucket_count)
+    {
+        return ticks;
+    }
+
+    size_t msb = 0;
+    while ((ticks >> msb) > 1)
+    {
+        msb++;
+    }
+    if (msb >= s_max_bits)
+    {
+        return s_bucket_count - 1;
+    }
+
+    size_t shift = msb - s_sub_bucket_bits;
+    return ((shift + 1) << s_sub_bucket_bits) + ((ticks >> shift) & (sub_bucket_count - 1));
+}
+
+uint64_t runtime::cpu::OpProfiler::get_bucket_midpoint(size_t bucket)
+{
+    const uint64_t sub_bucket_count = 1 << s_sub_bucket_bits;
+    if (bucket < sub_bucket_count)
+    {
+        return bucket;
+    }
+
+    size_t shift = (bucket >> s_sub_bucket_bits) - 1;
+    uint64_t lower = (sub_bucket_count + (bucket & (sub_bucket_count - 1))) << shift;
+    return lower + ((uint64_t(1) << shift) >> 1);
+}
+
+void runtime::cpu::OpProfiler::record(size_t op, uint64_t ticks)
+{
+    Histogram& histogram = m_histograms[op];
+    histogram.m_buckets[get_bucket(ticks)].fetch_add(1, memory_order_relaxed);
+    histogram.m_count.fetch_add(1, memory_order_relaxed);
+    histogram.m_total.fetch_add(ticks, memory_order_relaxed);
+
+    uint64_t current_max = histogram.m_max.load(memory_order_relaxed);
+    while (ticks > current_max &&
+           !histogram.m_max.compare_exchange_weak(current_max, ticks, memory_order_relaxed))
+    {
+    }
+}
+
+void runtime::cpu::OpProfiler::record_events(size_t op, const PerfEventCounts& counts)
+{
+    Histogram& histogram = m_histograms[op];
+    histogram.m_cycles.fetch_add(counts.cycles, memory_order_relaxed);
+    histogram.m_instructions.fetch_add(counts.instructions, memory_order_relaxed);
+    histogram.m_llc_misses.fetch_add(counts.llc_misses, memory_order_relaxed);
+    histogram.m_flops.fetch_add(counts.flops, memory_order_relaxed);
+}
+
+uint64_t runtime::cpu::OpProfiler::get_percentile(const Histogram& histogram,
+                                                  uint64_t count,
+                                                  double fraction) const
+{
+    uint64_t rank = max(uint64_t(1), static_cast<uint64_t>(ceil(fraction * count)));
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < s_bucket_count; bucket++)
+    {
+        seen += histogram.m_buckets[bucket].load(memory_order_relaxed);
+        if (seen >= rank)
+        {
+            return min(get_bucket_midpoint(bucket), histogram.m_max.load(memory_order_relaxed));
+        }
+    }
+    return histogram.m_max.load(memory_order_relaxed);
+}
+
+vector<runtime::PerformanceCounter> runtime::cpu::OpProfiler::get_performance_data() const
+{
+    // Calibrate the ticks against the wall time elapsed since construction
+    uint64_t elapsed_ticks = read_clock() - m_start_ticks;
+    double elapsed_us =
+        chrono::duration<double, micro>(chrono::steady_clock::now() - m_start_time).count();
+    double us_per_tick = elapsed_ticks > 0 ? elapsed_us / elapsed_ticks : 0;
+
+    vector<PerformanceCounter> rc;
+    for (size_t op = 0; op < m_op_names.size(); op++)
+    {
+        const Histogram& histogram = m_histograms[op];
+        uint64_t count = histogram.m_count.load(memory_order_relaxed);
+        if (count == 0)
+        {
+            continue;
+        }
+        rc.emplace_back(
+            m_op_names[op].c_str(),
+            static_cast<size_t>(histogram.m_total.load(memory_order_relaxed) * us_per_tick),
+            count,
+            get_percentile(histogram, count, 0.5) * us_per_tick,
+            get_percentile(histogram, count, 0.99) * us_per_tick,
+            histogram.m_max.load(memory_order_relaxed) * us_per_tick);
+        rc.back().set_hardware_counts(histogram.m_cycles.load(memory_order_relaxed),
+                                      histogram.m_instructions.load(memory_order_relaxed),
+                                      histogram.m_llc_misses.load(memory_order_relaxed),
+                                      histogram.m_flops.load(memory_order_relaxed),
+                                      PerfEventGroup::s_cache_line_size);
+    }
+    return rc;
+}
@@ -0,0 +1,127 @@
+//*****************************************************************************
+// Copyright 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "ngraph/runtime/cpu/cpu_perf_events.hpp"
+#include "ngraph/runtime/performance_counter.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            /// \brief Samples the execution times of the ops of a DEX function.
+            ///
+            /// One call in every interval calls is timed op by op with the CPU timestamp
+            /// counter. The times are added to per-op histograms with relaxed atomic updates, so
+            /// runtime contexts calling the function concurrently record without locking and
+            /// untimed calls only pay for one atomic increment.
+            class OpProfiler
+            {
+            public:
+                /// \param op_names The names of the ops, in the order of their functors
+                /// \param interval Time one call in every interval calls
+                OpProfiler(const std::vector<std::string>& op_names, size_t interval);
+
+                /// \brief The sampling interval set by NGRAPH_CPU_PROFILE_INTERVAL, or 0 if
+                ///        sampling is not requested
+                static size_t get_default_interval();
+
+                /// \brief Counts a call of the function and returns true if it is to be timed
+                bool sample_call()
+                {
+                    return m_call_count.fetch_add(1, std::memory_order_relaxed) % m_interval == 0;
+                }
+
+                /// \brief Reads the timestamp counter, or a nanosecond clock on processors
+                ///        without one
+                static uint64_t read_clock()
+                {
+#if defined(__x86_64__) || defined(__i386__)
+                    return __rdtsc();
+#else
+                    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                               std::chrono::steady_clock::now().time_since_epoch())
+                        .count();
+#endif
+                }
+
+                /// \brief Adds one execution of op, which took ticks clock ticks
+                void record(size_t op, uint64_t ticks);
+
+                /// \brief Adds the hardware event counts of one execution of op
+                void record_events(size_t op, const PerfEventCounts& counts);
+
+                size_t get_interval() const { return m_interval; }
+                /// \brief Returns a counter with the total time, the sample count and the p50,
+                ///        p99 and maximum times for every op that was timed at least once, and
+                ///        the hardware event counts of the op if they were recorded
+                std::vector<PerformanceCounter> get_performance_data() const;
+
+            private:
+                // Times below 8 ticks have a bucket each. Above that, every power of two is
+                // split into 8 buckets, which bounds the error of a percentile to 1/16 of its
+                // value. Times of 2^48 ticks and more share the last bucket.
+                static const size_t s_sub_bucket_bits = 3;
+                static const size_t s_max_bits = 48;
+                static const size_t s_bucket_count =
+                    (s_max_bits - s_sub_bucket_bits + 1) << s_sub_bucket_bits;
+
+                static size_t get_bucket(uint64_t ticks);
+                static uint64_t get_bucket_midpoint(size_t bucket);
+
+                struct Histogram
+                {
+                    std::atomic<uint64_t> m_buckets[s_bucket_count];
+                    std::atomic<uint64_t> m_count;
+                    std::atomic<uint64_t> m_total;
+                    std::atomic<uint64_t> m_max;
+                    std::atomic<uint64_t> m_cycles;
+                    std::atomic<uint64_t> m_instructions;
+                    std::atomic<uint64_t> m_llc_misses;
+                    std::atomic<uint64_t> m_flops;
+                };
+
+                uint64_t get_percentile(const Histogram& histogram,
+                                        uint64_t count,
+                                        double fraction) const;
+
+                std::vector<std::string> m_op_names;
+                std::unique_ptr<Histogram[]> m_histograms;
+                size_t m_interval;
+                std::atomic<uint64_t> m_call_count;
+
+                // The clocks at construction, which calibrate ticks against wall time when the
+                // data is read
+                uint64_t m_start_ticks;
+                std::chrono::steady_clock::time_point m_start_time;
+            };
+        }
+    }
+}
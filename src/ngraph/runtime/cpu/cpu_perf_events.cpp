@@ -0,0 +1,155 @@
+//*****************************************************************************
+// Copyright 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "ngraph/runtime/cpu/cpu_perf_events.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+runtime::cpu::PerfEventCounts& runtime::cpu::PerfEventCounts::
+    operator+=(const PerfEventCounts& other)
+{
+    cycles += other.cycles;
+    instructions += other.instructions;
+    llc_misses += other.llc_misses;
+    flops += other.flops;
+    available = available || other.available;
+    return *this;
+}
+
+runtime::cpu::PerfEventCounts runtime::cpu::PerfEventCounts::
+    operator-(const PerfEventCounts& other) const
+{
+    PerfEventCounts rc;
+    rc.cycles = cycles - other.cycles;
+    rc.instructions = instructions - other.instructions;
+    rc.llc_misses = llc_misses - other.llc_misses;
+    rc.flops = flops - other.flops;
+    rc.available = available && other.available;
+    return rc;
+}
+
+bool runtime::cpu::PerfEventGroup::is_enabled()
+{
+    static bool enabled = (getenv("NGRAPH_CPU_PERF_EVENTS") != nullptr);
+    return enabled;
+}
+
+runtime::cpu::PerfEventGroup& runtime::cpu::PerfEventGroup::get_thread_group()
+{
+    thread_local PerfEventGroup group;
+    return group;
+}
+
+runtime::cpu::PerfEventGroup::PerfEventGroup()
+    : m_leader(-1)
+    , m_event_count(0)
+{
+#if defined(__linux__)
+    open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, &PerfEventCounts::cycles);
+    open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, &PerfEventCounts::instructions);
+    open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, &PerfEventCounts::llc_misses);
+    if (const char* flops_event = getenv("NGRAPH_CPU_PERF_FLOPS_EVENT"))
+    {
+        open_event(PERF_TYPE_RAW, strtoull(flops_event, nullptr, 16), &PerfEventCounts::flops);
+    }
+    if (m_leader != -1)
+    {
+        ioctl(m_leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(m_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+}
+
+runtime::cpu::PerfEventGroup::~PerfEventGroup()
+{
+#if defined(__linux__)
+    for (size_t i = 0; i < m_event_count; i++)
+    {
+        close(m_fds[i]);
+    }
+#endif
+}
+
+void runtime::cpu::PerfEventGroup::open_event(uint32_t type,
+                                              uint64_t config,
+                                              uint64_t PerfEventCounts::*count)
+{
+#if defined(__linux__)
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.read_format = PERF_FORMAT_GROUP;
+    // Only the leader starts disabled; members follow it. User space counts are all that
+    // unprivileged processes may read under the default perf_event_paranoid setting.
+    attr.disabled = m_leader == -1 ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    int fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, m_leader, 0));
+    if (fd == -1)
+    {
+        return;
+    }
+    if (m_leader == -1)
+    {
+        m_leader = fd;
+    }
+    m_fds[m_event_count] = fd;
+    m_counts[m_event_count] = count;
+    m_event_count++;
+#endif
+}
+
+runtime::cpu::PerfEventCounts runtime::cpu::PerfEventGroup::read() const
+{
+    PerfEventCounts rc;
+#if defined(__linux__)
+    if (m_leader == -1)
+    {
+        return rc;
+    }
+
+    // With PERF_FORMAT_GROUP the leader returns the number of events followed by the value of
+    // each, in the order they were opened
+    uint64_t values[s_max_events + 1];
+    ssize_t size = ::read(m_leader, values, sizeof(values));
+    if (size < static_cast<ssize_t>(sizeof(uint64_t)))
+    {
+        return rc;
+    }
+    size_t count = min(static_cast<size_t>(values[0]), m_event_count);
+    for (size_t i = 0; i < count; i++)
+    {
+        rc.*m_counts[i] = values[i + 1];
+    }
+    rc.available = true;
+#endif
+    return rc;
+}
@@ -0,0 +1,97 @@
+//*****************************************************************************
+// Copyright 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            /// \brief Hardware event counts of one or more op executions
+            struct PerfEventCounts
+            {
+                uint64_t cycles = 0;
+                uint64_t instructions = 0;
+                uint64_t llc_misses = 0;
+                uint64_t flops = 0;
+                /// False if no counter could be opened, in which case the counts are all 0
+                bool available = false;
+
+                PerfEventCounts& operator+=(const PerfEventCounts& other);
+                PerfEventCounts operator-(const PerfEventCounts& other) const;
+            };
+
+            /// \brief The hardware counters of the calling thread, read through Linux
+            ///        perf_event_open.
+            ///
+            /// Set NGRAPH_CPU_PERF_EVENTS to count the cycles, instructions and last level cache
+            /// misses of every op timed by the CPU backend. There is no portable event for
+            /// floating point operations, so FLOPs are only counted if
+            /// NGRAPH_CPU_PERF_FLOPS_EVENT holds the raw config (in hex, e.g. 0x5302c7) of an
+            /// event that counts them on the processor at hand.
+            ///
+            /// Counters only see the thread they were opened on. Work that a kernel hands to the
+            /// intra-op thread pool is not counted; run with one intra-op thread for complete
+            /// counts. Counting the pool threads would need per CPU counters, which unprivileged
+            /// processes may not open, so traces state the scope next to the counts instead.
+            /// Events the kernel or processor does not provide read as 0; if none can be opened
+            /// the counts are marked unavailable.
+            class PerfEventGroup
+            {
+            public:
+                /// \brief The size of the transfers between the last level cache and memory,
+                ///        which converts LLC misses to bytes
+                static const uint64_t s_cache_line_size = 64;
+
+                /// \brief True if NGRAPH_CPU_PERF_EVENTS is set
+                static bool is_enabled();
+
+                /// \brief The counters of the calling thread, opened on first use
+                static PerfEventGroup& get_thread_group();
+
+                ~PerfEventGroup();
+
+                /// \brief The counts accumulated by this thread since the group was opened
+                PerfEventCounts read() const;
+
+                /// \brief True if at least one counter could be opened on this thread
+                bool is_open() const { return m_leader != -1; }
+
+            private:
+                PerfEventGroup();
+                PerfEventGroup(const PerfEventGroup&) = delete;
+                PerfEventGroup& operator=(const PerfEventGroup&) = delete;
+
+                void open_event(uint32_t type, uint64_t config, uint64_t PerfEventCounts::*count);
+
+                static const size_t s_max_events = 4;
+
+                // The file descriptor of the group leader; -1 if no event could be opened
+                int m_leader;
+                int m_fds[s_max_events];
+                // The field of PerfEventCounts each opened event is read into, in the order
+                // of the values the group leader returns
+                uint64_t PerfEventCounts::*m_counts[s_max_events];
+                size_t m_event_count;
+            };
+        }
+    }
+}
@@ -47,18 +47,27 @@ namespace ngraph
             typedef std::chrono::time_point<Clock> Timestamp;
             typedef std::chrono::microseconds Timescale;
 
+            struct PerfEventCounts;
+            struct DEXProgram;
+
             extern "C" {
             struct CPURuntimeContext
             {
                 int64_t* op_durations;
+                PerfEventCounts* op_events;
                 bool* p_en;
+                bool** t_en;
                 bool first_iteration;
                 mkldnn::primitive* const* mkldnn_primitives;
                 std::vector<AlignedBuffer*> memory_buffers;
+                // The arena tickets that reclaim borrowed memory_buffers between calls
+                std::vector<size_t> scratch_tickets;
                 char* const* mkldnn_workspaces;
                 tbb::flow::graph* G;
                 tbb::global_control* c;
                 tbb::task_scheduler_init* init;
+                // The functors and tensor pointers this context runs for a DEX function
+                DEXProgram* dex_program;
             };
             }
         }
@@ -39,11 +39,34 @@ void ngraph::runtime::cpu::to_json(nlohmann::json& json, const TraceEvent& event
                           {"ts", event.Timestamp},
                           {"dur", event.Duration},
                           {"args", args}};
+
+    if (event.Events)
+    {
+        const PerfEventCounts& counts = *event.Events;
+        nlohmann::json& json_args = json["args"];
+        if (!counts.available)
+        {
+            json_args["counters"] = "unavailable";
+            return;
+        }
+        // Only the thread that ran the op is counted, not the intra-op thread pool
+        json_args["counters"] = "executing thread";
+        json_args["cycles"] = counts.cycles;
+        json_args["instructions"] = counts.instructions;
+        json_args["llc_misses"] = counts.llc_misses;
+        json_args["flops"] = counts.flops;
+        // Durations are in microseconds; operations or bytes per nanosecond are G/s
+        double ns = event.Duration * 1e3;
+        json_args["GFLOP/s"] = ns > 0 ? counts.flops / ns : 0;
+        json_args["GB/s"] =
+            ns > 0 ? counts.llc_misses * PerfEventGroup::s_cache_line_size / ns : 0;
+    }
 }
 
 void ngraph::runtime::cpu::GenerateTimeline(const std::vector<OpAttributes>& op_attrs,
                                             int64_t* op_durations,
-                                            const std::string& file_name)
+                                            const std::string& file_name,
+                                            const PerfEventCounts* op_events)
 {
     nlohmann::json timeline;
     std::list<TraceEvent> trace;
@@ -60,7 +83,8 @@ void ngraph::runtime::cpu::GenerateTimeline(const std::vector<OpAttributes>& op_
                            ts,
                            op_durations[i],
                            op_attrs[i].Outputs,
-                           op_attrs[i].Inputs);
+                           op_attrs[i].Inputs,
+                           op_events ? &op_events[i] : nullptr);
         ts += op_durations[i];
     }
 
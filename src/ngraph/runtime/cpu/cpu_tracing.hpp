@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "ngraph/runtime/cpu/cpu_external_function.hpp"
+#include "ngraph/runtime/cpu/cpu_perf_events.hpp"
 #include "nlohmann/json.hpp"
 
 namespace ngraph
@@ -43,6 +44,8 @@ namespace ngraph
                 int64_t Duration;
                 const std::vector<std::string>& Outputs;
                 const std::vector<std::string>& Inputs;
+                // Hardware event counts of the op, or nullptr if they were not read
+                const PerfEventCounts* Events;
 
                 TraceEvent(const std::string& ph,
                            const std::string& cat,
@@ -52,7 +55,8 @@ namespace ngraph
                            int64_t ts,
                            int64_t dur,
                            const std::vector<std::string>& outputs,
-                           const std::vector<std::string>& inputs)
+                           const std::vector<std::string>& inputs,
+                           const PerfEventCounts* events = nullptr)
                     : Phase(ph)
                     , Category(cat)
                     , Name(name)
@@ -62,15 +66,22 @@ namespace ngraph
                     , Duration(dur)
                     , Outputs(outputs)
                     , Inputs(inputs)
+                    , Events(events)
                 {
                 }
             };
 
             void to_json(nlohmann::json& json, const TraceEvent& event);
 
+            /// \brief Writes the ops of the last call as a Chrome trace. If op_events is not
+            ///        null, the hardware event counts of each op and the GFLOP/s and GB/s they
+            ///        imply are added to the arguments of its event. The "counters" argument
+            ///        says which threads were counted, or "unavailable" if the counters could
+            ///        not be opened, in which case no counts are written.
             void GenerateTimeline(const std::vector<OpAttributes>& op_attrs,
                                   int64_t* op_durations,
-                                  const std::string& file_name);
+                                  const std::string& file_name,
+                                  const PerfEventCounts* op_events = nullptr);
             bool IsTracingEnabled();
         }
     }
@@ -0,0 +1,193 @@
+//*****************************************************************************
+// Copyright 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <immintrin.h>
+
+#include "ngraph/runtime/cpu/cpu_kernels.hpp"
+#include "ngraph/type/bfloat16.hpp"
+#include "ngraph/type/float16.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            namespace kernel
+            {
+                // Elements converted per thread at a time
+                static const size_t s_convert_block_size = 16384;
+
+                // Calls convert(begin, end) on blocks of [0, count) in parallel
+                template <typename Function>
+                static void convert_blocks(size_t count, Function convert)
+                {
+                    size_t block_count =
+                        (count + s_convert_block_size - 1) / s_convert_block_size;
+#pragma omp parallel for
+                    for (size_t block = 0; block < block_count; block++)
+                    {
+                        size_t begin = block * s_convert_block_size;
+                        convert(begin, std::min(count, begin + s_convert_block_size));
+                    }
+                }
+
+                void convert_f32_to_bf16(const float* input, bfloat16* output, size_t count)
+                {
+                    convert_blocks(count, [input, output](size_t i, size_t end) {
+#if defined(__AVX512F__)
+                        uint16_t* bits = reinterpret_cast<uint16_t*>(output);
+                        // Rounds to nearest even like bfloat16(float). vcvtneps2bf16 would
+                        // flush denormals to zero.
+                        const __m512i one = _mm512_set1_epi32(1);
+                        const __m512i rounding_bias = _mm512_set1_epi32(0x7fff);
+                        const __m512i quiet_bit = _mm512_set1_epi32(0x40);
+                        for (; i + 16 <= end; i += 16)
+                        {
+                            __m512 values = _mm512_loadu_ps(input + i);
+                            __m512i value_bits = _mm512_castps_si512(values);
+                            __m512i upper = _mm512_srli_epi32(value_bits, 16);
+                            __m512i bias =
+                                _mm512_add_epi32(rounding_bias, _mm512_and_si512(upper, one));
+                            __m512i rounded =
+                                _mm512_srli_epi32(_mm512_add_epi32(value_bits, bias), 16);
+                            __mmask16 nans = _mm512_cmp_ps_mask(values, values, _CMP_UNORD_Q);
+                            rounded = _mm512_mask_mov_epi32(
+                                rounded, nans, _mm512_or_si512(upper, quiet_bit));
+                            _mm256_storeu_si256(reinterpret_cast<__m256i*>(bits + i),
+                                                _mm512_cvtepi32_epi16(rounded));
+                        }
+#elif defined(__AVX2__)
+                        uint16_t* bits = reinterpret_cast<uint16_t*>(output);
+                        const __m256i one = _mm256_set1_epi32(1);
+                        const __m256i rounding_bias = _mm256_set1_epi32(0x7fff);
+                        const __m256i quiet_bit = _mm256_set1_epi32(0x40);
+                        for (; i + 8 <= end; i += 8)
+                        {
+                            __m256 values = _mm256_loadu_ps(input + i);
+                            __m256i value_bits = _mm256_castps_si256(values);
+                            __m256i upper = _mm256_srli_epi32(value_bits, 16);
+                            __m256i bias =
+                                _mm256_add_epi32(rounding_bias, _mm256_and_si256(upper, one));
+                            __m256i rounded =
+                                _mm256_srli_epi32(_mm256_add_epi32(value_bits, bias), 16);
+                            __m256 nans = _mm256_cmp_ps(values, values, _CMP_UNORD_Q);
+                            rounded = _mm256_blendv_epi8(rounded,
+                                                         _mm256_or_si256(upper, quiet_bit),
+                                                         _mm256_castps_si256(nans));
+                            // Every lane fits in 16 bits, so the saturating pack is exact
+                            __m256i packed = _mm256_permute4x64_epi64(
+                                _mm256_packus_epi32(rounded, rounded), 0x08);
+                            _mm_storeu_si128(reinterpret_cast<__m128i*>(bits + i),
+                                             _mm256_castsi256_si128(packed));
+                        }
+#endif
+                        for (; i < end; i++)
+                        {
+                            output[i] = bfloat16(input[i]);
+                        }
+                    });
+                }
+
+                void convert_bf16_to_f32(const bfloat16* input, float* output, size_t count)
+                {
+                    convert_blocks(count, [input, output](size_t i, size_t end) {
+#if defined(__AVX512F__)
+                        const uint16_t* bits = reinterpret_cast<const uint16_t*>(input);
+                        for (; i + 16 <= end; i += 16)
+                        {
+                            __m512i values = _mm512_cvtepu16_epi32(
+                                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bits + i)));
+                            _mm512_storeu_ps(output + i,
+                                             _mm512_castsi512_ps(_mm512_slli_epi32(values, 16)));
+                        }
+#elif defined(__AVX2__)
+                        const uint16_t* bits = reinterpret_cast<const uint16_t*>(input);
+                        for (; i + 8 <= end; i += 8)
+                        {
+                            __m256i values = _mm256_cvtepu16_epi32(
+                                _mm_loadu_si128(reinterpret_cast<const __m128i*>(bits + i)));
+                            _mm256_storeu_ps(output + i,
+                                             _mm256_castsi256_ps(_mm256_slli_epi32(values, 16)));
+                        }
+#endif
+                        for (; i < end; i++)
+                        {
+                            output[i] = input[i];
+                        }
+                    });
+                }
+
+                void convert_f32_to_f16(const float* input, float16* output, size_t count)
+                {
+                    convert_blocks(count, [input, output](size_t i, size_t end) {
+#if defined(__AVX512F__)
+                        uint16_t* bits = reinterpret_cast<uint16_t*>(output);
+                        for (; i + 16 <= end; i += 16)
+                        {
+                            _mm256_storeu_si256(
+                                reinterpret_cast<__m256i*>(bits + i),
+                                _mm512_cvtps_ph(_mm512_loadu_ps(input + i),
+                                                _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+                        }
+#elif defined(__F16C__)
+                        uint16_t* bits = reinterpret_cast<uint16_t*>(output);
+                        for (; i + 8 <= end; i += 8)
+                        {
+                            _mm_storeu_si128(
+                                reinterpret_cast<__m128i*>(bits + i),
+                                _mm256_cvtps_ph(_mm256_loadu_ps(input + i),
+                                                _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+                        }
+#endif
+                        for (; i < end; i++)
+                        {
+                            output[i] = float16(input[i]);
+                        }
+                    });
+                }
+
+                void convert_f16_to_f32(const float16* input, float* output, size_t count)
+                {
+                    convert_blocks(count, [input, output](size_t i, size_t end) {
+#if defined(__AVX512F__)
+                        const uint16_t* bits = reinterpret_cast<const uint16_t*>(input);
+                        for (; i + 16 <= end; i += 16)
+                        {
+                            _mm512_storeu_ps(output + i,
+                                             _mm512_cvtph_ps(_mm256_loadu_si256(
+                                                 reinterpret_cast<const __m256i*>(bits + i))));
+                        }
+#elif defined(__F16C__)
+                        const uint16_t* bits = reinterpret_cast<const uint16_t*>(input);
+                        for (; i + 8 <= end; i += 8)
+                        {
+                            _mm256_storeu_ps(output + i,
+                                             _mm256_cvtph_ps(_mm_loadu_si128(
+                                                 reinterpret_cast<const __m128i*>(bits + i))));
+                        }
+#endif
+                        for (; i < end; i++)
+                        {
+                            output[i] = input[i];
+                        }
+                    });
+                }
+            }
+        }
+    }
+}
@@ -19,7 +19,10 @@
 #define EIGEN_USE_THREADS
 #include <unsupported/Eigen/CXX11/Tensor>
 
+#include "ngraph/runtime/cpu/cpu_kernels.hpp"
 #include "ngraph/runtime/cpu/kernel/eigen_thread_pool.hpp"
+#include "ngraph/type/bfloat16.hpp"
+#include "ngraph/type/float16.hpp"
 
 namespace ngraph
 {
@@ -104,6 +107,71 @@ namespace ngraph
                 {
                     convert<InputElementType, uint64_t>(input, output, count);
                 }
+
+                // Eigen has no casts for bfloat16 and float16, so they convert through float
+                template <typename InputElementType, typename OutputElementType>
+                void convert_through_float(void* input, void* output, size_t count)
+                {
+                    auto in = static_cast<const InputElementType*>(input);
+                    auto out = static_cast<OutputElementType*>(output);
+#pragma omp parallel for
+                    for (size_t i = 0; i < count; i++)
+                    {
+                        out[i] = static_cast<OutputElementType>(static_cast<float>(in[i]));
+                    }
+                }
+
+                template <typename InputElementType>
+                void convert_to_bf16(void* input, void* output, size_t count)
+                {
+                    convert_through_float<InputElementType, bfloat16>(input, output, count);
+                }
+
+                template <>
+                inline void convert_to_bf16<float>(void* input, void* output, size_t count)
+                {
+                    convert_f32_to_bf16(
+                        static_cast<const float*>(input), static_cast<bfloat16*>(output), count);
+                }
+
+                template <typename InputElementType>
+                void convert_to_f16(void* input, void* output, size_t count)
+                {
+                    convert_through_float<InputElementType, float16>(input, output, count);
+                }
+
+                template <>
+                inline void convert_to_f16<float>(void* input, void* output, size_t count)
+                {
+                    convert_f32_to_f16(
+                        static_cast<const float*>(input), static_cast<float16*>(output), count);
+                }
+
+                template <typename OutputElementType>
+                void convert_from_bf16(void* input, void* output, size_t count)
+                {
+                    convert_through_float<bfloat16, OutputElementType>(input, output, count);
+                }
+
+                template <>
+                inline void convert_from_bf16<float>(void* input, void* output, size_t count)
+                {
+                    convert_bf16_to_f32(
+                        static_cast<const bfloat16*>(input), static_cast<float*>(output), count);
+                }
+
+                template <typename OutputElementType>
+                void convert_from_f16(void* input, void* output, size_t count)
+                {
+                    convert_through_float<float16, OutputElementType>(input, output, count);
+                }
+
+                template <>
+                inline void convert_from_f16<float>(void* input, void* output, size_t count)
+                {
+                    convert_f16_to_f32(
+                        static_cast<const float16*>(input), static_cast<float*>(output), count);
+                }
             }
         }
     }
@@ -0,0 +1,158 @@
+//*****************************************************************************
+// Copyright 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            namespace kernel
+            {
+                /// \brief One elementwise op of a fused loop. Operands name registers: the
+                ///        kernel's inputs come first, then its outputs, then temporaries.
+                struct LoopKernelInstruction
+                {
+                    enum class Opcode
+                    {
+                        Abs,
+                        Add,
+                        Maximum,
+                        Minimum,
+                        Negative,
+                        Relu,
+                        Subtract
+                    };
+
+                    Opcode opcode;
+                    size_t result;
+                    size_t arg0;
+                    // Unused by unary opcodes
+                    size_t arg1;
+                };
+
+                // Elements of each register processed per step. Temporaries of a block stay
+                // in L1 and every instruction's loop over the block vectorizes.
+                constexpr size_t s_loop_kernel_block_size = 1024;
+
+                template <typename ElementType>
+                void loop_kernel_instruction(const LoopKernelInstruction& instruction,
+                                             ElementType* const* registers,
+                                             size_t count)
+                {
+                    ElementType* out = registers[instruction.result];
+                    const ElementType* arg0 = registers[instruction.arg0];
+                    const ElementType* arg1 = registers[instruction.arg1];
+                    switch (instruction.opcode)
+                    {
+                    case LoopKernelInstruction::Opcode::Abs:
+                        for (size_t i = 0; i < count; i++)
+                        {
+                            out[i] = arg0[i] < 0 ? -arg0[i] : arg0[i];
+                        }
+                        break;
+                    case LoopKernelInstruction::Opcode::Add:
+                        for (size_t i = 0; i < count; i++)
+                        {
+                            out[i] = arg0[i] + arg1[i];
+                        }
+                        break;
+                    case LoopKernelInstruction::Opcode::Maximum:
+                        for (size_t i = 0; i < count; i++)
+                        {
+                            out[i] = arg0[i] > arg1[i] ? arg0[i] : arg1[i];
+                        }
+                        break;
+                    case LoopKernelInstruction::Opcode::Minimum:
+                        for (size_t i = 0; i < count; i++)
+                        {
+                            out[i] = arg0[i] < arg1[i] ? arg0[i] : arg1[i];
+                        }
+                        break;
+                    case LoopKernelInstruction::Opcode::Negative:
+                        for (size_t i = 0; i < count; i++)
+                        {
+                            out[i] = -arg0[i];
+                        }
+                        break;
+                    case LoopKernelInstruction::Opcode::Relu:
+                        for (size_t i = 0; i < count; i++)
+                        {
+                            out[i] = arg0[i] > 0 ? arg0[i] : ElementType(0);
+                        }
+                        break;
+                    case LoopKernelInstruction::Opcode::Subtract:
+                        for (size_t i = 0; i < count; i++)
+                        {
+                            out[i] = arg0[i] - arg1[i];
+                        }
+                        break;
+                    }
+                }
+
+                /// \brief Runs program over count elements, one block at a time, so that
+                ///        intermediate values never leave the cache. tensors holds the
+                ///        kernel's inputs followed by its outputs; temporaries are the
+                ///        remaining registers.
+                template <typename ElementType>
+                void loop_kernel(const std::vector<LoopKernelInstruction>& program,
+                                 const std::vector<std::reference_wrapper<void*>>& tensors,
+                                 size_t register_count,
+                                 size_t count)
+                {
+                    size_t tensor_count = tensors.size();
+                    size_t temp_count = register_count - tensor_count;
+                    size_t block_count =
+                        (count + s_loop_kernel_block_size - 1) / s_loop_kernel_block_size;
+
+#pragma omp parallel for
+                    for (size_t block = 0; block < block_count; block++)
+                    {
+                        static thread_local std::vector<ElementType> temps;
+                        static thread_local std::vector<ElementType*> registers;
+                        temps.resize(temp_count * s_loop_kernel_block_size);
+                        registers.resize(register_count);
+
+                        size_t begin = block * s_loop_kernel_block_size;
+                        size_t block_size = std::min(s_loop_kernel_block_size, count - begin);
+
+                        for (size_t i = 0; i < tensor_count; i++)
+                        {
+                            registers[i] = static_cast<ElementType*>(tensors[i].get()) + begin;
+                        }
+                        for (size_t i = 0; i < temp_count; i++)
+                        {
+                            registers[tensor_count + i] =
+                                temps.data() + i * s_loop_kernel_block_size;
+                        }
+
+                        for (const LoopKernelInstruction& instruction : program)
+                        {
+                            loop_kernel_instruction(instruction, registers.data(), block_size);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
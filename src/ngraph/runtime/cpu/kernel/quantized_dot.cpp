@@ -0,0 +1,167 @@
+//*****************************************************************************
+// Copyright 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "ngraph/runtime/cpu/cpu_kernels.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            namespace kernel
+            {
+                // The output is computed in tiles of rows by columns, which are spread over the
+                // threads. The accumulators of a tile take 32 KB.
+                static const size_t s_quantized_dot_row_block = 8;
+                static const size_t s_quantized_dot_column_block = 1024;
+                // Rows of weights accumulated at a time. The panel of weights they span (up to
+                // 64 KB) stays in L2 while every row of the tile is multiplied with it.
+                static const size_t s_quantized_dot_inner_block = 64;
+
+                // OutputType is int8_t, or uint8_t when a Relu is fused in and negative
+                // results saturate to zero
+                template <typename OutputType>
+                static void quantized_dot(const uint8_t* data,
+                                          const int8_t* weights,
+                                          const float* bias,
+                                          OutputType* output,
+                                          size_t rows,
+                                          size_t inner,
+                                          size_t columns,
+                                          float dequantize_scale,
+                                          float requantize_scale)
+                {
+                    const float lowest = std::numeric_limits<OutputType>::lowest();
+                    const float highest = std::numeric_limits<OutputType>::max();
+                    const size_t row_blocks =
+                        (rows + s_quantized_dot_row_block - 1) / s_quantized_dot_row_block;
+                    const size_t column_blocks =
+                        (columns + s_quantized_dot_column_block - 1) / s_quantized_dot_column_block;
+                    const size_t tiles = row_blocks * column_blocks;
+#pragma omp parallel for
+                    for (size_t tile = 0; tile < tiles; tile++)
+                    {
+                        int32_t accumulators[s_quantized_dot_row_block]
+                                            [s_quantized_dot_column_block];
+                        size_t row_begin = (tile / column_blocks) * s_quantized_dot_row_block;
+                        size_t row_count = std::min(s_quantized_dot_row_block, rows - row_begin);
+                        size_t column_begin =
+                            (tile % column_blocks) * s_quantized_dot_column_block;
+                        size_t column_count =
+                            std::min(s_quantized_dot_column_block, columns - column_begin);
+                        for (size_t r = 0; r < row_count; r++)
+                        {
+                            std::fill(accumulators[r], accumulators[r] + column_count, 0);
+                        }
+
+                        for (size_t inner_begin = 0; inner_begin < inner;
+                             inner_begin += s_quantized_dot_inner_block)
+                        {
+                            size_t inner_end =
+                                std::min(inner_begin + s_quantized_dot_inner_block, inner);
+                            for (size_t r = 0; r < row_count; r++)
+                            {
+                                const uint8_t* data_row = data + (row_begin + r) * inner;
+                                int32_t* row_accumulators = accumulators[r];
+                                // The inner loop runs along a row of weights, so it vectorizes
+                                for (size_t k = inner_begin; k < inner_end; k++)
+                                {
+                                    int32_t value = data_row[k];
+                                    // Activations after a Relu are mostly zero
+                                    if (value == 0)
+                                    {
+                                        continue;
+                                    }
+                                    const int8_t* weights_row =
+                                        weights + k * columns + column_begin;
+                                    for (size_t j = 0; j < column_count; j++)
+                                    {
+                                        row_accumulators[j] += value * weights_row[j];
+                                    }
+                                }
+                            }
+                        }
+
+                        for (size_t r = 0; r < row_count; r++)
+                        {
+                            OutputType* output_row =
+                                output + (row_begin + r) * columns + column_begin;
+                            for (size_t j = 0; j < column_count; j++)
+                            {
+                                float result = accumulators[r][j] * dequantize_scale;
+                                if (bias)
+                                {
+                                    result += bias[column_begin + j];
+                                }
+                                result = std::nearbyint(result * requantize_scale);
+                                output_row[j] = static_cast<OutputType>(
+                                    std::min(std::max(result, lowest), highest));
+                            }
+                        }
+                    }
+                }
+
+                void quantized_dot(const uint8_t* data,
+                                   const int8_t* weights,
+                                   const float* bias,
+                                   int8_t* output,
+                                   size_t rows,
+                                   size_t inner,
+                                   size_t columns,
+                                   float dequantize_scale,
+                                   float requantize_scale)
+                {
+                    quantized_dot<int8_t>(data,
+                                          weights,
+                                          bias,
+                                          output,
+                                          rows,
+                                          inner,
+                                          columns,
+                                          dequantize_scale,
+                                          requantize_scale);
+                }
+
+                void quantized_dot(const uint8_t* data,
+                                   const int8_t* weights,
+                                   const float* bias,
+                                   uint8_t* output,
+                                   size_t rows,
+                                   size_t inner,
+                                   size_t columns,
+                                   float dequantize_scale,
+                                   float requantize_scale)
+                {
+                    quantized_dot<uint8_t>(data,
+                                           weights,
+                                           bias,
+                                           output,
+                                           rows,
+                                           inner,
+                                           columns,
+                                           dequantize_scale,
+                                           requantize_scale);
+                }
+            }
+        }
+    }
+}
@@ -113,7 +113,8 @@ namespace ngraph
                                                    const ngraph::Strides& dilation_strides,
                                                    const ngraph::CoordinateDiff& padding_below,
                                                    const ngraph::CoordinateDiff& padding_above,
-                                                   const float scale);
+                                                   const float scale,
+                                                   const mkldnn::post_ops& pops);
 
                 template <typename OP>
                 size_t build_convolution(const ngraph::Node* node,
@@ -170,6 +171,11 @@ namespace ngraph
                         {
                             return true;
                         }
+                        if (dynamic_cast<const ngraph::op::QuantizedConvolution*>(node))
+                        {
+                            return (dynamic_cast<const ngraph::op::QuantizedConvolution*>(node))
+                                ->with_relu();
+                        }
                         return false;
                     };
 
@@ -207,7 +213,8 @@ namespace ngraph
                             window_dilation_strides_adjusted,
                             convolution->get_padding_below(),
                             convolution->get_padding_above(),
-                            scale);
+                            scale,
+                            ops);
                     }
                     else
                     {
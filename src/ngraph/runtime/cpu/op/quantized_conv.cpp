@@ -35,7 +35,8 @@ op::QuantizedConvolution::QuantizedConvolution(const shared_ptr<Node>& data_batc
                                                const std::shared_ptr<Node> min_filter,
                                                const std::shared_ptr<Node> max_filter,
                                                const std::shared_ptr<Node> min_freezed_output,
-                                               const std::shared_ptr<Node> max_freezed_output)
+                                               const std::shared_ptr<Node> max_freezed_output,
+                                               bool with_relu)
     : Op("QuantizedConvolution",
          check_single_output_args({data_batch,
                                    filters,
@@ -50,6 +51,7 @@ op::QuantizedConvolution::QuantizedConvolution(const shared_ptr<Node>& data_batc
     , m_padding_below(padding_below)
     , m_padding_above(padding_above)
     , m_data_dilation_strides(data_dilation_strides)
+    , m_with_relu(with_relu)
 {
     constructor_validate_and_infer_types();
 
@@ -82,7 +84,7 @@ op::QuantizedConvolution::QuantizedConvolution(const shared_ptr<Node>& data_batc
 
     set_output_size(3);
     set_output_type(0,
-                    element::i8,
+                    with_relu ? element::u8 : element::i8,
                     util::infer_convolution_output_shape(this,
                                                          data_batch_shape,
                                                          filters_shape,
@@ -119,5 +121,6 @@ shared_ptr<Node> op::QuantizedConvolution::copy_with_new_args(const NodeVector&
                                                      new_args.at(4),
                                                      new_args.at(5),
                                                      new_args.at(6),
-                                                     new_args.at(7)));
+                                                     new_args.at(7),
+                                                     m_with_relu));
 }
@@ -38,7 +38,8 @@ namespace ngraph
                                  const std::shared_ptr<Node> min_filter,
                                  const std::shared_ptr<Node> max_filter,
                                  const std::shared_ptr<Node> min_freezed_output,
-                                 const std::shared_ptr<Node> max_freezed_output);
+                                 const std::shared_ptr<Node> max_freezed_output,
+                                 bool with_relu = false);
             const Strides& get_window_movement_strides() const { return m_window_movement_strides; }
             const Strides& get_window_dilation_strides() const { return m_window_dilation_strides; }
             const CoordinateDiff& get_padding_below() const { return m_padding_below; }
@@ -52,6 +53,8 @@ namespace ngraph
             float get_filter_max() const { return m_filter_max; }
             float get_freezed_output_min() const { return m_freezed_output_min; }
             float get_freezed_output_max() const { return m_freezed_output_max; }
+            /// \return True if a Relu is fused into the op, which then outputs u8
+            bool with_relu() const { return m_with_relu; }
             virtual std::shared_ptr<Node>
                 copy_with_new_args(const NodeVector& new_args) const override;
 
@@ -67,6 +70,7 @@ namespace ngraph
             float m_filter_max;
             float m_freezed_output_min;
             float m_freezed_output_max;
+            bool m_with_relu;
         };
     }
 }
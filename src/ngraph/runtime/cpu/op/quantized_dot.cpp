@@ -0,0 +1,138 @@
+//*****************************************************************************
+// Copyright 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <cmath>
+
+#include "ngraph/op/constant.hpp"
+#include "ngraph/runtime/cpu/op/quantized_dot.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+static float get_constant_value(const shared_ptr<Node>& node)
+{
+    auto constant = dynamic_pointer_cast<op::Constant>(node);
+    if (!constant || node->get_element_type() != element::f32 || shape_size(node->get_shape()) != 1)
+    {
+        throw ngraph_error("QuantizedDot ranges have to be f32 scalar constants");
+    }
+    return *static_cast<const float*>(constant->get_data_ptr());
+}
+
+// The bias is the last argument, if there is one
+static NodeVector with_bias(NodeVector args, const shared_ptr<Node>& bias)
+{
+    if (bias)
+    {
+        args.push_back(bias);
+    }
+    return args;
+}
+
+static float get_max_abs(float min, float max)
+{
+    return std::max(std::abs(min), std::abs(max));
+}
+
+op::QuantizedDot::QuantizedDot(const shared_ptr<Node>& data,
+                               const shared_ptr<Node>& weights,
+                               const shared_ptr<Node>& min_input,
+                               const shared_ptr<Node>& max_input,
+                               const shared_ptr<Node>& min_weights,
+                               const shared_ptr<Node>& max_weights,
+                               const shared_ptr<Node>& min_freezed_output,
+                               const shared_ptr<Node>& max_freezed_output,
+                               const shared_ptr<Node>& bias,
+                               bool with_relu)
+    : Op("QuantizedDot",
+         check_single_output_args(with_bias({data,
+                                             weights,
+                                             min_input,
+                                             max_input,
+                                             min_weights,
+                                             max_weights,
+                                             min_freezed_output,
+                                             max_freezed_output},
+                                            bias)))
+    , m_input_min(get_constant_value(min_input))
+    , m_input_max(get_constant_value(max_input))
+    , m_weights_min(get_constant_value(min_weights))
+    , m_weights_max(get_constant_value(max_weights))
+    , m_freezed_output_min(get_constant_value(min_freezed_output))
+    , m_freezed_output_max(get_constant_value(max_freezed_output))
+    , m_with_relu(with_relu)
+{
+    constructor_validate_and_infer_types();
+}
+
+void op::QuantizedDot::validate_and_infer_types()
+{
+    const Shape& data_shape = get_input_shape(0);
+    const Shape& weights_shape = get_input_shape(1);
+
+    NODE_VALIDATION_ASSERT(this, get_input_element_type(0) == element::u8)
+        << "Data element type (" << get_input_element_type(0) << ") is not u8";
+    NODE_VALIDATION_ASSERT(this, get_input_element_type(1) == element::i8)
+        << "Weights element type (" << get_input_element_type(1) << ") is not i8";
+    NODE_VALIDATION_ASSERT(this, data_shape.size() == 2 && weights_shape.size() == 2)
+        << "Data and weights must be matrices (data shape: " << data_shape
+        << ", weights shape: " << weights_shape << ")";
+    NODE_VALIDATION_ASSERT(this, data_shape[1] == weights_shape[0])
+        << "Data columns do not match weights rows (data shape: " << data_shape
+        << ", weights shape: " << weights_shape << ")";
+    if (has_bias())
+    {
+        NODE_VALIDATION_ASSERT(this, get_input_element_type(8) == element::f32)
+            << "Bias element type (" << get_input_element_type(8) << ") is not f32";
+        NODE_VALIDATION_ASSERT(this, get_input_shape(8) == Shape{weights_shape[1]})
+            << "Bias shape (" << get_input_shape(8) << ") does not match weights columns";
+    }
+
+    set_output_size(3);
+    set_output_type(
+        0, m_with_relu ? element::u8 : element::i8, Shape{data_shape[0], weights_shape[1]});
+    set_output_type(1, element::f32, Shape{});
+    set_output_type(2, element::f32, Shape{});
+}
+
+float op::QuantizedDot::get_dequantize_scale() const
+{
+    return get_max_abs(m_input_min, m_input_max) / 255 *
+           get_max_abs(m_weights_min, m_weights_max) / 127;
+}
+
+float op::QuantizedDot::get_requantize_scale() const
+{
+    return (m_with_relu ? 255 : 127) / get_max_abs(m_freezed_output_min, m_freezed_output_max);
+}
+
+shared_ptr<Node> op::QuantizedDot::copy_with_new_args(const NodeVector& new_args) const
+{
+    if (new_args.size() != 8 && new_args.size() != 9)
+    {
+        throw ngraph_error("Incorrect number of new arguments");
+    }
+    return make_shared<QuantizedDot>(new_args.at(0),
+                                     new_args.at(1),
+                                     new_args.at(2),
+                                     new_args.at(3),
+                                     new_args.at(4),
+                                     new_args.at(5),
+                                     new_args.at(6),
+                                     new_args.at(7),
+                                     new_args.size() == 9 ? new_args.at(8) : nullptr,
+                                     m_with_relu);
+}
@@ -0,0 +1,72 @@
+//*****************************************************************************
+// Copyright 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include "ngraph/op/op.hpp"
+
+namespace ngraph
+{
+    namespace op
+    {
+        /// \brief Fully connected layer on quantized tensors: a u8 [N, K] data batch times i8
+        ///        [K, M] weights, accumulated in s32, plus an optional f32 [M] bias, requantized
+        ///        to i8 [N, M], or to u8 [N, M] with a fused Relu.
+        ///
+        /// Each range is given by constant min and max scalars, and the largest of their
+        /// magnitudes is the value of the largest quantized number (255 for the data and a u8
+        /// output, 127 for the weights and an i8 output), as with Quantize and Dequantize.
+        /// Outputs 1 and 2 are the output range.
+        class QuantizedDot : public Op
+        {
+        public:
+            QuantizedDot(const std::shared_ptr<Node>& data,
+                         const std::shared_ptr<Node>& weights,
+                         const std::shared_ptr<Node>& min_input,
+                         const std::shared_ptr<Node>& max_input,
+                         const std::shared_ptr<Node>& min_weights,
+                         const std::shared_ptr<Node>& max_weights,
+                         const std::shared_ptr<Node>& min_freezed_output,
+                         const std::shared_ptr<Node>& max_freezed_output,
+                         const std::shared_ptr<Node>& bias = nullptr,
+                         bool with_relu = false);
+            void validate_and_infer_types() override;
+            bool has_bias() const { return get_input_size() > 8; }
+            bool with_relu() const { return m_with_relu; }
+            float get_input_min() const { return m_input_min; }
+            float get_input_max() const { return m_input_max; }
+            float get_weights_min() const { return m_weights_min; }
+            float get_weights_max() const { return m_weights_max; }
+            float get_freezed_output_min() const { return m_freezed_output_min; }
+            float get_freezed_output_max() const { return m_freezed_output_max; }
+            /// \return The value of one unit of the s32 accumulator
+            float get_dequantize_scale() const;
+            /// \return The number of output units per unit of the f32 result
+            float get_requantize_scale() const;
+            virtual std::shared_ptr<Node>
+                copy_with_new_args(const NodeVector& new_args) const override;
+
+        protected:
+            float m_input_min;
+            float m_input_max;
+            float m_weights_min;
+            float m_weights_max;
+            float m_freezed_output_min;
+            float m_freezed_output_max;
+            bool m_with_relu;
+        };
+    }
+}
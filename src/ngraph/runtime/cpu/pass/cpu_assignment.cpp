@@ -21,21 +21,37 @@
 #include <typeindex>
 #include <typeinfo>
 #include <unordered_map>
+#include <unordered_set>
 
 #include <mkldnn.hpp>
 
 #include "ngraph/descriptor/output.hpp"
+#include "ngraph/op/abs.hpp"
 #include "ngraph/op/add.hpp"
 #include "ngraph/op/avg_pool.hpp"
 #include "ngraph/op/batch_norm.hpp"
+#include "ngraph/op/ceiling.hpp"
 #include "ngraph/op/concat.hpp"
 #include "ngraph/op/convolution.hpp"
+#include "ngraph/op/cos.hpp"
+#include "ngraph/op/divide.hpp"
+#include "ngraph/op/exp.hpp"
+#include "ngraph/op/floor.hpp"
+#include "ngraph/op/log.hpp"
 #include "ngraph/op/lrn.hpp"
 #include "ngraph/op/max_pool.hpp"
+#include "ngraph/op/maximum.hpp"
+#include "ngraph/op/minimum.hpp"
+#include "ngraph/op/multiply.hpp"
+#include "ngraph/op/negative.hpp"
 #include "ngraph/op/relu.hpp"
 #include "ngraph/op/replace_slice.hpp"
 #include "ngraph/op/slice.hpp"
+#include "ngraph/op/sin.hpp"
 #include "ngraph/op/softmax.hpp"
+#include "ngraph/op/sqrt.hpp"
+#include "ngraph/op/subtract.hpp"
+#include "ngraph/op/tanh.hpp"
 #include "ngraph/runtime/cpu/cpu_op_annotations.hpp"
 #include "ngraph/runtime/cpu/mkldnn_utils.hpp"
 #include "ngraph/runtime/cpu/op/batch_norm_relu.hpp"
@@ -840,6 +856,45 @@ static const runtime::cpu::pass::AssignOpMap s_dispatcher{
      &runtime::cpu::pass::CPUAssignment::assign<ngraph::op::Dequantize>},
 };
 
+// Kernels of these ops read each element of their inputs before writing the same element of
+// the output, so the output may take over the memory of an input that dies at the op
+static const unordered_set<type_index> s_in_place_elementwise_ops{
+    TI(ngraph::op::Abs),      TI(ngraph::op::Add),      TI(ngraph::op::Ceiling),
+    TI(ngraph::op::Cos),      TI(ngraph::op::Divide),   TI(ngraph::op::Exp),
+    TI(ngraph::op::Floor),    TI(ngraph::op::Log),      TI(ngraph::op::Maximum),
+    TI(ngraph::op::Minimum),  TI(ngraph::op::Multiply), TI(ngraph::op::Negative),
+    TI(ngraph::op::Relu),     TI(ngraph::op::Sigmoid),  TI(ngraph::op::Sin),
+    TI(ngraph::op::Sqrt),     TI(ngraph::op::Subtract), TI(ngraph::op::Tanh)};
+
+static void assign_elementwise_in_place(Node* node)
+{
+    auto op = static_cast<ngraph::op::Op*>(node);
+    auto op_annotations =
+        static_pointer_cast<runtime::cpu::CPUOpAnnotations>(op->get_op_annotations());
+    // MKLDNN kernels declare their own in-place rules
+    if (op_annotations && (op_annotations->is_mkldnn_op() ||
+                           !op_annotations->get_in_place_oi_pairs().empty()))
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < node->get_input_size(); i++)
+    {
+        // pass::MemoryLayout only reuses the input if this op is its last use
+        if (node->get_input_element_type(i) == node->get_element_type() &&
+            node->get_input_shape(i) == node->get_shape())
+        {
+            if (!op_annotations)
+            {
+                op_annotations = make_shared<runtime::cpu::CPUOpAnnotations>();
+                op->set_op_annotations(op_annotations);
+            }
+            op_annotations->add_in_place_oi_pair({0, i, true});
+            return;
+        }
+    }
+}
+
 bool runtime::cpu::pass::CPUAssignment::run_on_call_graph(
     const std::list<std::shared_ptr<Node>>& nodes)
 {
@@ -851,6 +906,10 @@ bool runtime::cpu::pass::CPUAssignment::run_on_call_graph(
         {
             handler->second(m_external_function, node.get());
         }
+        if (s_in_place_elementwise_ops.count(TI(n)))
+        {
+            assign_elementwise_in_place(node.get());
+        }
     }
 
     return false;
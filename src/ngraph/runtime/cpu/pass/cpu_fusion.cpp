@@ -56,8 +56,12 @@
 #include "ngraph/runtime/cpu/op/conv_add.hpp"
 #include "ngraph/runtime/cpu/op/conv_bias.hpp"
 #include "ngraph/runtime/cpu/op/conv_relu.hpp"
+#include "ngraph/runtime/cpu/op/dequantize.hpp"
 #include "ngraph/runtime/cpu/op/matmul_bias.hpp"
+#include "ngraph/runtime/cpu/op/quantize.hpp"
+#include "ngraph/runtime/cpu/op/quantized_dot.hpp"
 #include "ngraph/runtime/cpu/op/sigmoid_mul.hpp"
+#include "ngraph/runtime/cpu/quantization_util.hpp"
 #include "ngraph/util.hpp"
 
 extern template ngraph::Shape ngraph::apply_permutation<ngraph::Shape>(ngraph::Shape input,
@@ -156,6 +160,84 @@ void ngraph::runtime::cpu::pass::CPUFusion::construct_matmulbias()
     this->add_matcher(m);
 }
 
+// Quantize(MatmulBias(Dequantize(u8), Dequantize(i8))) -> QuantizedDot
+void ngraph::runtime::cpu::pass::CPUFusion::construct_quantized_dot()
+{
+    Shape shape_data{2, 4};
+    Shape shape_weights{4, 3};
+    auto data = std::make_shared<pattern::op::Label>(element::u8, shape_data);
+    auto weights = std::make_shared<pattern::op::Label>(element::i8, shape_weights);
+    auto bias = std::make_shared<pattern::op::Label>(element::f32, Shape{3});
+    auto range = op::Constant::create(element::f32, Shape{}, {1.0f});
+
+    auto dequantize_data =
+        std::make_shared<op::Dequantize>(data, range, range, element::u8);
+    auto dequantize_data_label = std::make_shared<pattern::op::Label>(
+        dequantize_data, nullptr, NodeVector{dequantize_data});
+    auto dequantize_weights =
+        std::make_shared<op::Dequantize>(weights, range, range, element::i8);
+    auto dequantize_weights_label = std::make_shared<pattern::op::Label>(
+        dequantize_weights, nullptr, NodeVector{dequantize_weights});
+
+    ngraph::pattern::graph_rewrite_callback callback =
+        [data, weights, dequantize_data_label, dequantize_weights_label](pattern::Matcher& m) {
+            NGRAPH_DEBUG << "In callback for construct_quantized_dot against node = "
+                         << m.get_match_root()->get_name();
+            auto pattern_map = m.get_pattern_map();
+
+            auto quantize = std::static_pointer_cast<op::Quantize>(m.get_match_root());
+            auto matmul = std::static_pointer_cast<op::MatmulBias>(quantize->get_argument(0));
+            bool has_bias = matmul->get_arguments().size() > 2;
+            if (quantize->get_quantize_et() != element::i8 ||
+                pattern_map[data]->get_element_type() != element::u8 ||
+                pattern_map[weights]->get_element_type() != element::i8 ||
+                matmul->get_is_a_transposed() || matmul->get_is_b_transposed() ||
+                (has_bias && matmul->get_broadcast_axes() != AxisSet{0}))
+            {
+                return false;
+            }
+            // The f32 product is still needed
+            if (matmul->get_users().size() != 1)
+            {
+                return false;
+            }
+
+            // Quantize widens tiny ranges
+            std::vector<float> output_range;
+            quantization_util::get_min_max_range(
+                quantize->get_input_min(), quantize->get_input_max(), true, output_range);
+
+            auto dequantize_data = pattern_map[dequantize_data_label];
+            auto dequantize_weights = pattern_map[dequantize_weights_label];
+            auto qdot = std::make_shared<op::QuantizedDot>(
+                pattern_map[data],
+                pattern_map[weights],
+                dequantize_data->get_argument(1),
+                dequantize_data->get_argument(2),
+                dequantize_weights->get_argument(1),
+                dequantize_weights->get_argument(2),
+                op::Constant::create(element::f32, Shape{}, {output_range[0]}),
+                op::Constant::create(element::f32, Shape{}, {output_range[1]}),
+                has_bias ? matmul->get_argument(2) : nullptr);
+            ngraph::replace_node(quantize, qdot);
+            return true;
+        };
+
+    for (auto pattern_bias : {std::shared_ptr<Node>(), std::shared_ptr<Node>(bias)})
+    {
+        auto matmul = std::make_shared<op::MatmulBias>(dequantize_data_label,
+                                                       dequantize_weights_label,
+                                                       pattern_bias,
+                                                       shape_data,
+                                                       shape_weights,
+                                                       false,
+                                                       false,
+                                                       pattern_bias ? AxisSet{0} : AxisSet{});
+        auto quantize = std::make_shared<op::Quantize>(matmul, range, range, element::i8);
+        this->add_matcher(std::make_shared<ngraph::pattern::Matcher>(quantize, callback));
+    }
+}
+
 void ngraph::runtime::cpu::pass::CPUFusion::construct_matmul()
 {
     Shape shape_w{2, 4};
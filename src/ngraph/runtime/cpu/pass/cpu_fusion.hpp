@@ -59,6 +59,8 @@ public:
         {
             construct_matmul();
             construct_matmulbias();
+            // construct_quantized_dot() matches the MatmulBias ops fused above
+            construct_quantized_dot();
             construct_fprop_bn();
             construct_zero_padded_reshaped_conv();
             construct_zero_padded_conv();
@@ -80,6 +82,7 @@ public:
 private:
     void construct_matmul();
     void construct_matmulbias();
+    void construct_quantized_dot();
     void construct_conv_bias();
     void construct_conv_bias_bprop();
     void construct_fprop_bn();
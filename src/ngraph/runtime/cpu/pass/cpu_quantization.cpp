@@ -0,0 +1,512 @@
+//*****************************************************************************
+// Copyright 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include "cpu_quantization.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <unordered_set>
+
+#include "ngraph/graph_util.hpp"
+#include "ngraph/log.hpp"
+#include "ngraph/op/add.hpp"
+#include "ngraph/op/avg_pool.hpp"
+#include "ngraph/op/broadcast.hpp"
+#include "ngraph/op/constant.hpp"
+#include "ngraph/op/convolution.hpp"
+#include "ngraph/op/dot.hpp"
+#include "ngraph/op/get_output_element.hpp"
+#include "ngraph/op/max_pool.hpp"
+#include "ngraph/op/parameter.hpp"
+#include "ngraph/op/relu.hpp"
+#include "ngraph/runtime/backend.hpp"
+#include "ngraph/runtime/cpu/op/dequantize.hpp"
+#include "ngraph/runtime/cpu/op/quantize.hpp"
+#include "ngraph/runtime/cpu/op/quantized_avg_pool.hpp"
+#include "ngraph/runtime/cpu/op/quantized_conv.hpp"
+#include "ngraph/runtime/cpu/op/quantized_dot.hpp"
+#include "ngraph/runtime/cpu/op/quantized_max_pool.hpp"
+#include "ngraph/runtime/cpu/quantization_util.hpp"
+#include "ngraph/runtime/tensor_view.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+// Bins of the |x| histograms collected for KL divergence calibration
+static const size_t s_histogram_bins = 2048;
+
+static shared_ptr<Node> make_scalar(float value)
+{
+    return op::Constant::create(element::f32, Shape{}, {value});
+}
+
+// The range Quantize actually uses for [min, max], which it widens when it is tiny
+static float get_quantize_max(float min, float max, bool is_signed)
+{
+    vector<float> quant_util;
+    runtime::cpu::quantization_util::get_min_max_range(min, max, is_signed, quant_util);
+    return quant_util[1];
+}
+
+// An op with an int8 kernel, and the tensors it reads and writes
+struct QuantizationCandidate
+{
+    shared_ptr<Node> op;
+    shared_ptr<Node> data;
+    shared_ptr<Node> weights;
+    // Broadcast of the bias that is fused into a QuantizedDot
+    shared_ptr<Node> bias_broadcast;
+    // The op, or the bias Add or Relu after it
+    shared_ptr<Node> output;
+    // The output is a Relu fused into the op, which then outputs u8
+    bool relu;
+};
+
+static bool get_quantization_candidate(const shared_ptr<Node>& n, QuantizationCandidate& candidate)
+{
+    if (auto conv = dynamic_pointer_cast<op::Convolution>(n))
+    {
+        if (conv->get_element_type() != element::f32 || conv->get_shape().size() != 4 ||
+            conv->get_data_dilation_strides() != Strides(2, 1))
+        {
+            return false;
+        }
+        candidate = {conv, conv->get_argument(0), conv->get_argument(1), nullptr, conv, false};
+    }
+    else
+    {
+        auto dot = dynamic_pointer_cast<op::Dot>(n);
+        if (!dot || dot->get_element_type() != element::f32 ||
+            dot->get_argument(0)->get_shape().size() != 2 ||
+            dot->get_argument(1)->get_shape().size() != 2 ||
+            dot->get_reduction_axes_count() != 1)
+        {
+            return false;
+        }
+        candidate = {dot, dot->get_argument(0), dot->get_argument(1), nullptr, dot, false};
+
+        // Fold Add(Dot, Broadcast(bias)) with the bias along the rows into the QuantizedDot
+        NodeVector users = dot->get_users();
+        auto add = users.size() == 1 ? dynamic_pointer_cast<op::Add>(users[0]) : nullptr;
+        if (add)
+        {
+            auto other = add->get_argument(add->get_argument(0) == dot ? 1 : 0);
+            auto broadcast = dynamic_pointer_cast<op::Broadcast>(other);
+            if (broadcast && broadcast->get_broadcast_axes() == AxisSet{0})
+            {
+                candidate.bias_broadcast = broadcast;
+                candidate.output = add;
+            }
+        }
+    }
+
+    NodeVector users = candidate.output->get_users();
+    if (users.size() == 1 && dynamic_pointer_cast<op::Relu>(users[0]))
+    {
+        candidate.output = users[0];
+        candidate.relu = true;
+    }
+    return true;
+}
+
+static shared_ptr<Node> make_quantized_pool(const shared_ptr<Node>& pool,
+                                            const shared_ptr<Node>& arg,
+                                            const shared_ptr<Node>& min,
+                                            const shared_ptr<Node>& max)
+{
+    if (auto max_pool = dynamic_pointer_cast<op::MaxPool>(pool))
+    {
+        return make_shared<op::QuantizedMaxPool>(arg,
+                                                 max_pool->get_window_shape(),
+                                                 max_pool->get_window_movement_strides(),
+                                                 max_pool->get_padding_below(),
+                                                 max_pool->get_padding_above(),
+                                                 min,
+                                                 max);
+    }
+    if (auto avg_pool = dynamic_pointer_cast<op::AvgPool>(pool))
+    {
+        return make_shared<op::QuantizedAvgPool>(
+            arg,
+            avg_pool->get_window_shape(),
+            avg_pool->get_window_movement_strides(),
+            avg_pool->get_padding_below(),
+            avg_pool->get_padding_above(),
+            avg_pool->get_include_padding_in_avg_computation(),
+            min,
+            max);
+    }
+    return nullptr;
+}
+
+unordered_map<const Node*, runtime::cpu::pass::CPUQuantization::TensorStats>
+    runtime::cpu::pass::CPUQuantization::calibrate(shared_ptr<Function> f,
+                                                   const NodeVector& tensors)
+{
+    if (m_calibration_inputs.empty())
+    {
+        throw ngraph_error("Quantization needs at least one set of calibration inputs");
+    }
+
+    // Run a copy of f that returns the watched tensors
+    NodeMap node_map;
+    auto clone = clone_function(*f, node_map);
+    NodeVector results;
+    for (const shared_ptr<Node>& tensor : tensors)
+    {
+        results.push_back(node_map.get(tensor));
+    }
+    auto calibration_f = make_shared<Function>(results, clone->get_parameters());
+
+    auto backend = runtime::Backend::create(m_backend_name);
+    vector<shared_ptr<runtime::TensorView>> args;
+    for (const shared_ptr<op::Parameter>& param : calibration_f->get_parameters())
+    {
+        if (param->get_element_type() != element::f32)
+        {
+            throw ngraph_error("Quantization calibration supports only f32 parameters");
+        }
+        args.push_back(backend->create_tensor(element::f32, param->get_shape()));
+    }
+    vector<shared_ptr<runtime::TensorView>> outputs;
+    for (const shared_ptr<Node>& result : results)
+    {
+        outputs.push_back(backend->create_tensor(element::f32, result->get_shape()));
+    }
+
+    // Calls calibration_f on every set of inputs and passes the outputs to observe
+    auto run = [&](const function<void(size_t, const vector<float>&)>& observe) {
+        for (const CalibrationInputs& inputs : m_calibration_inputs)
+        {
+            if (inputs.size() != args.size())
+            {
+                throw ngraph_error("Calibration inputs don't match the function's parameters");
+            }
+            for (size_t i = 0; i < args.size(); i++)
+            {
+                if (inputs[i].size() != shape_size(args[i]->get_shape()))
+                {
+                    throw ngraph_error("Calibration input has the wrong number of elements");
+                }
+                args[i]->write(inputs[i].data(), 0, inputs[i].size() * sizeof(float));
+            }
+            backend->call(calibration_f, outputs, args);
+            for (size_t i = 0; i < outputs.size(); i++)
+            {
+                vector<float> values(shape_size(outputs[i]->get_shape()));
+                outputs[i]->read(values.data(), 0, values.size() * sizeof(float));
+                observe(i, values);
+            }
+        }
+    };
+
+    vector<TensorStats> stats(tensors.size());
+    for (TensorStats& s : stats)
+    {
+        s.min = numeric_limits<float>::max();
+        s.max = numeric_limits<float>::lowest();
+    }
+    run([&](size_t i, const vector<float>& values) {
+        for (float value : values)
+        {
+            stats[i].min = min(stats[i].min, value);
+            stats[i].max = max(stats[i].max, value);
+        }
+    });
+
+    // The histogram bins depend on the full range, so they take a second round of calls
+    if (m_calibration == Calibration::KLDivergence)
+    {
+        for (TensorStats& s : stats)
+        {
+            s.histogram.resize(s_histogram_bins);
+        }
+        run([&](size_t i, const vector<float>& values) {
+            float max_abs = max(-stats[i].min, stats[i].max);
+            for (float value : values)
+            {
+                size_t bin = max_abs > 0 ? static_cast<size_t>(abs(value) / max_abs *
+                                                               s_histogram_bins)
+                                         : 0;
+                stats[i].histogram[min(bin, s_histogram_bins - 1)]++;
+            }
+        });
+    }
+
+    unordered_map<const Node*, TensorStats> tensor_stats;
+    for (size_t i = 0; i < tensors.size(); i++)
+    {
+        tensor_stats[tensors[i].get()] = move(stats[i]);
+    }
+    return tensor_stats;
+}
+
+float runtime::cpu::pass::CPUQuantization::get_threshold(const TensorStats& stats,
+                                                          size_t levels) const
+{
+    float max_abs = max(-stats.min, stats.max);
+    if (m_calibration == Calibration::KLDivergence)
+    {
+        return quantization_util::get_kl_divergence_threshold(stats.histogram, max_abs, levels);
+    }
+    return max_abs;
+}
+
+// Relu commutes with max pooling, so Relu(MaxPool(x)) becomes MaxPool(Relu(x)), where the Relu
+// can be fused into the op that computes x
+static bool move_relus_before_max_pools(const shared_ptr<Function>& f)
+{
+    bool replaced = false;
+    for (const shared_ptr<Node>& n : f->get_ordered_ops())
+    {
+        if (!dynamic_pointer_cast<op::Relu>(n))
+        {
+            continue;
+        }
+        auto pool = dynamic_pointer_cast<op::MaxPool>(n->get_argument(0));
+        if (!pool || pool->get_users().size() != 1)
+        {
+            continue;
+        }
+        auto relu = make_shared<op::Relu>(pool->get_argument(0));
+        replace_node(n, pool->copy_with_new_args({relu}));
+        replaced = true;
+    }
+    return replaced;
+}
+
+// A tensor of the function that is computed in int8
+struct QuantizedTensor
+{
+    // u8 or i8
+    shared_ptr<Node> node;
+    // The value of the largest quantized number
+    float max;
+};
+
+// The value of the smallest quantized number
+static float get_min(const QuantizedTensor& tensor)
+{
+    return tensor.node->get_element_type() == element::u8 ? 0 : -tensor.max;
+}
+
+bool runtime::cpu::pass::CPUQuantization::run_on_function(shared_ptr<Function> f)
+{
+    bool replaced = move_relus_before_max_pools(f);
+
+    // Calibrate the inputs and outputs of every op that gets an int8 kernel, and their
+    // weights unless they are constant
+    list<shared_ptr<Node>> ops = f->get_ordered_ops();
+    unordered_map<const Node*, QuantizationCandidate> candidates;
+    NodeVector tensors;
+    unordered_set<const Node*> watched;
+    auto watch = [&](const shared_ptr<Node>& tensor) {
+        if (watched.insert(tensor.get()).second)
+        {
+            tensors.push_back(tensor);
+        }
+    };
+    for (const shared_ptr<Node>& n : ops)
+    {
+        QuantizationCandidate candidate;
+        if (get_quantization_candidate(n, candidate))
+        {
+            candidates[n.get()] = candidate;
+            watch(candidate.data);
+            watch(candidate.output);
+            if (!candidate.weights->is_constant())
+            {
+                watch(candidate.weights);
+            }
+        }
+    }
+    if (candidates.empty())
+    {
+        return replaced;
+    }
+    auto stats = calibrate(f, tensors);
+
+    // The int8 tensor that each Dequantize inserted by the pass converts. Quantized ops read
+    // it directly, so the function only converts to and from f32 where int8 ops start and end.
+    // Ops are rewritten in order, so their arguments are the Dequantize ops by then.
+    unordered_map<const Node*, QuantizedTensor> quantized;
+    // Quantize ops of f32 tensors that int8 ops read, shared between the ops
+    unordered_map<const Node*, QuantizedTensor> quantized_inputs;
+    auto dequantize = [&](const shared_ptr<Node>& n, const QuantizedTensor& tensor) {
+        const element::Type& type = tensor.node->get_element_type();
+        auto dequantized = make_shared<op::Dequantize>(
+            tensor.node, make_scalar(get_min(tensor)), make_scalar(tensor.max), type);
+        quantized[dequantized.get()] = tensor;
+        replace_node(n, dequantized);
+    };
+    for (const shared_ptr<Node>& n : ops)
+    {
+        // Pooling commutes with dequantization, so it runs on the quantized tensor
+        if (dynamic_pointer_cast<op::MaxPool>(n) || dynamic_pointer_cast<op::AvgPool>(n))
+        {
+            auto input = quantized.find(n->get_argument(0).get());
+            if (input == quantized.end())
+            {
+                continue;
+            }
+            const QuantizedTensor& tensor = input->second;
+            auto pool = make_quantized_pool(
+                n, tensor.node, make_scalar(get_min(tensor)), make_scalar(tensor.max));
+            dequantize(n, {make_shared<op::GetOutputElement>(pool, 0), tensor.max});
+            replaced = true;
+            continue;
+        }
+
+        auto it = candidates.find(n.get());
+        if (it == candidates.end())
+        {
+            continue;
+        }
+        const QuantizationCandidate& candidate = it->second;
+
+        // The int8 kernels take unsigned data. The arguments are read from the op rather
+        // than the candidate, because the ops that computed them may have been replaced.
+        shared_ptr<Node> data_arg = candidate.op->get_argument(0);
+        shared_ptr<Node> weights_arg = candidate.op->get_argument(1);
+        shared_ptr<Node> quantized_data;
+        float data_max;
+        auto data = quantized.find(data_arg.get());
+        if (data != quantized.end() && data->second.node->get_element_type() == element::u8)
+        {
+            quantized_data = data->second.node;
+            data_max = data->second.max;
+        }
+        else
+        {
+            const TensorStats& data_stats = stats.at(candidate.data.get());
+            if (data_stats.min < 0)
+            {
+                NGRAPH_DEBUG << "Not quantizing " << candidate.op->get_name()
+                             << ", its input is signed";
+                continue;
+            }
+            QuantizedTensor& input = quantized_inputs[data_arg.get()];
+            if (!input.node)
+            {
+                input.max = get_quantize_max(0, get_threshold(data_stats, 256), false);
+                auto quantize = make_shared<op::Quantize>(data_arg,
+                                                          make_scalar(0),
+                                                          make_scalar(input.max),
+                                                          element::u8);
+                input.node = make_shared<op::GetOutputElement>(quantize, 0);
+            }
+            quantized_data = input.node;
+            data_max = input.max;
+        }
+
+        float weights_max;
+        shared_ptr<Node> quantized_weights;
+        auto weights = quantized.find(weights_arg.get());
+        if (auto constant = dynamic_pointer_cast<op::Constant>(candidate.weights))
+        {
+            vector<float> values = constant->get_vector<float>();
+            float max_abs = 0;
+            for (float value : values)
+            {
+                max_abs = max(max_abs, abs(value));
+            }
+            weights_max = get_quantize_max(-max_abs, max_abs, true);
+
+            vector<int8_t> quantized_values(values.size());
+            for (size_t i = 0; i < values.size(); i++)
+            {
+                float value = round(values[i] * 127 / weights_max);
+                quantized_values[i] = static_cast<int8_t>(min(max(value, -127.0f), 127.0f));
+            }
+            quantized_weights = make_shared<op::Constant>(
+                element::i8, constant->get_shape(), quantized_values);
+        }
+        else if (weights != quantized.end() &&
+                 weights->second.node->get_element_type() == element::i8)
+        {
+            quantized_weights = weights->second.node;
+            weights_max = weights->second.max;
+        }
+        else
+        {
+            const TensorStats& weights_stats = stats.at(candidate.weights.get());
+            float max_abs = max(-weights_stats.min, weights_stats.max);
+            weights_max = get_quantize_max(-max_abs, max_abs, true);
+            auto quantize = make_shared<op::Quantize>(weights_arg,
+                                                      make_scalar(-weights_max),
+                                                      make_scalar(weights_max),
+                                                      element::i8);
+            quantized_weights = make_shared<op::GetOutputElement>(quantize, 0);
+        }
+
+        // A fused Relu makes the output unsigned, which doubles its resolution
+        const TensorStats& output_stats = stats.at(candidate.output.get());
+        float output_max = get_threshold(output_stats, candidate.relu ? 256 : 128);
+        float output_min = candidate.relu ? 0 : -output_max;
+        output_max = get_quantize_max(output_min, output_max, !candidate.relu);
+        output_min = candidate.relu ? 0 : -output_max;
+        shared_ptr<Node> quantized_op;
+        float dequantize_max = output_max;
+        if (auto conv = dynamic_pointer_cast<op::Convolution>(candidate.op))
+        {
+            quantized_op =
+                make_shared<op::QuantizedConvolution>(quantized_data,
+                                                      quantized_weights,
+                                                      conv->get_window_movement_strides(),
+                                                      conv->get_window_dilation_strides(),
+                                                      conv->get_padding_below(),
+                                                      conv->get_padding_above(),
+                                                      conv->get_data_dilation_strides(),
+                                                      make_scalar(0),
+                                                      make_scalar(data_max),
+                                                      make_scalar(-weights_max),
+                                                      make_scalar(weights_max),
+                                                      make_scalar(output_min),
+                                                      make_scalar(output_max),
+                                                      candidate.relu);
+            // quantization_util::get_scale spreads the i8 filters over 255 levels where they
+            // use 254, so the requantized output maps output_max to 255 * 254 / 255 as u8,
+            // which is the u8 Dequantize range, and to 127.5 as i8. Only the i8 range is
+            // scaled to the 127 levels that Dequantize expects.
+            if (!candidate.relu)
+            {
+                dequantize_max = output_max * 127 / 127.5f;
+            }
+        }
+        else
+        {
+            quantized_op = make_shared<op::QuantizedDot>(
+                quantized_data,
+                quantized_weights,
+                make_scalar(0),
+                make_scalar(data_max),
+                make_scalar(-weights_max),
+                make_scalar(weights_max),
+                make_scalar(output_min),
+                make_scalar(output_max),
+                candidate.bias_broadcast ? candidate.bias_broadcast->get_argument(0) : nullptr,
+                candidate.relu);
+        }
+
+        dequantize(candidate.output,
+                   {make_shared<op::GetOutputElement>(quantized_op, 0), dequantize_max});
+        replaced = true;
+    }
+
+    return replaced;
+}
@@ -0,0 +1,95 @@
+//*****************************************************************************
+// Copyright 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ngraph/pass/pass.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            namespace pass
+            {
+                class CPUQuantization;
+            }
+        }
+    }
+}
+
+/// \brief Post-training int8 quantization of an f32 function.
+///
+/// Runs the function on the calibration inputs to measure the range of the input and output
+/// of every convolution and matrix product, then replaces each of them with non-negative
+/// input by a u8 x i8 QuantizedConvolution or QuantizedDot. A bias added to a matrix product
+/// and a Relu after either op are fused into the quantized op; with a Relu it outputs u8
+/// that the next quantized op reads directly. Pooling of a quantized tensor runs on int8, and
+/// a Relu after a max pool is moved before it so that it can be fused. The function converts
+/// to and from f32 only where a chain of int8 ops starts and ends: inputs shared by several
+/// ops are quantized once and constant weights are quantized when the pass runs.
+class ngraph::runtime::cpu::pass::CPUQuantization : public ngraph::pass::FunctionPass
+{
+public:
+    /// Inputs for one call of the function, one vector per parameter
+    using CalibrationInputs = std::vector<std::vector<float>>;
+
+    /// How the quantization range of a tensor is chosen from the calibration runs
+    enum class Calibration
+    {
+        // Largest magnitude seen
+        MinMax,
+        // Clipping threshold that minimizes the KL divergence between the distribution of
+        // the values and of their quantization. Ignores rare outliers.
+        KLDivergence
+    };
+
+    CPUQuantization(const std::vector<CalibrationInputs>& calibration_inputs,
+                    Calibration calibration = Calibration::MinMax,
+                    const std::string& backend_name = "CPU")
+        : FunctionPass()
+        , m_calibration_inputs(calibration_inputs)
+        , m_calibration(calibration)
+        , m_backend_name(backend_name)
+    {
+    }
+
+    virtual bool run_on_function(std::shared_ptr<ngraph::Function> f);
+
+private:
+    struct TensorStats
+    {
+        float min;
+        float max;
+        // Histogram of |x| over [0, max(-min, max)], only collected for KLDivergence
+        std::vector<uint64_t> histogram;
+    };
+
+    std::unordered_map<const Node*, TensorStats> calibrate(std::shared_ptr<Function> f,
+                                                           const NodeVector& tensors);
+    // Magnitude that is quantized to the largest of levels values
+    float get_threshold(const TensorStats& stats, size_t levels) const;
+
+    std::vector<CalibrationInputs> m_calibration_inputs;
+    Calibration m_calibration;
+    std::string m_backend_name;
+};
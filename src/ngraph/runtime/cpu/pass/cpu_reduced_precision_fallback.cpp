@@ -0,0 +1,126 @@
+//*****************************************************************************
+// Copyright 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_set>
+
+#include "ngraph/runtime/cpu/pass/cpu_reduced_precision_fallback.hpp"
+#include "ngraph/graph_util.hpp"
+#include "ngraph/op/broadcast.hpp"
+#include "ngraph/op/concat.hpp"
+#include "ngraph/op/convert.hpp"
+#include "ngraph/op/get_output_element.hpp"
+#include "ngraph/op/pad.hpp"
+#include "ngraph/op/replace_slice.hpp"
+#include "ngraph/op/reshape.hpp"
+#include "ngraph/op/reverse.hpp"
+#include "ngraph/op/select.hpp"
+#include "ngraph/op/slice.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+#define TI(x) type_index(typeid(x))
+
+// Ops that only copy elements; their kernels move 16-bit floats as they are
+static const unordered_set<type_index> s_data_movement_ops{TI(op::Broadcast),
+                                                           TI(op::Concat),
+                                                           TI(op::GetOutputElement),
+                                                           TI(op::Pad),
+                                                           TI(op::ReplaceSlice),
+                                                           TI(op::Reshape),
+                                                           TI(op::Reverse),
+                                                           TI(op::Select),
+                                                           TI(op::Slice)};
+
+static bool is_reduced_precision(const element::Type& type)
+{
+    return type == element::bf16 || type == element::f16;
+}
+
+static bool has_reduced_precision_tensors(const Node& node)
+{
+    for (const descriptor::Input& input : node.get_inputs())
+    {
+        if (is_reduced_precision(input.get_element_type()))
+        {
+            return true;
+        }
+    }
+    for (const descriptor::Output& output : node.get_outputs())
+    {
+        if (is_reduced_precision(output.get_element_type()))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Rounds an f32 result back to the type that the original op produced
+static shared_ptr<Node> convert_result(const shared_ptr<Node>& result, const element::Type& type)
+{
+    return is_reduced_precision(type) ? make_shared<op::Convert>(result, type) : result;
+}
+
+bool runtime::cpu::pass::CPUReducedPrecisionFallback::run_on_function(shared_ptr<Function> function)
+{
+    bool replaced = false;
+    for (const shared_ptr<Node>& node : function->get_ordered_ops())
+    {
+        // These only move the 16-bit data around
+        if (node->is_parameter() || node->is_constant() || node->is_output() ||
+            dynamic_pointer_cast<op::Convert>(node) ||
+            s_data_movement_ops.count(TI(*node)) != 0 || !has_reduced_precision_tensors(*node))
+        {
+            continue;
+        }
+
+        NodeVector f32_args;
+        for (const descriptor::Input& input : node->get_inputs())
+        {
+            shared_ptr<Node> arg = input.get_output().get_node();
+            if (is_reduced_precision(input.get_element_type()))
+            {
+                arg = make_shared<op::Convert>(arg, element::f32);
+            }
+            f32_args.push_back(arg);
+        }
+        shared_ptr<Node> f32_node = node->copy_with_new_args(f32_args);
+
+        if (node->get_output_size() == 1)
+        {
+            replace_node(node, convert_result(f32_node, node->get_element_type()));
+        }
+        else
+        {
+            for (const shared_ptr<Node>& user : node->get_users())
+            {
+                auto goe = dynamic_pointer_cast<op::GetOutputElement>(user);
+                if (!goe)
+                {
+                    throw ngraph_error("Outputs of " + node->get_name() +
+                                       " are not all used through GetOutputElement");
+                }
+                auto f32_goe = make_shared<op::GetOutputElement>(f32_node, goe->get_n());
+                replace_node(goe, convert_result(f32_goe, goe->get_element_type()));
+            }
+        }
+        replaced = true;
+    }
+    return replaced;
+}
@@ -0,0 +1,43 @@
+//*****************************************************************************
+// Copyright 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include "ngraph/pass/pass.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            namespace pass
+            {
+                /// \brief Runs ops on bf16 and f16 tensors in f32. The CPU kernels, MKL-DNN
+                ///        and CBLAS only compute in f32, so every op that computes on a 16-bit
+                ///        float tensor is replaced by its f32 version between Converts. Its
+                ///        output is rounded back to 16 bits, so tensors between ops keep the
+                ///        type and rounding of the original graph. Ops that only move data,
+                ///        such as Reshape or Concat, run on the 16-bit tensors directly.
+                class CPUReducedPrecisionFallback : public ngraph::pass::FunctionPass
+                {
+                public:
+                    bool run_on_function(std::shared_ptr<ngraph::Function> function) override;
+                };
+            }
+        }
+    }
+}
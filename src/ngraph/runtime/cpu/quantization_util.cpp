@@ -14,6 +14,9 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <cmath>
+#include <limits>
+
 #include "quantization_util.hpp"
 #include "ngraph/runtime/cpu/op/quantized_conv.hpp"
 
@@ -42,14 +45,91 @@ namespace ngraph
                     const float max_abs8 =
                         std::max(std::abs(qconvolution->get_freezed_output_min()),
                                  std::abs(qconvolution->get_freezed_output_max()));
-                    // Output is signed int.
+                    // Output is signed int, or unsigned with a fused Relu.
                     // s32 = f32 * std::pow(2, 31)/ max_abs32;
                     // s8 = f32 * std::pow(2, 7)/ max_abs8;
                     // s8 = s32 * std::pow(2, -24) * max_abs32 / max_abs8;
+                    // u8 = s32 * std::pow(2, -23) * max_abs32 / max_abs8;
+                    const int exponent = qconvolution->with_relu() ? -23 : -24;
                     const float scale = static_cast<float>(
-                        (std::pow(2, -24) * static_cast<double>(max_abs32 / max_abs8)));
+                        (std::pow(2, exponent) * static_cast<double>(max_abs32 / max_abs8)));
                     return scale;
                 }
+
+                float get_kl_divergence_threshold(const std::vector<uint64_t>& histogram,
+                                                  float max_abs,
+                                                  size_t levels)
+                {
+                    // Candidate thresholds are the bin edges from levels bins up, as in
+                    // TensorRT's int8 calibration
+                    size_t bins = histogram.size();
+                    double total = 0;
+                    for (uint64_t count : histogram)
+                    {
+                        total += count;
+                    }
+                    if (bins <= levels || total == 0)
+                    {
+                        return max_abs;
+                    }
+
+                    size_t best_bins = bins;
+                    double best_divergence = std::numeric_limits<double>::infinity();
+                    std::vector<double> p(bins);
+                    std::vector<double> q(bins);
+                    for (size_t i = levels; i <= bins; i++)
+                    {
+                        // Values above the threshold are clipped to it
+                        std::fill(p.begin(), p.end(), 0);
+                        for (size_t j = 0; j < bins; j++)
+                        {
+                            p[std::min(j, i - 1)] += histogram[j];
+                        }
+
+                        // Each level spreads its count evenly over the nonempty bins it merges
+                        double q_total = 0;
+                        for (size_t level = 0; level < levels; level++)
+                        {
+                            size_t begin = level * i / levels;
+                            size_t end = (level + 1) * i / levels;
+                            double count = 0;
+                            size_t nonempty = 0;
+                            for (size_t j = begin; j < end; j++)
+                            {
+                                count += histogram[j];
+                                nonempty += p[j] != 0;
+                            }
+                            for (size_t j = begin; j < end; j++)
+                            {
+                                q[j] = p[j] != 0 ? count / nonempty : 0;
+                            }
+                            q_total += count;
+                        }
+
+                        double divergence = 0;
+                        for (size_t j = 0; j < i; j++)
+                        {
+                            if (p[j] == 0)
+                            {
+                                continue;
+                            }
+                            // Levels that only hold clipped values rule the threshold out
+                            if (q[j] == 0)
+                            {
+                                divergence = std::numeric_limits<double>::infinity();
+                                break;
+                            }
+                            divergence +=
+                                p[j] / total * std::log((p[j] / total) / (q[j] / q_total));
+                        }
+                        if (divergence < best_divergence)
+                        {
+                            best_divergence = divergence;
+                            best_bins = i;
+                        }
+                    }
+                    return max_abs * best_bins / bins;
+                }
             }
         }
     }
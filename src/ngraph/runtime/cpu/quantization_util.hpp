@@ -90,6 +90,15 @@ namespace ngraph
                 }
 
                 float get_scale(const ngraph::Node* node);
+
+                /// \brief Returns the clipping threshold for quantizing a tensor to levels
+                ///        magnitudes that minimizes the KL divergence between the clipped
+                ///        and the quantized distribution of |x|. histogram[i] counts the
+                ///        values with |x| in bin i of histogram.size() equal bins over
+                ///        [0, max_abs].
+                float get_kl_divergence_threshold(const std::vector<uint64_t>& histogram,
+                                                  float max_abs,
+                                                  size_t levels);
             }
         }
     }
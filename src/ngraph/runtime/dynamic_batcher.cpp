@@ -0,0 +1,238 @@
+//*****************************************************************************
+// Copyright 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <set>
+#include <sstream>
+
+#include "ngraph/except.hpp"
+#include "ngraph/graph_util.hpp"
+#include "ngraph/op/parameter.hpp"
+#include "ngraph/runtime/dynamic_batcher.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+runtime::DynamicBatcher::DynamicBatcher(const shared_ptr<Backend>& backend,
+                                        const shared_ptr<Function>& func,
+                                        const vector<size_t>& batch_sizes,
+                                        chrono::microseconds max_latency)
+    : m_backend(backend)
+    , m_max_latency(max_latency)
+    , m_shutdown(false)
+{
+    initialize(
+        [func](size_t batch_size) {
+            return batch_size == 1 ? func : rebatch_function(*func, batch_size);
+        },
+        batch_sizes);
+}
+
+runtime::DynamicBatcher::DynamicBatcher(const shared_ptr<Backend>& backend,
+                                        const FunctionFactory& factory,
+                                        const vector<size_t>& batch_sizes,
+                                        chrono::microseconds max_latency)
+    : m_backend(backend)
+    , m_max_latency(max_latency)
+    , m_shutdown(false)
+{
+    initialize(factory, batch_sizes);
+}
+
+runtime::DynamicBatcher::~DynamicBatcher()
+{
+    {
+        lock_guard<mutex> lock(m_queue_mutex);
+        m_shutdown = true;
+    }
+    m_queue_changed.notify_all();
+    m_worker.join();
+}
+
+shared_ptr<Function> runtime::DynamicBatcher::rebatch_function(const Function& func,
+                                                               size_t batch_size)
+{
+    NodeMap node_map;
+    for (auto param : func.get_parameters())
+    {
+        Shape shape = param->get_shape();
+        if (shape.empty())
+        {
+            throw ngraph_error("Cannot batch scalar parameter " + param->get_name());
+        }
+        shape[0] *= batch_size;
+        node_map.add(param,
+                     make_shared<op::Parameter>(
+                         param->get_element_type(), shape, param->get_cacheable()));
+    }
+    return clone_function(func, node_map);
+}
+
+void runtime::DynamicBatcher::initialize(const FunctionFactory& factory,
+                                         const vector<size_t>& batch_sizes)
+{
+    set<size_t> sizes(batch_sizes.begin(), batch_sizes.end());
+    sizes.insert(1);
+    sizes.erase(0);
+
+    shared_ptr<Function> base = factory(1);
+    for (size_t batch_size : sizes)
+    {
+        Variant& variant = m_variants[batch_size];
+        variant.function = batch_size == 1 ? base : factory(batch_size);
+
+        const auto& params = variant.function->get_parameters();
+        if (params.size() != base->get_parameters().size() ||
+            variant.function->get_output_size() != base->get_output_size())
+        {
+            throw ngraph_error("Batched function signature does not match the base function");
+        }
+        for (size_t i = 0; i < params.size(); i++)
+        {
+            const Shape& shape = params[i]->get_shape();
+            if (shape_size(shape) != shape_size(base->get_parameters()[i]->get_shape()) * batch_size)
+            {
+                stringstream ss;
+                ss << "Parameter " << i << " of the batch " << batch_size
+                   << " function has shape " << shape << " which is not a batch of "
+                   << base->get_parameters()[i]->get_shape();
+                throw ngraph_error(ss.str());
+            }
+            variant.inputs.push_back(
+                m_backend->create_tensor(params[i]->get_element_type(), shape));
+        }
+        for (size_t i = 0; i < variant.function->get_output_size(); i++)
+        {
+            const Shape& shape = variant.function->get_output_shape(i);
+            if (shape_size(shape) != shape_size(base->get_output_shape(i)) * batch_size)
+            {
+                stringstream ss;
+                ss << "Output " << i << " of the batch " << batch_size << " function has shape "
+                   << shape << " which is not a batch of " << base->get_output_shape(i);
+                throw ngraph_error(ss.str());
+            }
+            variant.outputs.push_back(
+                m_backend->create_tensor(variant.function->get_output_element_type(i), shape));
+        }
+
+        m_backend->compile(variant.function);
+    }
+
+    m_worker = thread(&DynamicBatcher::run, this);
+}
+
+void runtime::DynamicBatcher::call(const vector<shared_ptr<runtime::TensorView>>& outputs,
+                                   const vector<shared_ptr<runtime::TensorView>>& inputs)
+{
+    const Variant& base = m_variants.begin()->second;
+    if (inputs.size() != base.inputs.size() || outputs.size() != base.outputs.size())
+    {
+        throw ngraph_error("Request does not match the signature of the batched function");
+    }
+
+    auto request = make_shared<Request>();
+    request->outputs = &outputs;
+    request->inputs = &inputs;
+    future<void> done = request->done.get_future();
+    {
+        lock_guard<mutex> lock(m_queue_mutex);
+        request->enqueue_time = chrono::steady_clock::now();
+        m_queue.push_back(request);
+    }
+    m_queue_changed.notify_all();
+    done.get();
+}
+
+void runtime::DynamicBatcher::run()
+{
+    size_t max_batch_size = get_max_batch_size();
+    while (true)
+    {
+        vector<shared_ptr<Request>> batch;
+        {
+            unique_lock<mutex> lock(m_queue_mutex);
+            m_queue_changed.wait(lock, [this] { return m_shutdown || !m_queue.empty(); });
+            if (m_queue.empty())
+            {
+                return;
+            }
+
+            // The oldest request defines the deadline for the whole batch. It may have waited
+            // already while the previous batch executed.
+            auto deadline = m_queue.front()->enqueue_time + m_max_latency;
+            m_queue_changed.wait_until(lock, deadline, [this, max_batch_size] {
+                return m_shutdown || m_queue.size() >= max_batch_size;
+            });
+
+            size_t count = min(m_queue.size(), max_batch_size);
+            batch.assign(m_queue.begin(), m_queue.begin() + count);
+            m_queue.erase(m_queue.begin(), m_queue.begin() + count);
+        }
+        execute(batch);
+    }
+}
+
+void runtime::DynamicBatcher::execute(vector<shared_ptr<Request>>& batch)
+{
+    // Smallest compiled variant that holds the whole batch; unused rows are left as they are
+    // and their results discarded
+    Variant& variant = m_variants.lower_bound(batch.size())->second;
+    const Variant& base = m_variants.begin()->second;
+
+    try
+    {
+        vector<char> staging;
+        for (size_t i = 0; i < variant.inputs.size(); i++)
+        {
+            const auto& tensor = base.inputs[i]->get_tensor();
+            size_t row_bytes = shape_size(tensor.get_shape()) * tensor.get_element_type().size();
+            staging.resize(row_bytes);
+            for (size_t row = 0; row < batch.size(); row++)
+            {
+                batch[row]->inputs->at(i)->read(staging.data(), 0, row_bytes);
+                variant.inputs[i]->write(staging.data(), row * row_bytes, row_bytes);
+            }
+            variant.inputs[i]->set_stale(true);
+        }
+
+        m_backend->call(variant.function, variant.outputs, variant.inputs);
+
+        for (size_t i = 0; i < variant.outputs.size(); i++)
+        {
+            const auto& tensor = base.outputs[i]->get_tensor();
+            size_t row_bytes = shape_size(tensor.get_shape()) * tensor.get_element_type().size();
+            staging.resize(row_bytes);
+            for (size_t row = 0; row < batch.size(); row++)
+            {
+                variant.outputs[i]->read(staging.data(), row * row_bytes, row_bytes);
+                batch[row]->outputs->at(i)->write(staging.data(), 0, row_bytes);
+            }
+        }
+    }
+    catch (...)
+    {
+        for (auto& request : batch)
+        {
+            request->done.set_exception(current_exception());
+        }
+        return;
+    }
+
+    for (auto& request : batch)
+    {
+        request->done.set_value();
+    }
+}
@@ -0,0 +1,122 @@
+//*****************************************************************************
+// Copyright 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ngraph/function.hpp"
+#include "ngraph/runtime/backend.hpp"
+#include "ngraph/runtime/tensor_view.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        class DynamicBatcher;
+    }
+}
+
+/// \brief Collects concurrent requests for one Function and executes them as a single call
+///     on a larger-batch variant of that Function.
+///
+/// Axis 0 of every Parameter and Result is treated as the batch axis. Requests are expressed
+/// in terms of the base Function's shapes; up to `max_batch_size` requests that arrive within
+/// `max_latency` of the first one are concatenated along axis 0, executed together and the
+/// results are scattered back. Variants for each allowed batch size are compiled up front so
+/// the serving path never recompiles. Rows of a batch must not depend on each other.
+class ngraph::runtime::DynamicBatcher
+{
+public:
+    /// \brief Builds the variant of the Function that handles `batch_size` requests at once.
+    using FunctionFactory = std::function<std::shared_ptr<Function>(size_t batch_size)>;
+
+    /// \brief Create a batcher that derives batched variants by cloning `func` with axis 0 of
+    ///     every Parameter scaled by the batch size. Graphs containing ops with explicit
+    ///     output shapes (e.g. Reshape, Broadcast) cannot be rescaled this way; use the
+    ///     FunctionFactory constructor for those.
+    /// \param backend The backend used to compile and execute every variant.
+    /// \param func The Function that serves a single request.
+    /// \param batch_sizes The numbers of requests for which a variant is compiled.
+    /// \param max_latency The longest time the first request of a batch waits for others.
+    DynamicBatcher(const std::shared_ptr<Backend>& backend,
+                   const std::shared_ptr<Function>& func,
+                   const std::vector<size_t>& batch_sizes,
+                   std::chrono::microseconds max_latency);
+
+    /// \brief Create a batcher whose variants are built by `factory`. `factory(1)` defines
+    ///     the per-request shapes.
+    DynamicBatcher(const std::shared_ptr<Backend>& backend,
+                   const FunctionFactory& factory,
+                   const std::vector<size_t>& batch_sizes,
+                   std::chrono::microseconds max_latency);
+
+    ~DynamicBatcher();
+
+    DynamicBatcher(const DynamicBatcher&) = delete;
+    DynamicBatcher& operator=(const DynamicBatcher&) = delete;
+
+    /// \brief Execute one request. Blocks until the batch containing it has completed.
+    ///     May be called from any number of threads.
+    /// \param outputs Tensors shaped like the base Function's Results
+    /// \param inputs Tensors shaped like the base Function's Parameters
+    void call(const std::vector<std::shared_ptr<runtime::TensorView>>& outputs,
+              const std::vector<std::shared_ptr<runtime::TensorView>>& inputs);
+
+    /// \brief Create a copy of `func` with axis 0 of every Parameter multiplied by
+    ///     `batch_size`. Shapes of all other ops are re-inferred from the new Parameters.
+    static std::shared_ptr<Function> rebatch_function(const Function& func, size_t batch_size);
+
+    size_t get_max_batch_size() const { return m_variants.rbegin()->first; }
+private:
+    struct Request
+    {
+        const std::vector<std::shared_ptr<runtime::TensorView>>* outputs;
+        const std::vector<std::shared_ptr<runtime::TensorView>>* inputs;
+        std::promise<void> done;
+        std::chrono::steady_clock::time_point enqueue_time;
+    };
+
+    struct Variant
+    {
+        std::shared_ptr<Function> function;
+        std::vector<std::shared_ptr<runtime::TensorView>> inputs;
+        std::vector<std::shared_ptr<runtime::TensorView>> outputs;
+    };
+
+    void initialize(const FunctionFactory& factory, const std::vector<size_t>& batch_sizes);
+    void run();
+    void execute(std::vector<std::shared_ptr<Request>>& batch);
+
+    std::shared_ptr<Backend> m_backend;
+    std::chrono::microseconds m_max_latency;
+    std::map<size_t, Variant> m_variants;
+
+    std::mutex m_queue_mutex;
+    std::condition_variable m_queue_changed;
+    std::deque<std::shared_ptr<Request>> m_queue;
+    bool m_shutdown;
+    std::thread m_worker;
+};
@@ -14,22 +14,32 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <set>
+
 #include "ngraph/runtime/interpreter/int_backend.hpp"
 #include "ngraph/descriptor/layout/dense_tensor_layout.hpp"
 #include "ngraph/except.hpp"
 #include "ngraph/op/convert.hpp"
 #include "ngraph/op/select.hpp"
+#include "ngraph/op/util/arithmetic_reduction.hpp"
 #include "ngraph/op/util/binary_elementwise_comparison.hpp"
 #include "ngraph/pass/assign_layout.hpp"
+#include "ngraph/pass/constant_folding.hpp"
 #include "ngraph/pass/like_replacement.hpp"
 #include "ngraph/pass/liveness.hpp"
 #include "ngraph/pass/manager.hpp"
+#include "ngraph/runtime/interpreter/thread_pool.hpp"
 #include "ngraph/util.hpp"
 
 using namespace std;
 using namespace ngraph;
 
 using descriptor::layout::DenseTensorLayout;
+using runtime::interpreter::OP_TYPEID;
 
 extern "C" const char* get_ngraph_version_string()
 {
@@ -60,25 +70,56 @@ shared_ptr<runtime::TensorView> runtime::interpreter::INTBackend::create_tensor(
 
 bool runtime::interpreter::INTBackend::compile(shared_ptr<Function> function)
 {
+    lock_guard<mutex> lock(m_function_map_mutex);
     FunctionInstance& instance = m_function_map[function];
     if (!instance.m_is_compiled)
     {
         instance.m_is_compiled = true;
         pass::Manager pass_manager;
         pass_manager.register_pass<pass::LikeReplacement>();
+        pass_manager.register_pass<pass::ConstantFolding>(
+            vector<pass::ConstantFolding::CFTransformations>{
+                pass::ConstantFolding::CFTransformations::ARITHMETIC});
         pass_manager.register_pass<pass::AssignLayout<DenseTensorLayout>>();
         pass_manager.register_pass<pass::Liveness>();
         pass_manager.run_passes(function);
 
-        for (const shared_ptr<Node>& node : function->get_ordered_ops())
+        unordered_map<const Node*, size_t> node_index;
+        auto ordered_ops = function->get_ordered_ops_view();
+        for (const shared_ptr<Node>& node : *ordered_ops)
         {
+            node_index.insert({node.get(), instance.m_wrapped_nodes.size()});
             instance.m_wrapped_nodes.emplace_back(node);
         }
+
+        instance.m_node_successors.assign(instance.m_wrapped_nodes.size(), {});
+        instance.m_node_predecessor_counts.assign(instance.m_wrapped_nodes.size(), 0);
+        for (size_t i = 0; i < instance.m_wrapped_nodes.size(); i++)
+        {
+            const Node& node = instance.m_wrapped_nodes[i].get_node();
+            set<size_t> predecessors;
+            for (const descriptor::Input& input : node.get_inputs())
+            {
+                predecessors.insert(node_index.at(input.get_output().get_node().get()));
+            }
+            for (size_t predecessor : predecessors)
+            {
+                instance.m_node_successors[predecessor].push_back(i);
+            }
+            instance.m_node_predecessor_counts[i] = predecessors.size();
+        }
     }
 
     return true;
 }
 
+runtime::interpreter::INTBackend::FunctionInstance&
+    runtime::interpreter::INTBackend::get_function_instance(shared_ptr<Function> function)
+{
+    lock_guard<mutex> lock(m_function_map_mutex);
+    return m_function_map[function];
+}
+
 bool runtime::interpreter::INTBackend::call(shared_ptr<Function> function,
                                             const vector<shared_ptr<runtime::TensorView>>& outputs,
                                             const vector<shared_ptr<runtime::TensorView>>& inputs)
@@ -86,7 +127,7 @@ bool runtime::interpreter::INTBackend::call(shared_ptr<Function> function,
     validate_call(function, outputs, inputs);
 
     compile(function);
-    FunctionInstance& instance = m_function_map[function];
+    FunctionInstance& instance = get_function_instance(function);
 
     // convert inputs to HostTensorView
     vector<shared_ptr<runtime::HostTensorView>> func_inputs;
@@ -107,7 +148,7 @@ bool runtime::interpreter::INTBackend::call(shared_ptr<Function> function,
     }
 
     // map function params -> HostTensorView
-    unordered_map<descriptor::TensorView*, shared_ptr<runtime::HostTensorView>> tensor_map;
+    TensorMap tensor_map;
     size_t input_count = 0;
     for (auto param : function->get_parameters())
     {
@@ -130,94 +171,432 @@ bool runtime::interpreter::INTBackend::call(shared_ptr<Function> function,
         tensor_map.insert({tv, func_outputs[output_count]});
     }
 
+    if (instance.m_performance_counters_enabled)
+    {
+        // Create every timer up front so that concurrently running nodes never insert
+        for (const NodeWrapper& wrapped : instance.m_wrapped_nodes)
+        {
+            instance.m_timer_map[&wrapped.get_node()];
+        }
+    }
+
+    if (instance.m_parallel_execution_enabled)
+    {
+        call_parallel(instance, tensor_map);
+    }
+    else
+    {
+        call_sequential(instance, tensor_map);
+    }
+
+    return true;
+}
+
+vector<shared_ptr<runtime::HostTensorView>>
+    runtime::interpreter::INTBackend::get_inputs(const Node& op, const TensorMap& tensor_map)
+{
+    // get op inputs from map
+    vector<shared_ptr<runtime::HostTensorView>> op_inputs;
+    for (const descriptor::Input& input : op.get_inputs())
+    {
+        descriptor::TensorView* tv = input.get_output().get_tensor_ptr().get();
+        op_inputs.push_back(tensor_map.at(tv));
+    }
+    return op_inputs;
+}
+
+vector<shared_ptr<runtime::HostTensorView>>
+    runtime::interpreter::INTBackend::get_outputs(const Node& op, TensorMap& tensor_map)
+{
+    // get op outputs from map or create
+    vector<shared_ptr<runtime::HostTensorView>> op_outputs;
+    for (size_t i = 0; i < op.get_output_size(); ++i)
+    {
+        descriptor::TensorView* tv = op.get_output_tensor_ptr(i).get();
+        shared_ptr<runtime::HostTensorView> htv;
+        auto it = tensor_map.find(tv);
+        if (it == tensor_map.end())
+        {
+            // the output tensor is not in the tensor map so create a new tensor
+            const Shape& shape = op.get_output_shape(i);
+            const element::Type& type = op.get_output_element_type(i);
+            string name = op.get_output_tensor(i).get_name();
+            htv = make_shared<runtime::HostTensorView>(type, shape, name);
+            tensor_map.insert({tv, htv});
+        }
+        else
+        {
+            htv = it->second;
+        }
+        op_outputs.push_back(htv);
+    }
+    return op_outputs;
+}
+
+void runtime::interpreter::INTBackend::call_sequential(FunctionInstance& instance,
+                                                       TensorMap& tensor_map)
+{
     // for each ordered op in the graph
     for (const NodeWrapper& wrapped : instance.m_wrapped_nodes)
     {
         const Node* op = &wrapped.get_node();
-        auto type_id = wrapped.get_typeid();
-        if (type_id == OP_TYPEID::Parameter)
+        if (wrapped.get_typeid() == OP_TYPEID::Parameter)
         {
             continue;
         }
-        // get op inputs from map
-        vector<shared_ptr<runtime::HostTensorView>> op_inputs;
-        for (const descriptor::Input& input : op->get_inputs())
+        vector<shared_ptr<runtime::HostTensorView>> op_inputs = get_inputs(*op, tensor_map);
+        vector<shared_ptr<runtime::HostTensorView>> op_outputs = get_outputs(*op, tensor_map);
+
+        execute_node(instance, wrapped, op_outputs, op_inputs);
+
+        // delete any obsolete tensors
+        for (const descriptor::Tensor* t : op->liveness_free_list)
+        {
+            for (auto it = tensor_map.begin(); it != tensor_map.end(); ++it)
+            {
+                if (it->second->get_tensor().get_name() == t->get_name())
+                {
+                    tensor_map.erase(it);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+void runtime::interpreter::INTBackend::call_parallel(FunctionInstance& instance,
+                                                     TensorMap& tensor_map)
+{
+    ThreadPool& pool = ThreadPool::get_default();
+    size_t node_count = instance.m_wrapped_nodes.size();
+
+    // Liveness frees a tensor after its last reader in the sequential order, which another
+    // reader may outlive here, so tensors are released when their last reader completes.
+    unordered_map<descriptor::TensorView*, size_t> reader_counts;
+    for (const NodeWrapper& wrapped : instance.m_wrapped_nodes)
+    {
+        for (const descriptor::Input& input : wrapped.get_node().get_inputs())
         {
-            descriptor::TensorView* tv = input.get_output().get_tensor_ptr().get();
-            op_inputs.push_back(tensor_map.at(tv));
+            reader_counts[input.get_output().get_tensor_ptr().get()]++;
         }
+    }
 
-        // get op outputs from map or create
-        vector<shared_ptr<runtime::HostTensorView>> op_outputs;
-        for (size_t i = 0; i < op->get_output_size(); ++i)
+    vector<size_t> pending(instance.m_node_predecessor_counts);
+    deque<size_t> ready;
+    for (size_t i = 0; i < node_count; i++)
+    {
+        if (pending[i] == 0)
         {
-            descriptor::TensorView* tv = op->get_output_tensor_ptr(i).get();
-            shared_ptr<runtime::HostTensorView> htv;
-            auto it = tensor_map.find(tv);
-            if (it == tensor_map.end())
+            ready.push_back(i);
+        }
+    }
+
+    mutex state_mutex;
+    condition_variable state_changed;
+    size_t running = 0;
+    size_t completed = 0;
+    exception_ptr error;
+
+    // Called with state_mutex held
+    auto complete_node = [&](size_t i) {
+        for (const descriptor::Input& input : instance.m_wrapped_nodes[i].get_node().get_inputs())
+        {
+            descriptor::TensorView* tv = input.get_output().get_tensor_ptr().get();
+            if (--reader_counts.at(tv) == 0)
             {
-                // the output tensor is not in the tensor map so create a new tensor
-                const Shape& shape = op->get_output_shape(i);
-                const element::Type& type = op->get_output_element_type(i);
-                string name = op->get_output_tensor(i).get_name();
-                htv = make_shared<runtime::HostTensorView>(type, shape, name);
-                tensor_map.insert({tv, htv});
+                tensor_map.erase(tv);
             }
-            else
+        }
+        for (size_t successor : instance.m_node_successors[i])
+        {
+            if (--pending[successor] == 0)
             {
-                htv = it->second;
+                ready.push_back(successor);
             }
-            op_outputs.push_back(htv);
         }
+        completed++;
+    };
 
-        // get op type
-        element::Type type;
-        switch (type_id)
+    unique_lock<mutex> lock(state_mutex);
+    while (completed < node_count)
+    {
+        while (!ready.empty() && running < pool.get_thread_count() && !error)
         {
-        case OP_TYPEID::Convert: type = op->get_input_element_type(0); break;
-        case OP_TYPEID::Equal:
-        case OP_TYPEID::Greater:
-        case OP_TYPEID::GreaterEq:
-        case OP_TYPEID::Less:
-        case OP_TYPEID::LessEq:
-        case OP_TYPEID::NotEqual:
-            // Get the type of the second input, not the first
-            // All BinaryElementwiseComparision ops have the same type for inputs
-            // Select has bool for first input and the type we are interested in for the second
-            type = op->get_input_element_type(1);
-            break;
-        default: type = op->get_outputs().at(0).get_element_type(); break;
+            size_t i = ready.front();
+            ready.pop_front();
+            const NodeWrapper& wrapped = instance.m_wrapped_nodes[i];
+            if (wrapped.get_typeid() == OP_TYPEID::Parameter)
+            {
+                complete_node(i);
+                continue;
+            }
+
+            auto op_inputs = get_inputs(wrapped.get_node(), tensor_map);
+            auto op_outputs = get_outputs(wrapped.get_node(), tensor_map);
+            running++;
+            pool.submit([&, i, op_inputs, op_outputs]() {
+                exception_ptr node_error;
+                try
+                {
+                    execute_node(instance, instance.m_wrapped_nodes[i], op_outputs, op_inputs);
+                }
+                catch (...)
+                {
+                    node_error = current_exception();
+                }
+                lock_guard<mutex> node_lock(state_mutex);
+                if (node_error && !error)
+                {
+                    error = node_error;
+                }
+                complete_node(i);
+                running--;
+                state_changed.notify_all();
+            });
         }
 
-        if (instance.m_performance_counters_enabled)
+        if (error && running == 0)
         {
-            instance.m_timer_map[op].start();
+            rethrow_exception(error);
         }
-        generate_calls(type, wrapped, op_outputs, op_inputs);
-        if (instance.m_performance_counters_enabled)
+        if (completed == node_count)
         {
-            instance.m_timer_map[op].stop();
+            break;
         }
-        if (instance.m_nan_check_enabled)
+
+        // Help the pool while waiting, so that a scheduler running on a pool thread cannot
+        // starve the nodes it waits for
+        size_t seen = completed;
+        lock.unlock();
+        bool ran_task = pool.run_pending_task();
+        lock.lock();
+        if (!ran_task)
         {
-            perform_nan_check(op_outputs, op);
+            state_changed.wait(lock, [&]() { return completed != seen; });
         }
+    }
+}
 
-        // delete any obsolete tensors
-        for (const descriptor::Tensor* t : op->liveness_free_list)
-        {
-            for (auto it = tensor_map.begin(); it != tensor_map.end(); ++it)
+// Nodes are divided into at most one part per this many elements of their first input
+static const size_t s_min_split_elements = 16384;
+
+// Returns the axis along which the first input and every output of a node can be split into
+// parts that are computed independently, after flattening them if flatten is set.
+static bool get_split(const runtime::interpreter::NodeWrapper& wrapped, bool& flatten)
+{
+    const Node& node = wrapped.get_node();
+    flatten = false;
+    switch (wrapped.get_typeid())
+    {
+    case OP_TYPEID::Abs:
+    case OP_TYPEID::Acos:
+    case OP_TYPEID::Add:
+    case OP_TYPEID::And:
+    case OP_TYPEID::Asin:
+    case OP_TYPEID::Atan:
+    case OP_TYPEID::Ceiling:
+    case OP_TYPEID::Convert:
+    case OP_TYPEID::Cos:
+    case OP_TYPEID::Cosh:
+    case OP_TYPEID::Divide:
+    case OP_TYPEID::Equal:
+    case OP_TYPEID::Exp:
+    case OP_TYPEID::Floor:
+    case OP_TYPEID::Greater:
+    case OP_TYPEID::GreaterEq:
+    case OP_TYPEID::Less:
+    case OP_TYPEID::LessEq:
+    case OP_TYPEID::Log:
+    case OP_TYPEID::Maximum:
+    case OP_TYPEID::Minimum:
+    case OP_TYPEID::Multiply:
+    case OP_TYPEID::Negative:
+    case OP_TYPEID::Not:
+    case OP_TYPEID::NotEqual:
+    case OP_TYPEID::Or:
+    case OP_TYPEID::Power:
+    case OP_TYPEID::Relu:
+    case OP_TYPEID::ReluBackprop:
+    case OP_TYPEID::Select:
+    case OP_TYPEID::Sigmoid:
+    case OP_TYPEID::SigmoidBackprop:
+    case OP_TYPEID::Sign:
+    case OP_TYPEID::Sin:
+    case OP_TYPEID::Sinh:
+    case OP_TYPEID::Sqrt:
+    case OP_TYPEID::Subtract:
+    case OP_TYPEID::Tan:
+    case OP_TYPEID::Tanh: flatten = true; return true;
+    case OP_TYPEID::AvgPool:
+    case OP_TYPEID::Convolution:
+    case OP_TYPEID::MaxPool:
+        // Split along the batch axis
+        return true;
+    case OP_TYPEID::Dot:
+    {
+        // The leading axis of the first argument is the leading axis of the output unless it
+        // is contracted
+        auto dot = static_cast<const op::Dot*>(&node);
+        return node.get_input_shape(0).size() > dot->get_reduction_axes_count();
+    }
+    case OP_TYPEID::Max:
+    case OP_TYPEID::Min:
+    case OP_TYPEID::Product:
+    case OP_TYPEID::Sum:
+    {
+        auto reduction = static_cast<const op::util::ArithmeticReduction*>(&node);
+        return node.get_input_shape(0).size() > 0 &&
+               reduction->get_reduction_axes().count(0) == 0;
+    }
+    default: return false;
+    }
+}
+
+// Returns a view of rows [begin, end) of the leading axis of tv, or of elements [begin, end)
+// if flatten is set
+static shared_ptr<runtime::HostTensorView> get_part(const shared_ptr<runtime::HostTensorView>& tv,
+                                                    bool flatten,
+                                                    size_t begin,
+                                                    size_t end)
+{
+    Shape shape = flatten ? Shape{tv->get_element_count()} : tv->get_shape();
+    size_t row_size = shape_size(shape) / shape[0] * tv->get_element_type().size();
+    shape[0] = end - begin;
+    return make_shared<runtime::HostTensorView>(tv->get_element_type(),
+                                                shape,
+                                                tv->get_data_ptr() + begin * row_size,
+                                                tv->get_tensor().get_name());
+}
+
+void runtime::interpreter::INTBackend::execute_node(
+    FunctionInstance& instance,
+    const NodeWrapper& wrapped,
+    const vector<shared_ptr<runtime::HostTensorView>>& op_outputs,
+    const vector<shared_ptr<runtime::HostTensorView>>& op_inputs)
+{
+    const Node* op = &wrapped.get_node();
+    auto type_id = wrapped.get_typeid();
+
+    // get op type
+    element::Type type;
+    switch (type_id)
+    {
+    case OP_TYPEID::Convert: type = op->get_input_element_type(0); break;
+    case OP_TYPEID::Equal:
+    case OP_TYPEID::Greater:
+    case OP_TYPEID::GreaterEq:
+    case OP_TYPEID::Less:
+    case OP_TYPEID::LessEq:
+    case OP_TYPEID::NotEqual:
+        // Get the type of the second input, not the first
+        // All BinaryElementwiseComparision ops have the same type for inputs
+        // Select has bool for first input and the type we are interested in for the second
+        type = op->get_input_element_type(1);
+        break;
+    default: type = op->get_outputs().at(0).get_element_type(); break;
+    }
+
+    if (instance.m_performance_counters_enabled)
+    {
+        instance.m_timer_map.at(op).start();
+    }
+
+    bool flatten;
+    size_t parts = 0;
+    size_t rows = 0;
+    if (instance.m_parallel_execution_enabled && get_split(wrapped, flatten))
+    {
+        ThreadPool& pool = ThreadPool::get_default();
+        rows = flatten ? op_inputs[0]->get_element_count() : op_inputs[0]->get_shape().at(0);
+        parts = min(pool.get_thread_count() + 1,
+                    op_inputs[0]->get_element_count() / s_min_split_elements);
+    }
+    if (min(parts, rows) > 1)
+    {
+        // Split the first input and the outputs; every part sees the other inputs whole
+        ThreadPool::get_default().parallel_for(rows, parts, [&](size_t begin, size_t end) {
+            vector<shared_ptr<runtime::HostTensorView>> part_inputs(op_inputs);
+            vector<shared_ptr<runtime::HostTensorView>> part_outputs;
+            size_t split_inputs = flatten ? op_inputs.size() : 1;
+            for (size_t i = 0; i < split_inputs; i++)
             {
-                if (it->second->get_tensor().get_name() == t->get_name())
-                {
-                    tensor_map.erase(it);
-                    break;
-                }
+                part_inputs[i] = get_part(op_inputs[i], flatten, begin, end);
             }
-        }
+            for (const shared_ptr<runtime::HostTensorView>& tv : op_outputs)
+            {
+                part_outputs.push_back(get_part(tv, flatten, begin, end));
+            }
+            generate_calls(type, wrapped, part_outputs, part_inputs);
+        });
+    }
+    else
+    {
+        generate_calls(type, wrapped, op_outputs, op_inputs);
     }
 
-    return true;
+    if (instance.m_performance_counters_enabled)
+    {
+        instance.m_timer_map.at(op).stop();
+    }
+    if (instance.m_nan_check_enabled)
+    {
+        perform_nan_check(op_outputs, op);
+    }
+}
+
+// Ops that sum many terms. With bf16 and f16 they compute in f32, as on CPU, because rounding
+// every partial sum to 8 or 11 bits of mantissa soon stops it from growing.
+static bool accumulates_in_f32(OP_TYPEID type_id)
+{
+    switch (type_id)
+    {
+    case OP_TYPEID::AvgPool:
+    case OP_TYPEID::AvgPoolBackprop:
+    case OP_TYPEID::BatchNorm:
+    case OP_TYPEID::BatchNormBackprop:
+    case OP_TYPEID::Convolution:
+    case OP_TYPEID::ConvolutionBackpropData:
+    case OP_TYPEID::ConvolutionBackpropFilters:
+    case OP_TYPEID::Dot:
+    case OP_TYPEID::LRN:
+    case OP_TYPEID::Product:
+    case OP_TYPEID::Softmax:
+    case OP_TYPEID::Sum: return true;
+    default: return false;
+    }
+}
+
+// Returns tvs with f32 copies in place of the bf16 and f16 tensors, holding their values if
+// copy_values is set
+static vector<shared_ptr<runtime::HostTensorView>>
+    to_f32(const vector<shared_ptr<runtime::HostTensorView>>& tvs, bool copy_values)
+{
+    vector<shared_ptr<runtime::HostTensorView>> result;
+    for (const shared_ptr<runtime::HostTensorView>& tv : tvs)
+    {
+        const element::Type& type = tv->get_element_type();
+        if (type != element::bf16 && type != element::f16)
+        {
+            result.push_back(tv);
+            continue;
+        }
+        auto f32_tv = make_shared<runtime::HostTensorView>(
+            element::f32, tv->get_shape(), tv->get_tensor().get_name());
+        if (copy_values && type == element::bf16)
+        {
+            runtime::reference::convert(tv->get_data_ptr<bfloat16>(),
+                                        f32_tv->get_data_ptr<float>(),
+                                        tv->get_element_count());
+        }
+        else if (copy_values)
+        {
+            runtime::reference::convert(tv->get_data_ptr<float16>(),
+                                        f32_tv->get_data_ptr<float>(),
+                                        tv->get_element_count());
+        }
+        result.push_back(f32_tv);
+    }
+    return result;
 }
 
 void runtime::interpreter::INTBackend::generate_calls(
@@ -230,6 +609,35 @@ void runtime::interpreter::INTBackend::generate_calls(
     {
         op_engine<char>(op, outputs, inputs);
     }
+    else if ((type == element::bf16 || type == element::f16) &&
+             accumulates_in_f32(op.get_typeid()))
+    {
+        vector<shared_ptr<HostTensorView>> f32_outputs = to_f32(outputs, false);
+        op_engine<float>(op, f32_outputs, to_f32(inputs, true));
+        for (size_t i = 0; i < outputs.size(); i++)
+        {
+            if (outputs[i]->get_element_type() == element::bf16)
+            {
+                reference::convert(f32_outputs[i]->get_data_ptr<float>(),
+                                   outputs[i]->get_data_ptr<bfloat16>(),
+                                   outputs[i]->get_element_count());
+            }
+            else if (outputs[i]->get_element_type() == element::f16)
+            {
+                reference::convert(f32_outputs[i]->get_data_ptr<float>(),
+                                   outputs[i]->get_data_ptr<float16>(),
+                                   outputs[i]->get_element_count());
+            }
+        }
+    }
+    else if (type == element::bf16)
+    {
+        op_engine<bfloat16>(op, outputs, inputs);
+    }
+    else if (type == element::f16)
+    {
+        op_engine<float16>(op, outputs, inputs);
+    }
     else if (type == element::f32)
     {
         op_engine<float>(op, outputs, inputs);
@@ -280,17 +688,24 @@ void runtime::interpreter::INTBackend::generate_calls(
 
 void runtime::interpreter::INTBackend::set_nan_check(shared_ptr<Function> func, bool enable)
 {
-    FunctionInstance& instance = m_function_map[func];
+    FunctionInstance& instance = get_function_instance(func);
     instance.m_nan_check_enabled = enable;
 }
 
 void runtime::interpreter::INTBackend::enable_performance_data(shared_ptr<Function> func,
                                                                bool enable)
 {
-    FunctionInstance& instance = m_function_map[func];
+    FunctionInstance& instance = get_function_instance(func);
     instance.m_performance_counters_enabled = enable;
 }
 
+void runtime::interpreter::INTBackend::enable_parallel_execution(shared_ptr<Function> func,
+                                                                 bool enable)
+{
+    FunctionInstance& instance = get_function_instance(func);
+    instance.m_parallel_execution_enabled = enable;
+}
+
 vector<runtime::PerformanceCounter>
     runtime::interpreter::INTBackend::get_performance_data(shared_ptr<Function> func) const
 {
@@ -298,6 +713,11 @@ vector<runtime::PerformanceCounter>
     const FunctionInstance& instance = m_function_map.at(func);
     for (const pair<const Node*, stopwatch> p : instance.m_timer_map)
     {
+        // Timers are created for every node, including those that are never executed
+        if (p.second.get_call_count() == 0)
+        {
+            continue;
+        }
         rc.emplace_back(p.first->get_name().c_str(),
                         p.second.get_total_microseconds(),
                         p.second.get_call_count());
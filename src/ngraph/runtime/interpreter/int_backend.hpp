@@ -17,6 +17,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -158,6 +159,11 @@ public:
     std::vector<PerformanceCounter>
         get_performance_data(std::shared_ptr<Function> func) const override;
 
+    /// \brief Runs nodes that do not depend on each other concurrently and splits large
+    ///     elementwise, Dot, reduction, convolution and pooling ops over their outputs, all on
+    ///     ThreadPool::get_default().
+    void enable_parallel_execution(std::shared_ptr<Function> func, bool enable) override;
+
 private:
     class FunctionInstance
     {
@@ -165,10 +171,31 @@ private:
         bool m_is_compiled = false;
         bool m_nan_check_enabled = false;
         bool m_performance_counters_enabled = false;
+        bool m_parallel_execution_enabled = false;
         std::unordered_map<const Node*, stopwatch> m_timer_map;
         std::vector<NodeWrapper> m_wrapped_nodes;
+        // Dependency graph over m_wrapped_nodes used by parallel execution
+        std::vector<std::vector<size_t>> m_node_successors;
+        std::vector<size_t> m_node_predecessor_counts;
     };
     std::map<std::shared_ptr<Function>, FunctionInstance> m_function_map;
+    // FunctionCall nodes running on different threads may look up functions concurrently
+    std::mutex m_function_map_mutex;
+
+    using TensorMap =
+        std::unordered_map<descriptor::TensorView*, std::shared_ptr<runtime::HostTensorView>>;
+
+    FunctionInstance& get_function_instance(std::shared_ptr<Function> function);
+    void call_sequential(FunctionInstance& instance, TensorMap& tensor_map);
+    void call_parallel(FunctionInstance& instance, TensorMap& tensor_map);
+    void execute_node(FunctionInstance& instance,
+                      const NodeWrapper& wrapped,
+                      const std::vector<std::shared_ptr<HostTensorView>>& outputs,
+                      const std::vector<std::shared_ptr<HostTensorView>>& inputs);
+    static std::vector<std::shared_ptr<HostTensorView>> get_inputs(const Node& op,
+                                                                   const TensorMap& tensor_map);
+    static std::vector<std::shared_ptr<HostTensorView>> get_outputs(const Node& op,
+                                                                    TensorMap& tensor_map);
 
     static void perform_nan_check(const std::vector<std::shared_ptr<HostTensorView>>&,
                                   const Node* op = nullptr);
@@ -430,6 +457,18 @@ private:
                                       out[0]->get_data_ptr<char>(),
                                       out[0]->get_element_count());
             }
+            else if (type == element::bf16)
+            {
+                reference::convert<T>(args[0]->get_data_ptr<T>(),
+                                      out[0]->get_data_ptr<bfloat16>(),
+                                      out[0]->get_element_count());
+            }
+            else if (type == element::f16)
+            {
+                reference::convert<T>(args[0]->get_data_ptr<T>(),
+                                      out[0]->get_data_ptr<float16>(),
+                                      out[0]->get_element_count());
+            }
             else if (type == element::f32)
             {
                 reference::convert<T>(args[0]->get_data_ptr<T>(),
@@ -0,0 +1,176 @@
+//*****************************************************************************
+// Copyright 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <cstdlib>
+#include <exception>
+#include <memory>
+
+#include "ngraph/runtime/interpreter/thread_pool.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+runtime::interpreter::ThreadPool::ThreadPool(size_t thread_count)
+    : m_stopping(false)
+{
+    if (thread_count == 0)
+    {
+        thread_count = max(1u, thread::hardware_concurrency());
+    }
+    for (size_t i = 0; i < thread_count; i++)
+    {
+        m_threads.emplace_back(&ThreadPool::worker, this);
+    }
+}
+
+runtime::interpreter::ThreadPool::~ThreadPool()
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_task_available.notify_all();
+    for (thread& t : m_threads)
+    {
+        t.join();
+    }
+}
+
+runtime::interpreter::ThreadPool& runtime::interpreter::ThreadPool::get_default()
+{
+    static ThreadPool pool([]() -> size_t {
+        const char* threads = getenv("NGRAPH_INTERPRETER_THREADS");
+        return threads ? strtoul(threads, nullptr, 10) : 0;
+    }());
+    return pool;
+}
+
+void runtime::interpreter::ThreadPool::submit(function<void()> task)
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_tasks.push_back(move(task));
+    }
+    m_task_available.notify_one();
+}
+
+bool runtime::interpreter::ThreadPool::run_pending_task()
+{
+    function<void()> task;
+    {
+        lock_guard<mutex> lock(m_mutex);
+        if (m_tasks.empty())
+        {
+            return false;
+        }
+        task = move(m_tasks.front());
+        m_tasks.pop_front();
+    }
+    task();
+    return true;
+}
+
+void runtime::interpreter::ThreadPool::worker()
+{
+    while (true)
+    {
+        function<void()> task;
+        {
+            unique_lock<mutex> lock(m_mutex);
+            m_task_available.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+            if (m_tasks.empty())
+            {
+                return;
+            }
+            task = move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+        task();
+    }
+}
+
+void runtime::interpreter::ThreadPool::parallel_for(size_t count,
+                                                    size_t parts,
+                                                    const function<void(size_t, size_t)>& f)
+{
+    parts = min(parts, count);
+    if (parts <= 1)
+    {
+        if (count > 0)
+        {
+            f(0, count);
+        }
+        return;
+    }
+
+    // Parts are claimed by whichever thread gets to them first, so the caller can finish all
+    // of them on its own if the workers are busy. Tasks that start after every part has been
+    // claimed return at once; the state is shared so that they may outlive this call.
+    struct State
+    {
+        mutex m_mutex;
+        condition_variable m_done;
+        size_t m_next = 0;
+        size_t m_finished = 0;
+        exception_ptr m_error;
+    };
+    auto state = make_shared<State>();
+
+    auto run_parts = [state, count, parts, &f]() {
+        while (true)
+        {
+            size_t part;
+            {
+                lock_guard<mutex> lock(state->m_mutex);
+                if (state->m_next == parts)
+                {
+                    return;
+                }
+                part = state->m_next++;
+            }
+            try
+            {
+                f(part * count / parts, (part + 1) * count / parts);
+            }
+            catch (...)
+            {
+                lock_guard<mutex> lock(state->m_mutex);
+                if (!state->m_error)
+                {
+                    state->m_error = current_exception();
+                }
+            }
+            lock_guard<mutex> lock(state->m_mutex);
+            if (++state->m_finished == parts)
+            {
+                state->m_done.notify_all();
+            }
+        }
+    };
+
+    for (size_t i = 1; i < parts; i++)
+    {
+        submit(run_parts);
+    }
+    run_parts();
+
+    unique_lock<mutex> lock(state->m_mutex);
+    state->m_done.wait(lock, [&state, parts]() { return state->m_finished == parts; });
+    if (state->m_error)
+    {
+        rethrow_exception(state->m_error);
+    }
+}
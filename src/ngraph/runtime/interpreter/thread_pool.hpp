@@ -0,0 +1,78 @@
+//*****************************************************************************
+// Copyright 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace interpreter
+        {
+            class ThreadPool;
+        }
+    }
+}
+
+/// \brief A fixed set of worker threads running tasks from a shared queue.
+///
+/// Threads that wait for work of the pool, in parallel_for or in the interpreter's inter-op
+/// scheduler, run queued tasks themselves while they wait. A task may therefore wait for
+/// other tasks without deadlocking the pool, however deeply the waits nest.
+class ngraph::runtime::interpreter::ThreadPool
+{
+public:
+    /// \param thread_count The number of worker threads; 0 uses one per hardware thread.
+    ThreadPool(size_t thread_count = 0);
+    ~ThreadPool();
+
+    /// \brief The pool shared by all interpreter backends. Its size is read from
+    ///     NGRAPH_INTERPRETER_THREADS and defaults to one thread per hardware thread.
+    static ThreadPool& get_default();
+
+    size_t get_thread_count() const { return m_threads.size(); }
+    void submit(std::function<void()> task);
+
+    /// \brief Runs one queued task on the calling thread.
+    /// \returns false if the queue was empty
+    bool run_pending_task();
+
+    /// \brief Splits [0, count) into parts contiguous ranges and calls f(begin, end) for each
+    ///     of them, on the calling thread and on the workers. Returns when all parts are done
+    ///     and rethrows the first exception thrown by f.
+    void parallel_for(size_t count,
+                      size_t parts,
+                      const std::function<void(size_t begin, size_t end)>& f);
+
+private:
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void worker();
+
+    std::vector<std::thread> m_threads;
+    std::deque<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_task_available;
+    bool m_stopping;
+};
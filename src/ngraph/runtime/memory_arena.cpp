@@ -0,0 +1,168 @@
+//*****************************************************************************
+// Copyright 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <string>
+
+#include "ngraph/except.hpp"
+#include "ngraph/runtime/memory_arena.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+const size_t runtime::MemoryArena::s_default_idle_limit;
+
+runtime::MemoryArena::MemoryArena()
+    : m_next_ticket(1)
+    , m_idle_bytes(0)
+    , m_borrowed_bytes(0)
+    , m_idle_limit(s_default_idle_limit)
+{
+    if (const char* limit = getenv("NGRAPH_SCRATCH_ARENA_IDLE_LIMIT"))
+    {
+        char* end = nullptr;
+        errno = 0;
+        unsigned long long value = strtoull(limit, &end, 10);
+        if (*limit < '0' || *limit > '9' || *end != '\0' || errno == ERANGE ||
+            value > numeric_limits<size_t>::max())
+        {
+            throw ngraph_error("NGRAPH_SCRATCH_ARENA_IDLE_LIMIT must be a byte count, got '" +
+                               string(limit) + "'");
+        }
+        m_idle_limit = static_cast<size_t>(value);
+    }
+}
+
+runtime::MemoryArena::~MemoryArena()
+{
+    trim();
+}
+
+runtime::MemoryArena& runtime::MemoryArena::get_process_arena()
+{
+    static MemoryArena s_arena;
+    return s_arena;
+}
+
+runtime::AlignedBuffer* runtime::MemoryArena::take(IdleBuffers::iterator it)
+{
+    AlignedBuffer* buffer = it->second.buffer;
+    m_tickets.erase(it->second.ticket);
+    m_idle_buffers.erase(it);
+    m_idle_bytes -= buffer->size();
+    m_borrowed_bytes += buffer->size();
+    return buffer;
+}
+
+runtime::AlignedBuffer* runtime::MemoryArena::acquire(size_t byte_size, size_t alignment)
+{
+    bool intact;
+    return acquire(byte_size, alignment, 0, intact);
+}
+
+runtime::AlignedBuffer* runtime::MemoryArena::acquire(size_t byte_size,
+                                                      size_t alignment,
+                                                      size_t ticket,
+                                                      bool& intact)
+{
+    intact = false;
+    {
+        lock_guard<mutex> lock(m_mutex);
+        auto reclaimed = m_tickets.find(ticket);
+        if (reclaimed != m_tickets.end())
+        {
+            // Only the caller that gave the buffer back holds its ticket, so the size and
+            // alignment already match
+            intact = true;
+            return take(reclaimed->second);
+        }
+        for (auto it = m_idle_buffers.lower_bound(byte_size);
+             it != m_idle_buffers.end() && it->first / 2 <= byte_size;
+             ++it)
+        {
+            if (reinterpret_cast<uintptr_t>(it->second.buffer->get_ptr()) % alignment == 0)
+            {
+                return take(it);
+            }
+        }
+        m_borrowed_bytes += byte_size;
+    }
+    return new AlignedBuffer(byte_size, alignment);
+}
+
+size_t runtime::MemoryArena::release(AlignedBuffer* buffer)
+{
+    if (buffer == nullptr)
+    {
+        return 0;
+    }
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_borrowed_bytes -= buffer->size();
+        if (m_idle_bytes + buffer->size() <= m_idle_limit)
+        {
+            size_t ticket = m_next_ticket++;
+            auto it = m_idle_buffers.insert({buffer->size(), IdleBuffer{buffer, ticket}});
+            m_tickets[ticket] = it;
+            m_idle_bytes += buffer->size();
+            return ticket;
+        }
+    }
+    delete buffer;
+    return 0;
+}
+
+void runtime::MemoryArena::set_idle_limit(size_t byte_size)
+{
+    lock_guard<mutex> lock(m_mutex);
+    m_idle_limit = byte_size;
+    // Drop the largest buffers first
+    while (m_idle_bytes > m_idle_limit)
+    {
+        auto it = prev(m_idle_buffers.end());
+        m_idle_bytes -= it->first;
+        m_tickets.erase(it->second.ticket);
+        delete it->second.buffer;
+        m_idle_buffers.erase(it);
+    }
+}
+
+void runtime::MemoryArena::trim()
+{
+    lock_guard<mutex> lock(m_mutex);
+    for (auto& p : m_idle_buffers)
+    {
+        delete p.second.buffer;
+    }
+    m_idle_buffers.clear();
+    m_tickets.clear();
+    m_idle_bytes = 0;
+}
+
+size_t runtime::MemoryArena::get_idle_bytes() const
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_idle_bytes;
+}
+
+size_t runtime::MemoryArena::get_borrowed_bytes() const
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_borrowed_bytes;
+}
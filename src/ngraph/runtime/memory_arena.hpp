@@ -0,0 +1,97 @@
+//*****************************************************************************
+// Copyright 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+#include "ngraph/runtime/aligned_buffer.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        class MemoryArena;
+    }
+}
+
+/// \brief Lends scratch buffers to calls for the duration of the call.
+///
+/// Buffers given back are kept for later calls of any Function, so the memory held by the
+/// arena follows the number of calls in flight rather than the number of Functions loaded.
+/// A buffer is reused for a request when it is large enough but no more than twice the
+/// requested size. A caller that gives a buffer back may reclaim that same buffer, contents
+/// intact, with the ticket release() returned, as long as nobody borrowed it in between.
+class ngraph::runtime::MemoryArena
+{
+public:
+    MemoryArena();
+    ~MemoryArena();
+
+    MemoryArena(const MemoryArena&) = delete;
+    MemoryArena& operator=(const MemoryArena&) = delete;
+
+    /// \brief The arena shared by every backend in the process
+    static MemoryArena& get_process_arena();
+
+    /// \brief The idle limit unless NGRAPH_SCRATCH_ARENA_IDLE_LIMIT sets another
+    static const size_t s_default_idle_limit = 256 * 1024 * 1024;
+
+    /// \brief Borrow a buffer of at least `byte_size` bytes on the given alignment.
+    ///     The contents are unspecified.
+    AlignedBuffer* acquire(size_t byte_size, size_t alignment);
+
+    /// \brief Borrow a buffer, preferring the one given back with `ticket`
+    /// \param intact Set to true if that buffer is returned with its contents unchanged
+    AlignedBuffer* acquire(size_t byte_size, size_t alignment, size_t ticket, bool& intact);
+
+    /// \brief Give back a buffer obtained from acquire()
+    /// \returns The ticket that reclaims the buffer, or 0 if the buffer was freed
+    size_t release(AlignedBuffer* buffer);
+
+    /// \brief Limit the bytes held in idle buffers. Buffers released beyond the limit are
+    ///     freed immediately.
+    void set_idle_limit(size_t byte_size);
+
+    /// \brief Free every idle buffer
+    void trim();
+
+    size_t get_idle_bytes() const;
+    size_t get_borrowed_bytes() const;
+
+private:
+    struct IdleBuffer
+    {
+        AlignedBuffer* buffer;
+        size_t ticket;
+    };
+    using IdleBuffers = std::multimap<size_t, IdleBuffer>;
+
+    // Called with m_mutex held
+    AlignedBuffer* take(IdleBuffers::iterator it);
+
+    mutable std::mutex m_mutex;
+    IdleBuffers m_idle_buffers;
+    // The idle buffers by the ticket they were given back with
+    std::unordered_map<size_t, IdleBuffers::iterator> m_tickets;
+    size_t m_next_ticket;
+    size_t m_idle_bytes;
+    size_t m_borrowed_bytes;
+    size_t m_idle_limit;
+};
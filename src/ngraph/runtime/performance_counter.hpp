@@ -17,6 +17,8 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
+#include <string>
 
 namespace ngraph
 {
@@ -29,16 +31,91 @@ namespace ngraph
                 : m_name(n)
                 , m_total_microseconds(us)
                 , m_call_count(calls)
+                , m_p50_microseconds(0)
+                , m_p99_microseconds(0)
+                , m_max_microseconds(0)
+                , m_cycles(0)
+                , m_instructions(0)
+                , m_llc_misses(0)
+                , m_flops(0)
+                , m_cache_line_size(0)
             {
             }
+            /// \brief A counter that also has the distribution of the times of the calls, for
+            ///        backends that keep a histogram per op
+            PerformanceCounter(const char* n,
+                               size_t us,
+                               size_t calls,
+                               double p50_us,
+                               double p99_us,
+                               double max_us)
+                : m_name(n)
+                , m_total_microseconds(us)
+                , m_call_count(calls)
+                , m_p50_microseconds(p50_us)
+                , m_p99_microseconds(p99_us)
+                , m_max_microseconds(max_us)
+                , m_cycles(0)
+                , m_instructions(0)
+                , m_llc_misses(0)
+                , m_flops(0)
+                , m_cache_line_size(0)
+            {
+            }
+            /// \brief Attaches the hardware event counts of all the timed calls
+            /// \param cache_line_size The bytes moved from memory per last level cache miss
+            void set_hardware_counts(uint64_t cycles,
+                                     uint64_t instructions,
+                                     uint64_t llc_misses,
+                                     uint64_t flops,
+                                     uint64_t cache_line_size)
+            {
+                m_cycles = cycles;
+                m_instructions = instructions;
+                m_llc_misses = llc_misses;
+                m_flops = flops;
+                m_cache_line_size = cache_line_size;
+            }
             const std::string& name() const { return m_name; }
             size_t total_microseconds() const { return m_total_microseconds; }
             size_t microseconds() const { return m_total_microseconds / m_call_count; }
             size_t call_count() const { return m_call_count; }
+            /// \brief The median time of a call; 0 if the backend keeps no histogram
+            double p50_microseconds() const { return m_p50_microseconds; }
+            /// \brief The 99th percentile time of a call; 0 if the backend keeps no histogram
+            double p99_microseconds() const { return m_p99_microseconds; }
+            /// \brief The longest call; 0 if the backend keeps no histogram
+            double max_microseconds() const { return m_max_microseconds; }
+            /// \brief Hardware event counts summed over the timed calls; 0 if not counted
+            uint64_t cycles() const { return m_cycles; }
+            uint64_t instructions() const { return m_instructions; }
+            uint64_t llc_misses() const { return m_llc_misses; }
+            uint64_t flops() const { return m_flops; }
+            /// \brief The achieved floating point throughput of the timed calls
+            double gflops() const
+            {
+                return m_total_microseconds > 0 ? m_flops / (m_total_microseconds * 1e3) : 0;
+            }
+            /// \brief The achieved memory bandwidth, counting one cache line per last level
+            ///        cache miss
+            double gigabytes_per_second() const
+            {
+                return m_total_microseconds > 0
+                           ? m_llc_misses * m_cache_line_size / (m_total_microseconds * 1e3)
+                           : 0;
+            }
         private:
             std::string m_name;
             size_t m_total_microseconds;
             size_t m_call_count;
+            double m_p50_microseconds;
+            double m_p99_microseconds;
+            double m_max_microseconds;
+            uint64_t m_cycles;
+            uint64_t m_instructions;
+            uint64_t m_llc_misses;
+            uint64_t m_flops;
+            uint64_t m_cache_line_size;
         };
     }
 }
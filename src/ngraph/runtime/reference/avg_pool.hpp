@@ -218,8 +218,9 @@ namespace ngraph
 
                         if (in_bounds || include_padding_in_avg_computation)
                         {
-                            T v =
-                                in_bounds ? arg[input_batch_transform.index(input_batch_coord)] : 0;
+                            T v = in_bounds
+                                      ? arg[input_batch_transform.index(input_batch_coord)]
+                                      : T(0);
                             result += v;
                             n_elements++;
                         }
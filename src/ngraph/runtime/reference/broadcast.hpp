@@ -18,7 +18,7 @@
 
 #include <cmath>
 
-#include "ngraph/coordinate_transform.hpp"
+#include "ngraph/strided_transform.hpp"
 
 namespace ngraph
 {
@@ -33,16 +33,22 @@ namespace ngraph
                            const Shape& out_shape,
                            const AxisSet& broadcast_axes)
             {
-                CoordinateTransform input_transform(in_shape);
-                CoordinateTransform output_transform(out_shape);
+                // Broadcast axes repeat the input, so they have a stride of 0 in it.
+                StridedTransform transform(
+                    out_shape,
+                    {StridedTransform::row_major_strides(out_shape),
+                     StridedTransform::projected_strides(out_shape, broadcast_axes)});
+                size_t n = transform.get_inner_size();
+                std::ptrdiff_t arg_stride = transform.get_inner_stride(1);
 
-                for (const Coordinate& output_coord : output_transform)
-                {
-                    Coordinate input_coord = project(output_coord, broadcast_axes);
-
-                    out[output_transform.index(output_coord)] =
-                        arg[input_transform.index(input_coord)];
-                }
+                transform.for_each_row([&](const std::ptrdiff_t* offsets) {
+                    T* out_row = out + offsets[0];
+                    const T* arg_row = arg + offsets[1];
+                    for (size_t i = 0; i < n; i++)
+                    {
+                        out_row[i] = arg_row[i * arg_stride];
+                    }
+                });
             }
         }
     }
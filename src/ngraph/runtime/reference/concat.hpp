@@ -18,7 +18,7 @@
 
 #include <cmath>
 
-#include "ngraph/coordinate_transform.hpp"
+#include "ngraph/strided_transform.hpp"
 
 namespace ngraph
 {
@@ -36,40 +36,28 @@ namespace ngraph
                 // We will copy the inputs to the output one at a time. As we go, we will move out along the
                 // concatenation axis, starting at 0.
                 size_t concatenation_pos = 0;
+                CoordinateDiff out_strides = StridedTransform::row_major_strides(out_shape);
 
                 for (size_t i = 0; i < args.size(); i++)
                 {
-                    // CoordinateTransform gets confused when the last input has a zero-size dim, so we will
-                    // just skip for zero-element tensors.
-                    if (shape_size(in_shapes[i]) == 0)
-                    {
-                        continue;
-                    }
+                    // The input is copied to the chunk of the output that starts at
+                    // concatenation_pos along the concatenation axis.
+                    StridedTransform transform(
+                        in_shapes[i],
+                        {StridedTransform::row_major_strides(in_shapes[i]), out_strides},
+                        {0, std::ptrdiff_t(concatenation_pos) * out_strides[concatenation_axis]});
+                    size_t n = transform.get_inner_size();
+                    std::ptrdiff_t out_stride = transform.get_inner_stride(1);
+                    const T* arg = args[i];
 
-                    // The start coordinate for the copy is (0,...,0) except at the concatenation axis.
-                    Coordinate out_start_coord(out_shape.size(), 0);
-                    out_start_coord[concatenation_axis] = concatenation_pos;
-
-                    // The end coordinate for the copy is the same as the output shape except at the
-                    // concatenation axis.
-                    Coordinate out_end_coord = out_shape;
-                    out_end_coord[concatenation_axis] =
-                        concatenation_pos + in_shapes[i][concatenation_axis];
-
-                    CoordinateTransform input_transform(in_shapes[i]);
-                    CoordinateTransform output_chunk_transform(
-                        out_shape, out_start_coord, out_end_coord);
-
-                    CoordinateTransform::Iterator output_chunk_it = output_chunk_transform.begin();
-
-                    for (const Coordinate& input_coord : input_transform)
-                    {
-                        size_t input_index = input_transform.index(input_coord);
-                        size_t output_chunk_index = output_chunk_transform.index(*output_chunk_it);
-                        ++output_chunk_it;
-
-                        out[output_chunk_index] = args[i][input_index];
-                    }
+                    transform.for_each_row([&](const std::ptrdiff_t* offsets) {
+                        const T* arg_row = arg + offsets[0];
+                        T* out_row = out + offsets[1];
+                        for (size_t j = 0; j < n; j++)
+                        {
+                            out_row[j * out_stride] = arg_row[j];
+                        }
+                    });
 
                     concatenation_pos += in_shapes[i][concatenation_axis];
                 }
@@ -14,13 +14,17 @@
 // limitations under the License.
 //*****************************************************************************
 
+
 #pragma once
 
-#include <cmath>
+#include <algorithm>
+#include <cstddef>
+#include <vector>
 
-#include "ngraph/axis_vector.hpp"
-#include "ngraph/coordinate_transform.hpp"
-#include "ngraph/util.hpp"
+#include "ngraph/coordinate_diff.hpp"
+#include "ngraph/runtime/reference/gemm.hpp"
+#include "ngraph/shape.hpp"
+#include "ngraph/strides.hpp"
 
 namespace ngraph
 {
@@ -55,150 +59,178 @@ namespace ngraph
                 // * output channel axes for filters is 0
                 // * output channel axis for output data is 1
                 // * rotate_filter is false
+                //
+                // For every batch item N the convolution is the matrix product
+                //
+                //   output[N,chan_out,i] = sum_k filters[chan_out,k] * columns[k,i]
+                //
+                // where i walks the output spatial positions (i_1,...,i_n) and k walks the filter
+                // elements (chan_in,f_1,...,f_n), so that
+                //
+                //   columns[k,i] = data[N,chan_in,s_1*i_1 + l_1*f_1,...,s_n*i_n + l_n*f_n],
+                //
+                // indexed within the *padded* and *dilated* data batch, or 0 where that falls in
+                // the padding or in a dilation gap. The columns of a block of output positions
+                // are gathered ("im2col") and handed to gemm together.
+
+                if (shape_size(out_shape) == 0)
+                {
+                    return;
+                }
 
-                // At the outermost level we will walk over every output coordinate O.
-                CoordinateTransform output_transform(out_shape);
+                size_t n_spatial_dimensions = arg0_shape.size() - 2;
+                size_t batch_size = arg0_shape[batch_axis_data];
+                size_t n_input_channels = arg0_shape[input_channel_axis_data];
+                size_t n_output_channels = out_shape[output_channel_axis_result];
 
-                for (Coordinate out_coord : output_transform)
+                std::vector<size_t> arg0_strides = row_major_strides(arg0_shape);
+                std::vector<size_t> arg1_strides = row_major_strides(arg1_shape);
+                std::vector<size_t> out_strides = row_major_strides(out_shape);
+
+                Shape window_shape(arg1_shape.begin() + 2, arg1_shape.end());
+                Shape output_spatial_shape(out_shape.begin() + 2, out_shape.end());
+                size_t window_size = shape_size(window_shape);
+                size_t output_spatial_size = shape_size(output_spatial_shape);
+                size_t k = n_input_channels * window_size;
+
+                // Filter coordinates (f_1,...,f_n) of every window position, in row-major order.
+                std::vector<size_t> window_coords(window_size * n_spatial_dimensions);
+                for (size_t w = 0; w < window_size; w++)
                 {
-                    // Our output coordinate O will have the form:
-                    //
-                    //   (N,chan_out,i_1,...,i_n)
-
-                    size_t batch_index = out_coord[batch_axis_result];
-                    size_t output_channel = out_coord[output_channel_axis_result];
-
-                    // For the input data we need to iterate the coordinate:
-                    //
-                    //   I:
-                    //
-                    // over the range (noninclusive on the right):
-                    //
-                    //   (N,0,s_1*i_1,s_2*i_2,...,s_n*i_n) ->
-                    //
-                    //     (N+1,chans_in_count,s_1*i_1 + l_1*filter_dims_1,...,s_n*i_n + l_n*filter_dims_n)
-                    //
-                    // with strides:
-                    //
-                    //   (1,l_1,...,l_n).
-                    //
-                    // Note that we are iterating within the *padded* and *dilated* data batch, so further
-                    // down we must check the current coordinate is in the padding or dilation gap.
-
-                    size_t n_spatial_dimensions = arg0_shape.size() - 2;
-                    size_t n_input_channels = arg0_shape[input_channel_axis_data];
-
-                    Coordinate input_batch_transform_start(2 + n_spatial_dimensions);
-                    Coordinate input_batch_transform_end(2 + n_spatial_dimensions);
-                    Strides input_batch_transform_movement_strides(2 + n_spatial_dimensions, 1);
-                    CoordinateDiff input_batch_transform_padding_below(2 + n_spatial_dimensions, 0);
-                    CoordinateDiff input_batch_transform_padding_above(2 + n_spatial_dimensions, 0);
-                    Strides input_batch_transform_dilation_strides(2 + n_spatial_dimensions, 1);
-
-                    input_batch_transform_start[batch_axis_data] = batch_index;
-                    input_batch_transform_end[batch_axis_data] = batch_index + 1;
-                    input_batch_transform_start[input_channel_axis_data] = 0;
-                    input_batch_transform_end[input_channel_axis_data] = n_input_channels;
-
-                    for (size_t i = 2; i < n_spatial_dimensions + 2; i++)
+                    size_t rest = w;
+                    for (size_t i = n_spatial_dimensions; i-- > 0;)
                     {
-                        size_t window_dilation_stride = window_dilation_strides[i - 2];
-                        size_t window_movement_stride = window_movement_strides[i - 2];
-                        std::ptrdiff_t below_pad = padding_below[i - 2];
-                        std::ptrdiff_t above_pad = padding_above[i - 2];
-                        size_t data_dilation_stride = data_dilation_strides[i - 2];
-
-                        input_batch_transform_start[i] = window_movement_stride * out_coord[i];
-                        input_batch_transform_end[i] =
-                            input_batch_transform_start[i] +
-                            (arg1_shape[i] - 1) * window_dilation_stride + 1;
-                        input_batch_transform_movement_strides[i] = window_dilation_stride;
-                        input_batch_transform_padding_below[i] = below_pad;
-                        input_batch_transform_padding_above[i] = above_pad;
-                        input_batch_transform_dilation_strides[i] = data_dilation_stride;
+                        window_coords[w * n_spatial_dimensions + i] = rest % window_shape[i];
+                        rest /= window_shape[i];
                     }
+                }
 
-                    AxisVector input_batch_transform_axis_order(2 + n_spatial_dimensions);
-                    for (size_t i = 0; i < input_batch_transform_axis_order.size(); i++)
+                // Pack the filters into a dense n_output_channels x k matrix, reversing the
+                // spatial axes if rotate_filter is set.
+                std::vector<T> filters(n_output_channels * k);
+                for (size_t chan_out = 0; chan_out < n_output_channels; chan_out++)
+                {
+                    for (size_t chan_in = 0; chan_in < n_input_channels; chan_in++)
                     {
-                        input_batch_transform_axis_order[i] = i;
+                        size_t filter_base =
+                            chan_out * arg1_strides[output_channel_axis_filters] +
+                            chan_in * arg1_strides[input_channel_axis_filters];
+                        T* filter_row = &filters[chan_out * k + chan_in * window_size];
+                        for (size_t w = 0; w < window_size; w++)
+                        {
+                            size_t filter_index = filter_base;
+                            for (size_t i = 0; i < n_spatial_dimensions; i++)
+                            {
+                                size_t f = window_coords[w * n_spatial_dimensions + i];
+                                if (rotate_filter)
+                                {
+                                    f = window_shape[i] - f - 1;
+                                }
+                                filter_index += f * arg1_strides[i + 2];
+                            }
+                            filter_row[w] = arg1[filter_index];
+                        }
                     }
+                }
 
-                    CoordinateTransform input_batch_transform(
-                        arg0_shape,
-                        input_batch_transform_start,
-                        input_batch_transform_end,
-                        input_batch_transform_movement_strides,
-                        input_batch_transform_axis_order,
-                        input_batch_transform_padding_below,
-                        input_batch_transform_padding_above,
-                        input_batch_transform_dilation_strides);
-
-                    // Simultaneously with iterating I, for the filters we need to iterate the coordinate:
-                    //
-                    //   F
-                    //
-                    // over the range (noninclusive on the right):
-                    //
-                    //   (chan_out,0,0,...,0) -> (chan_out+1,chans_in_count,filter_dims_1,...,filter_dims_n)
-                    //
-                    // with unit stride.
-
-                    Shape filter_transform_start(2 + n_spatial_dimensions);
-                    Shape filter_transform_end(2 + n_spatial_dimensions);
-
-                    filter_transform_start[output_channel_axis_filters] = output_channel;
-                    filter_transform_end[output_channel_axis_filters] = output_channel + 1;
-                    filter_transform_start[input_channel_axis_filters] = 0;
-                    filter_transform_end[input_channel_axis_filters] = n_input_channels;
-
-                    for (size_t i = 2; i < n_spatial_dimensions + 2; i++)
+                // For each spatial axis, the data index read by filter position f at output
+                // position o, or -1 if that falls in the padding or in a dilation gap.
+                std::vector<std::vector<std::ptrdiff_t>> source_indices(n_spatial_dimensions);
+                for (size_t i = 0; i < n_spatial_dimensions; i++)
+                {
+                    std::ptrdiff_t data_dilation = data_dilation_strides[i];
+                    std::ptrdiff_t dilated_size =
+                        arg0_shape[i + 2] == 0
+                            ? 0
+                            : (std::ptrdiff_t(arg0_shape[i + 2]) - 1) * data_dilation + 1;
+                    source_indices[i].resize(window_shape[i] * output_spatial_shape[i]);
+                    for (size_t f = 0; f < window_shape[i]; f++)
                     {
-                        filter_transform_start[i] = 0;
-                        filter_transform_end[i] = arg1_shape[i];
+                        for (size_t o = 0; o < output_spatial_shape[i]; o++)
+                        {
+                            std::ptrdiff_t pos =
+                                std::ptrdiff_t(window_movement_strides[i] * o +
+                                               window_dilation_strides[i] * f) -
+                                padding_below[i];
+                            bool in_data =
+                                pos >= 0 && pos < dilated_size && pos % data_dilation == 0;
+                            source_indices[i][f * output_spatial_shape[i] + o] =
+                                in_data ? pos / data_dilation : -1;
+                        }
                     }
+                }
 
-                    CoordinateTransform filter_transform(
-                        arg1_shape, filter_transform_start, filter_transform_end);
-
-                    // As we go, we sum up:
-                    //
-                    //   output[O] += arg0[I] * arg1[F].
-
-                    T result = 0;
-
-                    CoordinateTransform::Iterator input_it = input_batch_transform.begin();
-                    CoordinateTransform::Iterator filter_it = filter_transform.begin();
-
-                    while (input_it != input_batch_transform.end() &&
-                           filter_it != filter_transform.end())
+                // Gather the columns of up to block_size output positions at a time, which
+                // bounds the scratch space for large images.
+                const size_t max_column_elements = size_t(1) << 20;
+                size_t block_size = std::max(
+                    size_t(1),
+                    std::min(output_spatial_size, max_column_elements / std::max(k, size_t(1))));
+                std::vector<T> columns(k * block_size);
+                std::vector<size_t> output_coords(n_spatial_dimensions * block_size);
+                std::vector<const std::ptrdiff_t*> window_sources(n_spatial_dimensions);
+
+                for (size_t batch_index = 0; batch_index < batch_size; batch_index++)
+                {
+                    for (size_t block_start = 0; block_start < output_spatial_size;
+                         block_start += block_size)
                     {
-                        const Coordinate& input_batch_coord = *input_it;
-                        Coordinate filter_coord = *filter_it;
+                        size_t block_count =
+                            std::min(block_size, output_spatial_size - block_start);
 
-                        if (rotate_filter)
+                        // Output coordinates (i_1,...,i_n) of the block, axis by axis.
+                        for (size_t t = 0; t < block_count; t++)
                         {
-                            Shape target_shape = filter_transform.get_target_shape();
-
-                            // Note that we only reverse the spatial dimensions here (loop
-                            // starts at 2)
-                            for (size_t i = 2; i < filter_coord.size(); i++)
+                            size_t rest = block_start + t;
+                            for (size_t i = n_spatial_dimensions; i-- > 0;)
                             {
-                                filter_coord[i] = target_shape[i] - filter_coord[i] - 1;
+                                output_coords[i * block_size + t] =
+                                    rest % output_spatial_shape[i];
+                                rest /= output_spatial_shape[i];
                             }
                         }
 
-                        T v = input_batch_transform.has_source_coordinate(input_batch_coord)
-                                  ? arg0[input_batch_transform.index(input_batch_coord)]
-                                  : 0;
-
-                        result += v * arg1[filter_transform.index(filter_coord)];
+                        for (size_t chan_in = 0; chan_in < n_input_channels; chan_in++)
+                        {
+                            size_t data_base = batch_index * arg0_strides[batch_axis_data] +
+                                               chan_in * arg0_strides[input_channel_axis_data];
+                            for (size_t w = 0; w < window_size; w++)
+                            {
+                                for (size_t i = 0; i < n_spatial_dimensions; i++)
+                                {
+                                    window_sources[i] =
+                                        &source_indices[i][window_coords[w * n_spatial_dimensions +
+                                                                         i] *
+                                                           output_spatial_shape[i]];
+                                }
+
+                                T* column_row = &columns[(chan_in * window_size + w) * block_size];
+                                for (size_t t = 0; t < block_count; t++)
+                                {
+                                    std::ptrdiff_t data_index = data_base;
+                                    bool in_data = true;
+                                    for (size_t i = 0; in_data && i < n_spatial_dimensions; i++)
+                                    {
+                                        std::ptrdiff_t source =
+                                            window_sources[i][output_coords[i * block_size + t]];
+                                        in_data = source >= 0;
+                                        data_index += source * std::ptrdiff_t(arg0_strides[i + 2]);
+                                    }
+                                    column_row[t] = in_data ? arg0[data_index] : T(0);
+                                }
+                            }
+                        }
 
-                        ++input_it;
-                        ++filter_it;
+                        gemm(n_output_channels,
+                             block_count,
+                             k,
+                             filters.data(),
+                             k,
+                             columns.data(),
+                             block_size,
+                             out + batch_index * out_strides[batch_axis_result] + block_start,
+                             out_strides[output_channel_axis_result]);
                     }
-
-                    out[output_transform.index(out_coord)] = result;
                 }
             }
         }
@@ -44,9 +44,10 @@ namespace ngraph
                 }
             }
 
-            // In English: return type is void and T must be a floating point type.
+            // In English: return type is void and T must be a floating point type, including
+            // bfloat16 and float16.
             template <typename T>
-            typename std::enable_if<std::is_floating_point<T>::value>::type
+            typename std::enable_if<!std::is_integral<T>::value>::type
                 divide(const T* arg0, const T* arg1, T* out, size_t count)
             {
                 for (size_t i = 0; i < count; i++)
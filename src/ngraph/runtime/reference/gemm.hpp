@@ -0,0 +1,125 @@
+//*****************************************************************************
+// Copyright 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace reference
+        {
+            /// \brief Computes the m x n row-major matrix c = a * b, where a is m x k and b is
+            ///        k x n. lda, ldb and ldc are the distances between consecutive rows.
+            ///
+            /// The loops are blocked so that a panel of b and the rows of c being updated stay in
+            /// cache, and four rows of c are updated together so that every element of b loaded
+            /// is used four times. The innermost loop runs along contiguous rows of b and c,
+            /// which the compiler vectorizes for any element type. Every element of c sums its k
+            /// products in ascending order, as a naive triple loop would.
+            template <typename T>
+            void gemm(size_t m,
+                      size_t n,
+                      size_t k,
+                      const T* a,
+                      size_t lda,
+                      const T* b,
+                      size_t ldb,
+                      T* c,
+                      size_t ldc)
+            {
+                const size_t block_n = 256;
+                const size_t block_k = 128;
+
+                // Matrix-vector products have nothing to tile along n.
+                if (n == 1)
+                {
+                    for (size_t i = 0; i < m; i++)
+                    {
+                        const T* a_row = a + i * lda;
+                        T sum = 0;
+                        for (size_t p = 0; p < k; p++)
+                        {
+                            sum += a_row[p] * b[p * ldb];
+                        }
+                        c[i * ldc] = sum;
+                    }
+                    return;
+                }
+
+                for (size_t i = 0; i < m; i++)
+                {
+                    std::fill(c + i * ldc, c + i * ldc + n, T(0));
+                }
+
+                for (size_t j0 = 0; j0 < n; j0 += block_n)
+                {
+                    size_t nb = std::min(block_n, n - j0);
+                    for (size_t k0 = 0; k0 < k; k0 += block_k)
+                    {
+                        size_t kb = std::min(block_k, k - k0);
+                        size_t i = 0;
+                        for (; i + 4 <= m; i += 4)
+                        {
+                            const T* a0 = a + i * lda + k0;
+                            const T* a1 = a0 + lda;
+                            const T* a2 = a1 + lda;
+                            const T* a3 = a2 + lda;
+                            T* c0 = c + i * ldc + j0;
+                            T* c1 = c0 + ldc;
+                            T* c2 = c1 + ldc;
+                            T* c3 = c2 + ldc;
+                            for (size_t p = 0; p < kb; p++)
+                            {
+                                const T* b_row = b + (k0 + p) * ldb + j0;
+                                T v0 = a0[p];
+                                T v1 = a1[p];
+                                T v2 = a2[p];
+                                T v3 = a3[p];
+                                for (size_t j = 0; j < nb; j++)
+                                {
+                                    T w = b_row[j];
+                                    c0[j] += v0 * w;
+                                    c1[j] += v1 * w;
+                                    c2[j] += v2 * w;
+                                    c3[j] += v3 * w;
+                                }
+                            }
+                        }
+                        for (; i < m; i++)
+                        {
+                            const T* a0 = a + i * lda + k0;
+                            T* c0 = c + i * ldc + j0;
+                            for (size_t p = 0; p < kb; p++)
+                            {
+                                const T* b_row = b + (k0 + p) * ldb + j0;
+                                T v0 = a0[p];
+                                for (size_t j = 0; j < nb; j++)
+                                {
+                                    c0[j] += v0 * b_row[j];
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
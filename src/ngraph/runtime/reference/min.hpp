@@ -19,7 +19,7 @@
 #include <cmath>
 #include <limits>
 
-#include "ngraph/coordinate_transform.hpp"
+#include "ngraph/strided_transform.hpp"
 
 #ifdef WIN32
 #undef min
@@ -41,26 +41,46 @@ namespace ngraph
                 T minval = std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity()
                                                                 : std::numeric_limits<T>::max();
 
-                CoordinateTransform output_transform(out_shape);
-
-                for (const Coordinate& output_coord : output_transform)
+                for (size_t i = 0; i < shape_size(out_shape); i++)
                 {
-                    out[output_transform.index(output_coord)] = minval;
+                    out[i] = minval;
                 }
 
-                CoordinateTransform input_transform(in_shape);
-
-                for (const Coordinate& input_coord : input_transform)
-                {
-                    Coordinate output_coord = project(input_coord, reduction_axes);
+                // Reduced axes have a stride of 0 in the output, so a row either reduces into a
+                // single output element or updates a row of the output elementwise.
+                StridedTransform transform(
+                    in_shape,
+                    {StridedTransform::row_major_strides(in_shape),
+                     StridedTransform::projected_strides(in_shape, reduction_axes)});
+                size_t n = transform.get_inner_size();
+                bool reduce_row = transform.get_inner_stride(1) == 0;
 
-                    T x = arg[input_transform.index(input_coord)];
-                    T min = out[output_transform.index(output_coord)];
-                    if (x < min)
+                transform.for_each_row([&](const std::ptrdiff_t* offsets) {
+                    const T* arg_row = arg + offsets[0];
+                    T* out_row = out + offsets[1];
+                    if (reduce_row)
                     {
-                        out[output_transform.index(output_coord)] = x;
+                        T acc = *out_row;
+                        for (size_t i = 0; i < n; i++)
+                        {
+                            if (arg_row[i] < acc)
+                            {
+                                acc = arg_row[i];
+                            }
+                        }
+                        *out_row = acc;
                     }
-                }
+                    else
+                    {
+                        for (size_t i = 0; i < n; i++)
+                        {
+                            if (arg_row[i] < out_row[i])
+                            {
+                                out_row[i] = arg_row[i];
+                            }
+                        }
+                    }
+                });
             }
         }
     }
@@ -18,8 +18,7 @@
 
 #include <cmath>
 
-#include "ngraph/axis_vector.hpp"
-#include "ngraph/coordinate_transform.hpp"
+#include "ngraph/strided_transform.hpp"
 
 namespace ngraph
 {
@@ -37,58 +36,36 @@ namespace ngraph
                      const Shape& padding_above,
                      const Shape& padding_interior)
             {
-                Coordinate input_start(arg0_shape.size(), 0); // start at (0,0,...,0)
-                Coordinate input_end =
-                    out_shape; // end at (d'0,d'1,...,d'n), the outer corner of the post-padding shape
-
-                Strides input_strides(arg0_shape.size(), 1);
-
-                AxisVector input_axis_order(arg0_shape.size());
-                for (size_t i = 0; i < arg0_shape.size(); i++)
+                for (size_t i = 0; i < shape_size(out_shape); i++)
                 {
-                    input_axis_order[i] = i;
+                    out[i] = *arg1;
                 }
 
-                Strides input_dilation(arg0_shape.size());
+                // Scatter the input into the output, skipping the interior padding between its
+                // elements and starting after the padding below.
+                CoordinateDiff out_strides = StridedTransform::row_major_strides(out_shape);
+                std::ptrdiff_t out_offset = 0;
                 for (size_t i = 0; i < arg0_shape.size(); i++)
                 {
-                    input_dilation[i] = padding_interior[i] + 1;
-                }
-
-                // Need to cast these to CoordinateDiff in order to make CoordinateTransform happy.
-                CoordinateDiff padding_below_signed;
-                CoordinateDiff padding_above_signed;
-
-                for (size_t i = 0; i < padding_below.size(); i++)
-                {
-                    padding_below_signed.push_back(padding_below[i]);
-                    padding_above_signed.push_back(padding_above[i]);
+                    out_offset += padding_below[i] * out_strides[i];
+                    out_strides[i] *= padding_interior[i] + 1;
                 }
 
-                CoordinateTransform input_transform(arg0_shape,
-                                                    input_start,
-                                                    input_end,
-                                                    input_strides,
-                                                    input_axis_order,
-                                                    padding_below_signed,
-                                                    padding_above_signed,
-                                                    input_dilation);
-                CoordinateTransform output_transform(out_shape);
+                StridedTransform transform(
+                    arg0_shape,
+                    {StridedTransform::row_major_strides(arg0_shape), out_strides},
+                    {0, out_offset});
+                size_t n = transform.get_inner_size();
+                std::ptrdiff_t out_stride = transform.get_inner_stride(1);
 
-                CoordinateTransform::Iterator output_it = output_transform.begin();
-
-                for (const Coordinate& in_coord : input_transform)
-                {
-                    const Coordinate& out_coord = *output_it;
-
-                    T v = input_transform.has_source_coordinate(in_coord)
-                              ? arg0[input_transform.index(in_coord)]
-                              : *arg1;
-
-                    out[output_transform.index(out_coord)] = v;
-
-                    ++output_it;
-                }
+                transform.for_each_row([&](const std::ptrdiff_t* offsets) {
+                    const T* arg_row = arg0 + offsets[0];
+                    T* out_row = out + offsets[1];
+                    for (size_t i = 0; i < n; i++)
+                    {
+                        out_row[i * out_stride] = arg_row[i];
+                    }
+                });
             }
         }
     }
@@ -18,7 +18,7 @@
 
 #include <cmath>
 
-#include "ngraph/coordinate_transform.hpp"
+#include "ngraph/strided_transform.hpp"
 
 namespace ngraph
 {
@@ -33,22 +33,40 @@ namespace ngraph
                          const Shape& out_shape,
                          const AxisSet& reduction_axes)
             {
-                CoordinateTransform output_transform(out_shape);
-
-                for (const Coordinate& output_coord : output_transform)
+                for (size_t i = 0; i < shape_size(out_shape); i++)
                 {
-                    out[output_transform.index(output_coord)] = 1;
+                    out[i] = 1;
                 }
 
-                CoordinateTransform input_transform(in_shape);
-
-                for (const Coordinate& input_coord : input_transform)
-                {
-                    Coordinate output_coord = project(input_coord, reduction_axes);
+                // Reduced axes have a stride of 0 in the output, so a row either reduces into a
+                // single output element or updates a row of the output elementwise.
+                StridedTransform transform(
+                    in_shape,
+                    {StridedTransform::row_major_strides(in_shape),
+                     StridedTransform::projected_strides(in_shape, reduction_axes)});
+                size_t n = transform.get_inner_size();
+                bool reduce_row = transform.get_inner_stride(1) == 0;
 
-                    out[output_transform.index(output_coord)] *=
-                        arg[input_transform.index(input_coord)];
-                }
+                transform.for_each_row([&](const std::ptrdiff_t* offsets) {
+                    const T* arg_row = arg + offsets[0];
+                    T* out_row = out + offsets[1];
+                    if (reduce_row)
+                    {
+                        T acc = *out_row;
+                        for (size_t i = 0; i < n; i++)
+                        {
+                            acc *= arg_row[i];
+                        }
+                        *out_row = acc;
+                    }
+                    else
+                    {
+                        for (size_t i = 0; i < n; i++)
+                        {
+                            out_row[i] *= arg_row[i];
+                        }
+                    }
+                });
             }
         }
     }
@@ -18,7 +18,7 @@
 
 #include <cmath>
 
-#include "ngraph/coordinate_transform.hpp"
+#include "ngraph/strided_transform.hpp"
 
 namespace ngraph
 {
@@ -37,29 +37,35 @@ namespace ngraph
                                const Shape& out_shape)
             {
                 // Step 1: Copy the entire replacement context to the output.
-                CoordinateTransform copy_transform(out_shape);
-
-                for (Coordinate copy_coord : copy_transform)
+                for (size_t i = 0; i < shape_size(out_shape); i++)
                 {
-                    out[copy_transform.index(copy_coord)] = arg0[copy_transform.index(copy_coord)];
+                    out[i] = arg0[i];
                 }
 
                 // Step 2: Overwrite the slice for replacement.
-                CoordinateTransform input_transform(arg1_shape);
-                CoordinateTransform output_transform(
-                    out_shape, lower_bounds, upper_bounds, strides);
-
-                CoordinateTransform::Iterator output_it = output_transform.begin();
-
-                for (const Coordinate& input_coord : input_transform)
+                CoordinateDiff out_strides = StridedTransform::row_major_strides(out_shape);
+                std::ptrdiff_t out_offset = 0;
+                for (size_t i = 0; i < out_shape.size(); i++)
                 {
-                    const Coordinate& output_coord = *output_it;
+                    out_offset += lower_bounds[i] * out_strides[i];
+                    out_strides[i] *= strides[i];
+                }
 
-                    out[output_transform.index(output_coord)] =
-                        arg1[input_transform.index(input_coord)];
+                StridedTransform transform(
+                    arg1_shape,
+                    {StridedTransform::row_major_strides(arg1_shape), out_strides},
+                    {0, out_offset});
+                size_t n = transform.get_inner_size();
+                std::ptrdiff_t out_stride = transform.get_inner_stride(1);
 
-                    ++output_it;
-                }
+                transform.for_each_row([&](const std::ptrdiff_t* offsets) {
+                    const T* arg_row = arg1 + offsets[0];
+                    T* out_row = out + offsets[1];
+                    for (size_t i = 0; i < n; i++)
+                    {
+                        out_row[i * out_stride] = arg_row[i];
+                    }
+                });
             }
         }
     }
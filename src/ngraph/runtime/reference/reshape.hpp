@@ -19,7 +19,7 @@
 #include <cmath>
 
 #include "ngraph/axis_vector.hpp"
-#include "ngraph/coordinate_transform.hpp"
+#include "ngraph/strided_transform.hpp"
 
 namespace ngraph
 {
@@ -34,26 +34,31 @@ namespace ngraph
                          const AxisVector& in_axis_order,
                          const Shape& out_shape)
             {
-                // Unfortunately we don't yet have a constructor for CoordinateTransform that lets us pass only source_space_shape
-                // and source_axis_order so we have to construct the defaults here.
-                Shape in_start_corner(in_shape.size(), 0); // (0,...0)
-                Strides in_strides(in_shape.size(), 1);    // (1,...,1)
-
-                CoordinateTransform input_transform(
-                    in_shape, in_start_corner, in_shape, in_strides, in_axis_order);
-
-                CoordinateTransform output_transform(out_shape);
-                CoordinateTransform::Iterator output_it = output_transform.begin();
-
-                for (const Coordinate& input_coord : input_transform)
+                // Walk the input in the permuted axis order; the output is written densely in
+                // the same order, whatever shape it is given.
+                CoordinateDiff in_strides = StridedTransform::row_major_strides(in_shape);
+                Shape permuted_shape;
+                CoordinateDiff arg_strides;
+                for (size_t axis : in_axis_order)
                 {
-                    const Coordinate& output_coord = *output_it;
+                    permuted_shape.push_back(in_shape[axis]);
+                    arg_strides.push_back(in_strides[axis]);
+                }
 
-                    out[output_transform.index(output_coord)] =
-                        arg[input_transform.index(input_coord)];
+                StridedTransform transform(
+                    permuted_shape,
+                    {StridedTransform::row_major_strides(permuted_shape), arg_strides});
+                size_t n = transform.get_inner_size();
+                std::ptrdiff_t arg_stride = transform.get_inner_stride(1);
 
-                    ++output_it;
-                }
+                transform.for_each_row([&](const std::ptrdiff_t* offsets) {
+                    T* out_row = out + offsets[0];
+                    const T* arg_row = arg + offsets[1];
+                    for (size_t i = 0; i < n; i++)
+                    {
+                        out_row[i] = arg_row[i * arg_stride];
+                    }
+                });
             }
         }
     }
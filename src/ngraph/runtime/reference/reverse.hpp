@@ -18,7 +18,7 @@
 
 #include <cmath>
 
-#include "ngraph/coordinate_transform.hpp"
+#include "ngraph/strided_transform.hpp"
 
 namespace ngraph
 {
@@ -34,23 +34,33 @@ namespace ngraph
                          const AxisSet& reversed_axes)
             {
                 // In fact arg_shape == out_shape, but we'll use both for stylistic consistency with other kernels.
-                CoordinateTransform arg_transform(arg_shape);
-                CoordinateTransform output_transform(out_shape);
-
-                for (Coordinate out_coord : output_transform)
+                // Reversed axes are read backwards from their last element.
+                CoordinateDiff arg_strides = StridedTransform::row_major_strides(arg_shape);
+                std::ptrdiff_t arg_offset = 0;
+                for (size_t i = 0; i < arg_shape.size(); i++)
                 {
-                    Coordinate arg_coord = out_coord;
-
-                    for (size_t i = 0; i < arg_coord.size(); i++)
+                    if (reversed_axes.count(i) != 0)
                     {
-                        if (reversed_axes.count(i) != 0)
-                        {
-                            arg_coord[i] = arg_shape[i] - arg_coord[i] - 1;
-                        }
+                        arg_offset += (std::ptrdiff_t(arg_shape[i]) - 1) * arg_strides[i];
+                        arg_strides[i] = -arg_strides[i];
                     }
-
-                    out[output_transform.index(out_coord)] = arg[arg_transform.index(arg_coord)];
                 }
+
+                StridedTransform transform(out_shape,
+                                           {StridedTransform::row_major_strides(out_shape),
+                                            arg_strides},
+                                           {0, arg_offset});
+                size_t n = transform.get_inner_size();
+                std::ptrdiff_t arg_stride = transform.get_inner_stride(1);
+
+                transform.for_each_row([&](const std::ptrdiff_t* offsets) {
+                    T* out_row = out + offsets[0];
+                    const T* arg_row = arg + offsets[1];
+                    for (size_t i = 0; i < n; i++)
+                    {
+                        out_row[i] = arg_row[std::ptrdiff_t(i) * arg_stride];
+                    }
+                });
             }
         }
     }
@@ -18,7 +18,7 @@
 
 #include <cmath>
 
-#include "ngraph/coordinate_transform.hpp"
+#include "ngraph/strided_transform.hpp"
 
 namespace ngraph
 {
@@ -35,19 +35,29 @@ namespace ngraph
                        const Strides& strides,
                        const Shape& out_shape)
             {
-                CoordinateTransform input_transform(arg_shape, lower_bounds, upper_bounds, strides);
-                CoordinateTransform output_transform(out_shape);
-
-                CoordinateTransform::Iterator output_it = output_transform.begin();
-
-                for (const Coordinate& in_coord : input_transform)
+                CoordinateDiff arg_strides = StridedTransform::row_major_strides(arg_shape);
+                std::ptrdiff_t arg_offset = 0;
+                for (size_t i = 0; i < arg_shape.size(); i++)
                 {
-                    const Coordinate& out_coord = *output_it;
+                    arg_offset += lower_bounds[i] * arg_strides[i];
+                    arg_strides[i] *= strides[i];
+                }
 
-                    out[output_transform.index(out_coord)] = arg[input_transform.index(in_coord)];
+                StridedTransform transform(out_shape,
+                                           {StridedTransform::row_major_strides(out_shape),
+                                            arg_strides},
+                                           {0, arg_offset});
+                size_t n = transform.get_inner_size();
+                std::ptrdiff_t arg_stride = transform.get_inner_stride(1);
 
-                    ++output_it;
-                }
+                transform.for_each_row([&](const std::ptrdiff_t* offsets) {
+                    T* out_row = out + offsets[0];
+                    const T* arg_row = arg + offsets[1];
+                    for (size_t i = 0; i < n; i++)
+                    {
+                        out_row[i] = arg_row[i * arg_stride];
+                    }
+                });
             }
         }
     }
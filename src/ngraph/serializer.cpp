@@ -99,6 +99,10 @@ using namespace std;
 using json = nlohmann::json;
 using const_data_callback_t = shared_ptr<Node>(const string&, const element::Type&, const Shape&);
 
+// Constants of at least a page start on a page boundary in cpio archives so that every
+// process mapping the same model shares their pages
+static const size_t s_page_size = 4096;
+
 // This expands the op list in op_tbl.hpp into a list of enumerations that look like this:
 // Abs,
 // Acos,
@@ -198,7 +202,9 @@ void ngraph::serialize(ostream& out, shared_ptr<ngraph::Function> func, size_t i
                                uint32_t size =
                                    static_cast<uint32_t>(shape_size(c->get_output_shape(0)) *
                                                          c->get_output_element_type(0).size());
-                               writer.write(c->get_name(), c->get_data_ptr(), size);
+                               // Place constant data so deserialize can map it in place
+                               size_t alignment = size >= s_page_size ? s_page_size : 64;
+                               writer.write(c->get_name(), c->get_data_ptr(), size, alignment);
                            }
                        },
                        true);
@@ -236,47 +242,64 @@ std::string ngraph::serialize(std::shared_ptr<ngraph::Function> func, size_t ind
     return ::serialize(func, indent, false);
 }
 
-shared_ptr<ngraph::Function> ngraph::deserialize(istream& in)
+static shared_ptr<ngraph::Function> deserialize_cpio(istream& in,
+                                                     const shared_ptr<const char>& mapping)
 {
     shared_ptr<Function> rc;
-    if (cpio::is_cpio(in))
+    cpio::Reader reader(in);
+    vector<cpio::FileInfo> file_info = reader.get_file_info();
+    if (file_info.size() > 0)
     {
-        cpio::Reader reader(in);
-        vector<cpio::FileInfo> file_info = reader.get_file_info();
-        if (file_info.size() > 0)
+        // The first file is the model
+        uint32_t size = static_cast<uint32_t>(file_info[0].get_size());
+        char* data = new char[size];
+        reader.read(file_info[0].get_name(), data, size);
+        string jstr(data, size);
+        delete[] data;
+        json js = json::parse(jstr);
+        unordered_map<string, shared_ptr<Function>> function_map;
+        for (json func : js)
         {
-            // The first file is the model
-            uint32_t size = static_cast<uint32_t>(file_info[0].get_size());
-            char* data = new char[size];
-            reader.read(file_info[0].get_name(), data, size);
-            string jstr(data, size);
-            delete[] data;
-            json js = json::parse(jstr);
-            unordered_map<string, shared_ptr<Function>> function_map;
-            for (json func : js)
-            {
-                shared_ptr<Function> f = read_function(
-                    func,
-                    function_map,
-                    [&](const string& const_name, const element::Type& et, const Shape& shape) {
-                        shared_ptr<Node> const_node;
-                        for (const cpio::FileInfo& info : file_info)
+            shared_ptr<Function> f = read_function(
+                func,
+                function_map,
+                [&](const string& const_name, const element::Type& et, const Shape& shape) {
+                    shared_ptr<Node> const_node;
+                    for (const cpio::FileInfo& info : file_info)
+                    {
+                        if (info.get_name() == const_name)
                         {
-                            if (info.get_name() == const_name)
+                            const char* mapped =
+                                mapping ? mapping.get() + info.get_offset() : nullptr;
+                            if (mapped && reinterpret_cast<uintptr_t>(mapped) % et.size() == 0)
+                            {
+                                const_node = make_shared<op::Constant>(et, shape, mapped, mapping);
+                            }
+                            else
                             {
                                 void* const_data = malloc(info.get_size());
                                 reader.read(const_name, const_data, info.get_size());
                                 const_node = make_shared<op::Constant>(et, shape, const_data);
                                 free(const_data);
-                                break;
                             }
+                            break;
                         }
-                        return const_node;
-                    });
-                rc = f;
-            }
+                    }
+                    return const_node;
+                });
+            rc = f;
         }
     }
+    return rc;
+}
+
+shared_ptr<ngraph::Function> ngraph::deserialize(istream& in)
+{
+    shared_ptr<Function> rc;
+    if (cpio::is_cpio(in))
+    {
+        rc = deserialize_cpio(in, nullptr);
+    }
     else
     {
         // json file?
@@ -294,7 +317,17 @@ shared_ptr<ngraph::Function> ngraph::deserialize(const string& s)
     {
         // s is a file and not a json string
         ifstream in(s, ios_base::binary | ios_base::in);
-        rc = deserialize(in);
+        if (cpio::is_cpio(in))
+        {
+            // Constants point straight into the mapped file instead of being copied
+            size_t size;
+            shared_ptr<const char> mapping = file_util::map_file_contents(s, size);
+            rc = deserialize_cpio(in, mapping);
+        }
+        else
+        {
+            rc = deserialize(in);
+        }
     }
     else
     {
@@ -330,7 +363,8 @@ static json write(const Function& f, bool binary_constant_data)
 
     Function* pf = const_cast<Function*>(&f);
     json nodes;
-    for (shared_ptr<Node> node : pf->get_ordered_ops(true))
+    auto ordered_ops = pf->get_ordered_ops_view(true);
+    for (const shared_ptr<Node>& node : *ordered_ops)
     {
         nodes.push_back(write(*node, binary_constant_data));
     }
@@ -53,6 +53,8 @@ namespace ngraph
     std::shared_ptr<ngraph::Function> deserialize(std::istream& in);
 
     /// \brief Deserialize a Function
-    /// \param str The json formatted string to deseriailze.
+    /// \param str The json formatted string to deseriailze, or the path of a file. Constant
+    ///    data in a CPIO file is memory mapped rather than copied, so the file must not be
+    ///    modified while the returned Function or any copy of its constants is alive.
     std::shared_ptr<ngraph::Function> deserialize(const std::string& str);
 }
@@ -0,0 +1,122 @@
+//*****************************************************************************
+// Copyright 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <sstream>
+#include <stdexcept>
+
+#include "ngraph/strided_transform.hpp"
+
+using namespace ngraph;
+
+StridedTransform::StridedTransform(const Shape& shape,
+                                   const std::vector<CoordinateDiff>& strides,
+                                   const CoordinateDiff& offsets)
+    : m_offsets(offsets.empty() ? CoordinateDiff(strides.size(), 0) : offsets)
+    , m_inner_size(1)
+    , m_inner_strides(strides.size(), 0)
+    , m_empty(shape_size(shape) == 0)
+{
+    size_t n_operands = strides.size();
+
+    if (m_offsets.size() != n_operands)
+    {
+        throw std::domain_error("Strided transform offsets do not match the number of operands");
+    }
+    for (size_t i = 0; i < n_operands; i++)
+    {
+        if (strides[i].size() != shape.size())
+        {
+            std::stringstream ss;
+            ss << "Strides of operand " << i
+               << " do not have the same number of axes as the index space";
+            throw std::domain_error(ss.str());
+        }
+    }
+
+    // Collapse the axes from the innermost outwards. An axis merges into the one inside it
+    // when, for every operand, stepping it once is the same as stepping the inner axis
+    // through its whole length.
+    Shape collapsed_shape;
+    std::vector<CoordinateDiff> collapsed_strides;
+    for (size_t axis = shape.size(); axis-- > 0;)
+    {
+        if (shape[axis] == 1)
+        {
+            continue;
+        }
+
+        bool mergeable = !collapsed_shape.empty();
+        for (size_t i = 0; mergeable && i < n_operands; i++)
+        {
+            mergeable = strides[i][axis] == collapsed_strides.back()[i] *
+                                                std::ptrdiff_t(collapsed_shape.back());
+        }
+
+        if (mergeable)
+        {
+            collapsed_shape.back() *= shape[axis];
+        }
+        else
+        {
+            collapsed_shape.push_back(shape[axis]);
+            CoordinateDiff axis_strides(n_operands);
+            for (size_t i = 0; i < n_operands; i++)
+            {
+                axis_strides[i] = strides[i][axis];
+            }
+            collapsed_strides.push_back(axis_strides);
+        }
+    }
+
+    if (!collapsed_shape.empty())
+    {
+        m_inner_size = collapsed_shape.front();
+        m_inner_strides = collapsed_strides.front();
+    }
+    for (size_t axis = collapsed_shape.size(); axis-- > 1;)
+    {
+        m_outer_shape.push_back(collapsed_shape[axis]);
+        m_outer_strides.insert(
+            m_outer_strides.end(), collapsed_strides[axis].begin(), collapsed_strides[axis].end());
+    }
+}
+
+CoordinateDiff StridedTransform::row_major_strides(const Shape& shape)
+{
+    CoordinateDiff strides(shape.size());
+    std::ptrdiff_t stride = 1;
+    for (size_t axis = shape.size(); axis-- > 0;)
+    {
+        strides[axis] = stride;
+        stride *= shape[axis];
+    }
+    return strides;
+}
+
+CoordinateDiff StridedTransform::projected_strides(const Shape& shape, const AxisSet& deleted_axes)
+{
+    CoordinateDiff strides(shape.size());
+    std::ptrdiff_t stride = 1;
+    for (size_t axis = shape.size(); axis-- > 0;)
+    {
+        if (deleted_axes.count(axis) == 0)
+        {
+            strides[axis] = stride;
+            stride *= shape[axis];
+        }
+    }
+    return strides;
+}
@@ -0,0 +1,119 @@
+//*****************************************************************************
+// Copyright 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <vector>
+
+#include "ngraph/axis_set.hpp"
+#include "ngraph/coordinate_diff.hpp"
+#include "ngraph/shape.hpp"
+
+namespace ngraph
+{
+    /// \brief Walks a row-major index space on behalf of several strided buffers.
+    ///
+    /// Every operand (a buffer taking part in the walk) is described by its element stride
+    /// along each axis of the index space and by the element offset of index (0,...,0). A
+    /// stride of 0 repeats an element, e.g. for broadcasts and reductions; negative strides
+    /// walk backwards. Axes of length 1 are dropped and adjacent axes that are contiguous for
+    /// every operand are merged, so the innermost loop is as long as possible.
+    ///
+    /// Instead of one Coordinate per element, for_each_row calls its callback once per
+    /// innermost row with the offset of the first element of that row in each operand. The
+    /// callback walks get_inner_size() elements with the fixed get_inner_stride(operand),
+    /// which is a flat loop the compiler can vectorize when the strides are 1.
+    class StridedTransform
+    {
+    public:
+        /// \param shape The shape of the index space.
+        /// \param strides For every operand, the element stride of each axis of shape.
+        /// \param offsets For every operand, the element offset of index (0,...,0). Defaults
+        ///                to 0 for every operand.
+        StridedTransform(const Shape& shape,
+                         const std::vector<CoordinateDiff>& strides,
+                         const CoordinateDiff& offsets = CoordinateDiff());
+
+        /// \brief Returns the element strides of a dense row-major tensor of shape.
+        static CoordinateDiff row_major_strides(const Shape& shape);
+
+        /// \brief Returns the strides, along each axis of shape, of a dense row-major tensor of
+        ///        shape with deleted_axes removed, and 0 along deleted_axes. These are the strides
+        ///        of the input of a broadcast or of the output of a reduction.
+        static CoordinateDiff projected_strides(const Shape& shape, const AxisSet& deleted_axes);
+
+        size_t get_inner_size() const { return m_inner_size; }
+        std::ptrdiff_t get_inner_stride(size_t operand) const { return m_inner_strides[operand]; }
+        /// \brief Calls f(const std::ptrdiff_t* offsets) once per innermost row, in row-major
+        ///        order, where offsets[i] is the element offset of the row in operand i.
+        template <typename F>
+        void for_each_row(F f) const
+        {
+            if (m_empty)
+            {
+                return;
+            }
+
+            size_t n_operands = m_offsets.size();
+            size_t n_outer = m_outer_shape.size();
+            CoordinateDiff offsets = m_offsets;
+            Shape counter(n_outer, 0);
+
+            while (true)
+            {
+                f(offsets.data());
+
+                // Advance the outer axes like an odometer, innermost first.
+                size_t axis = n_outer;
+                while (axis > 0)
+                {
+                    axis--;
+                    const std::ptrdiff_t* strides = &m_outer_strides[axis * n_operands];
+                    if (++counter[axis] < m_outer_shape[axis])
+                    {
+                        for (size_t i = 0; i < n_operands; i++)
+                        {
+                            offsets[i] += strides[i];
+                        }
+                        break;
+                    }
+                    counter[axis] = 0;
+                    for (size_t i = 0; i < n_operands; i++)
+                    {
+                        offsets[i] -= strides[i] * std::ptrdiff_t(m_outer_shape[axis] - 1);
+                    }
+                    if (axis == 0)
+                    {
+                        return;
+                    }
+                }
+                if (n_outer == 0)
+                {
+                    return;
+                }
+            }
+        }
+
+    private:
+        CoordinateDiff m_offsets;
+        size_t m_inner_size;
+        CoordinateDiff m_inner_strides;
+        // Outermost axis first; the strides of all operands of an axis are adjacent.
+        Shape m_outer_shape;
+        CoordinateDiff m_outer_strides;
+        bool m_empty;
+    };
+}
@@ -0,0 +1,116 @@
+//*****************************************************************************
+// Copyright 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <string>
+
+namespace ngraph
+{
+    /// \brief Brain floating point: the upper 16 bits of an IEEE float, so it has the range of
+    ///        float with 8 bits of precision. Arithmetic converts to float and rounds the
+    ///        result back to nearest even.
+    class bfloat16
+    {
+    public:
+        bfloat16() = default;
+        bfloat16(float value)
+            : m_value{round_to_nearest_even(value)}
+        {
+        }
+
+        operator float() const
+        {
+            uint32_t bits = static_cast<uint32_t>(m_value) << 16;
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        template <typename T>
+        bfloat16& operator+=(const T& other)
+        {
+            return *this = static_cast<float>(*this) + other;
+        }
+        template <typename T>
+        bfloat16& operator-=(const T& other)
+        {
+            return *this = static_cast<float>(*this) - other;
+        }
+        template <typename T>
+        bfloat16& operator*=(const T& other)
+        {
+            return *this = static_cast<float>(*this) * other;
+        }
+        template <typename T>
+        bfloat16& operator/=(const T& other)
+        {
+            return *this = static_cast<float>(*this) / other;
+        }
+
+        static bfloat16 from_bits(uint16_t bits)
+        {
+            bfloat16 result;
+            result.m_value = bits;
+            return result;
+        }
+        uint16_t to_bits() const { return m_value; }
+        std::string to_string() const;
+
+        /// \return The upper 16 bits of value rounded to nearest even; NaNs stay quiet NaNs
+        static uint16_t round_to_nearest_even(float value)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            if ((bits & 0x7fffffff) > 0x7f800000)
+            {
+                return static_cast<uint16_t>((bits >> 16) | 0x40);
+            }
+            return static_cast<uint16_t>((bits + 0x7fff + ((bits >> 16) & 1)) >> 16);
+        }
+
+    private:
+        uint16_t m_value{0};
+    };
+
+    std::ostream& operator<<(std::ostream& out, const bfloat16& obj);
+}
+
+namespace std
+{
+    template <>
+    class numeric_limits<ngraph::bfloat16>
+    {
+    public:
+        static constexpr bool is_specialized = true;
+        static constexpr bool is_signed = true;
+        static constexpr bool is_integer = false;
+        static constexpr bool is_exact = false;
+        static constexpr bool has_infinity = true;
+        static constexpr bool has_quiet_NaN = true;
+        static constexpr int digits = 8;
+        static ngraph::bfloat16 min() { return ngraph::bfloat16::from_bits(0x0080); }
+        static ngraph::bfloat16 max() { return ngraph::bfloat16::from_bits(0x7f7f); }
+        static ngraph::bfloat16 lowest() { return ngraph::bfloat16::from_bits(0xff7f); }
+        static ngraph::bfloat16 epsilon() { return ngraph::bfloat16::from_bits(0x3c00); }
+        static ngraph::bfloat16 infinity() { return ngraph::bfloat16::from_bits(0x7f80); }
+        static ngraph::bfloat16 quiet_NaN() { return ngraph::bfloat16::from_bits(0x7fc0); }
+    };
+}
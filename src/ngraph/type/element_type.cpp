@@ -23,6 +23,8 @@ using namespace ngraph;
 
 const element::Type element::unspecified(0, false, false, "unspecified");
 const element::Type element::boolean(8, false, true, "char");
+const element::Type element::bf16(16, true, true, "bfloat16");
+const element::Type element::f16(16, true, true, "float16");
 const element::Type element::f32(32, true, true, "float");
 const element::Type element::f64(64, true, true, "double");
 const element::Type element::i8(8, false, true, "int8_t");
@@ -37,6 +39,8 @@ const element::Type element::u64(64, false, false, "uint64_t");
 std::vector<const element::Type*> element::Type::get_known_types()
 {
     std::vector<const element::Type*> rc = {&element::boolean,
+                                            &element::bf16,
+                                            &element::f16,
                                             &element::f32,
                                             &element::f64,
                                             &element::i8,
@@ -88,7 +92,8 @@ bool element::Type::operator<(const Type& other) const
     v2 |= static_cast<size_t>(other.m_is_real ? 2 : 0);
     v2 |= static_cast<size_t>(other.m_is_signed ? 1 : 0);
 
-    return v1 < v2;
+    // bf16 and f16 only differ by name
+    return v1 < v2 || (v1 == v2 && m_cname < other.m_cname);
 }
 
 size_t element::Type::size() const
@@ -119,6 +124,16 @@ namespace ngraph
             return boolean;
         }
         template <>
+        const Type& from<bfloat16>()
+        {
+            return bf16;
+        }
+        template <>
+        const Type& from<float16>()
+        {
+            return f16;
+        }
+        template <>
         const Type& from<float>()
         {
             return f32;
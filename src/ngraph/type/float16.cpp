@@ -0,0 +1,112 @@
+//*****************************************************************************
+// Copyright 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <cmath>
+#include <cstring>
+#include <sstream>
+
+#include "ngraph/type/float16.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+uint16_t float16::round_to_nearest_even(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+    uint32_t magnitude = bits & 0x7fffffff;
+
+    if (magnitude >= 0x7f800000)
+    {
+        // Infinity, or a NaN that keeps its upper payload bits and stays quiet
+        uint16_t nan_bits =
+            magnitude > 0x7f800000 ? static_cast<uint16_t>(0x200 | (magnitude >> 13)) : 0;
+        return sign | 0x7c00 | (nan_bits & 0x3ff);
+    }
+    // 65520 is halfway between the largest half, 65504, and infinity and rounds to even
+    if (magnitude >= 0x477ff000)
+    {
+        return sign | 0x7c00;
+    }
+    // Below the smallest normal half, 2^-14, the result is a multiple of 2^-24
+    if (magnitude < 0x38800000)
+    {
+        // Half of 2^-24 and less round to zero
+        if (magnitude < 0x33000000)
+        {
+            return sign;
+        }
+        uint32_t exponent = magnitude >> 23;
+        uint32_t mantissa = (magnitude & 0x7fffff) | 0x800000;
+        uint32_t shift = 126 - exponent;
+        uint32_t result = mantissa >> shift;
+        uint32_t remainder = mantissa & ((1u << shift) - 1);
+        uint32_t halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (result & 1)))
+        {
+            result++;
+        }
+        return sign | static_cast<uint16_t>(result);
+    }
+    // Rebias the exponent from 127 to 15 and drop 13 mantissa bits. A carry out of the
+    // mantissa correctly moves on to the next exponent.
+    uint32_t result = (magnitude >> 13) - ((127 - 15) << 10);
+    uint32_t remainder = magnitude & 0x1fff;
+    if (remainder > 0x1000 || (remainder == 0x1000 && (result & 1)))
+    {
+        result++;
+    }
+    return sign | static_cast<uint16_t>(result);
+}
+
+float float16::to_float(uint16_t bits)
+{
+    uint32_t sign = static_cast<uint32_t>(bits & 0x8000) << 16;
+    uint32_t exponent = (bits >> 10) & 0x1f;
+    uint32_t mantissa = bits & 0x3ff;
+    uint32_t result;
+    if (exponent == 0x1f)
+    {
+        // NaNs come out quiet
+        result = sign | 0x7f800000 | (mantissa ? 0x400000 | (mantissa << 13) : 0);
+    }
+    else if (exponent == 0)
+    {
+        // Zero or subnormal
+        float value = ldexp(static_cast<float>(mantissa), -24);
+        return sign ? -value : value;
+    }
+    else
+    {
+        result = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+    }
+    float value;
+    memcpy(&value, &result, sizeof(value));
+    return value;
+}
+
+string float16::to_string() const
+{
+    stringstream ss;
+    ss << static_cast<float>(*this);
+    return ss.str();
+}
+
+ostream& ngraph::operator<<(ostream& out, const float16& obj)
+{
+    return out << static_cast<float>(obj);
+}
@@ -0,0 +1,100 @@
+//*****************************************************************************
+// Copyright 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <string>
+
+namespace ngraph
+{
+    /// \brief IEEE 754 half precision float, with 5 exponent and 10 mantissa bits. Arithmetic
+    ///        converts to float and rounds the result back to nearest even.
+    class float16
+    {
+    public:
+        float16() = default;
+        float16(float value)
+            : m_value{round_to_nearest_even(value)}
+        {
+        }
+
+        operator float() const { return to_float(m_value); }
+        template <typename T>
+        float16& operator+=(const T& other)
+        {
+            return *this = static_cast<float>(*this) + other;
+        }
+        template <typename T>
+        float16& operator-=(const T& other)
+        {
+            return *this = static_cast<float>(*this) - other;
+        }
+        template <typename T>
+        float16& operator*=(const T& other)
+        {
+            return *this = static_cast<float>(*this) * other;
+        }
+        template <typename T>
+        float16& operator/=(const T& other)
+        {
+            return *this = static_cast<float>(*this) / other;
+        }
+
+        static float16 from_bits(uint16_t bits)
+        {
+            float16 result;
+            result.m_value = bits;
+            return result;
+        }
+        uint16_t to_bits() const { return m_value; }
+        std::string to_string() const;
+
+        /// \return The half precision bits of value rounded to nearest even. Values beyond
+        ///         the largest half round to infinity and small ones to subnormals or zero.
+        static uint16_t round_to_nearest_even(float value);
+        static float to_float(uint16_t bits);
+
+    private:
+        uint16_t m_value{0};
+    };
+
+    std::ostream& operator<<(std::ostream& out, const float16& obj);
+}
+
+namespace std
+{
+    template <>
+    class numeric_limits<ngraph::float16>
+    {
+    public:
+        static constexpr bool is_specialized = true;
+        static constexpr bool is_signed = true;
+        static constexpr bool is_integer = false;
+        static constexpr bool is_exact = false;
+        static constexpr bool has_infinity = true;
+        static constexpr bool has_quiet_NaN = true;
+        static constexpr int digits = 11;
+        static ngraph::float16 min() { return ngraph::float16::from_bits(0x0400); }
+        static ngraph::float16 max() { return ngraph::float16::from_bits(0x7bff); }
+        static ngraph::float16 lowest() { return ngraph::float16::from_bits(0xfbff); }
+        static ngraph::float16 epsilon() { return ngraph::float16::from_bits(0x1400); }
+        static ngraph::float16 infinity() { return ngraph::float16::from_bits(0x7c00); }
+        static ngraph::float16 quiet_NaN() { return ngraph::float16::from_bits(0x7e00); }
+    };
+}
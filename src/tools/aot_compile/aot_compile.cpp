@@ -0,0 +1,219 @@
+//*****************************************************************************
+// Copyright 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+// tool to compile a serialized model ahead of time into a standalone shared library
+// that runs on the CPU backend kernels without the embedded clang/LLVM JIT.
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ngraph/file_util.hpp"
+#include "ngraph/op/result.hpp"
+#include "ngraph/runtime/cpu/cpu_external_function.hpp"
+#include "ngraph/serializer.hpp"
+#include "ngraph/util.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+void help()
+{
+    cout << R"###(
+DESCRIPTION
+    Compile a serialized model into a shared library using the CPU backend code generator
+
+SYNOPSIS
+        aot_compile [-i|--input <input file>] [-o|--output <output library>] [--cxx <compiler>]
+                    [--march <arch>] [-I <include dir>] [-L <library dir>] [--keep-source]
+
+OPTIONS
+        -i or --input    input serialized model
+        -o or --output   output shared library
+        --cxx            C++ compiler used to build the library (default: $CXX or c++)
+        --march          target CPU architecture (default: the NGRAPH_TARGET_ARCH of this build)
+        -I               additional include directory for the generated source
+        -L               additional library directory to link against
+        --keep-source    keep the generated <output>.cpp
+
+LIBRARY INTERFACE
+        size_t ngraph_get_input_count();
+        size_t ngraph_get_output_count();
+        void* ngraph_create_context();
+        void ngraph_call(void* context, void** inputs, void** outputs);
+        void ngraph_destroy_context(void* context);
+
+    Inputs and outputs are dense row-major buffers in Parameter and Result order. A context
+    owns the scratch memory for one call at a time; use one context per calling thread.
+    The library links the kernel archive libcpu_runtime.a and MKL's CBLAS, not libcpu_backend
+    or libngraph, so it carries no LLVM/clang.
+
+LIMITATIONS
+    MKLDNN primitives are created in the compiling process and cannot be emitted as source,
+    so the library runs convolutions, pooling and the other ops that the CPU backend gives to
+    MKLDNN on its reference kernels, and skips the fusions into MKLDNN-only ops. Expect those
+    ops to be slower than on the CPU backend. Functions with ops that only have MKLDNN
+    kernels, such as the quantized ops, are rejected. Parameters and results must have
+    default layouts.
+)###";
+}
+
+// Returns the value that follows option argv[i], or nullptr if it is missing
+static const char* get_option_value(int argc, char** argv, int& i)
+{
+    if (i + 1 >= argc)
+    {
+        cout << "missing value for option " << argv[i] << "\n";
+        return nullptr;
+    }
+    return argv[++i];
+}
+
+int main(int argc, char** argv)
+{
+    string input;
+    string output;
+    string cxx = getenv("CXX") ? getenv("CXX") : "c++";
+    string march = AOT_TARGET_ARCH;
+    vector<string> include_dirs = split(AOT_INCLUDE_DIRS, ':');
+    vector<string> library_dirs{AOT_LIBRARY_DIR};
+    bool keep_source = false;
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (arg == "--keep-source")
+        {
+            keep_source = true;
+        }
+        else if (arg == "-h" || arg == "--help")
+        {
+            help();
+            return 0;
+        }
+        else
+        {
+            const char* value = get_option_value(argc, argv, i);
+            if (value == nullptr)
+            {
+                return 1;
+            }
+            if (arg == "-o" || arg == "--output")
+            {
+                output = value;
+            }
+            else if (arg == "-i" || arg == "--input")
+            {
+                input = value;
+            }
+            else if (arg == "--cxx")
+            {
+                cxx = value;
+            }
+            else if (arg == "--march")
+            {
+                march = value;
+            }
+            else if (arg == "-I")
+            {
+                include_dirs.push_back(value);
+            }
+            else if (arg == "-L")
+            {
+                library_dirs.push_back(value);
+            }
+            else
+            {
+                cout << "unknown option " << arg << "\n";
+                return 1;
+            }
+        }
+    }
+
+    if (output.empty())
+    {
+        cout << "no output library specified\n";
+        return 1;
+    }
+
+    ifstream f(input);
+    if (!f)
+    {
+        cout << "failed to open '" << input << "' for input\n";
+        return 2;
+    }
+
+    string source_file = output + ".cpp";
+    try
+    {
+        shared_ptr<Function> function = deserialize(f);
+        for (auto result : function->get_results())
+        {
+            // Callers of the library exchange plain row-major buffers
+            static_pointer_cast<op::Result>(result)->set_needs_default_layout(true);
+        }
+
+        stopwatch timer;
+        timer.start();
+        auto external_function = make_shared<runtime::cpu::CPU_ExternalFunction>(function);
+        string source = external_function->emit_standalone_source();
+        timer.stop();
+        cout << "code generation took " << timer.get_milliseconds() << "ms\n";
+
+        ofstream out(source_file);
+        out << source;
+        out.close();
+    }
+    catch (const exception& e)
+    {
+        cout << "failed to generate code: " << e.what() << "\n";
+        return 3;
+    }
+
+    stringstream cmd;
+    // Eigen must not use LGPL code, as in the JIT
+    cmd << cxx << " -std=c++11 -O3 -march=" << march << " -fPIC -shared -DEIGEN_MPL2_ONLY";
+    for (const string& dir : include_dirs)
+    {
+        cmd << " -I" << dir;
+    }
+    cmd << " " << source_file << " -o " << output;
+    for (const string& dir : library_dirs)
+    {
+        cmd << " -L" << dir << " -Wl,-rpath," << dir;
+    }
+    cmd << " " << AOT_LIBRARIES;
+
+    cout << cmd.str() << "\n";
+    stopwatch timer;
+    timer.start();
+    int rc = system(cmd.str().c_str());
+    timer.stop();
+    if (!keep_source)
+    {
+        file_util::remove_file(source_file);
+    }
+    if (rc != 0)
+    {
+        cout << "compilation failed\n";
+        return 4;
+    }
+    cout << "compilation took " << timer.get_milliseconds() << "ms\n";
+
+    return 0;
+}
@@ -82,11 +82,12 @@ void init_int_tv<uint8_t>(shared_ptr<runtime::TensorView> tv, uint8_t min, uint8
     tv->write(vec.data(), 0, vec.size() * sizeof(uint8_t));
 }
 
-template <typename T>
+// bf16 and f16 values are drawn as float and rounded
+template <typename T, typename DrawType = T>
 void init_real_tv(shared_ptr<runtime::TensorView> tv, T min, T max)
 {
     size_t size = tv->get_element_count();
-    uniform_real_distribution<T> dist(min, max);
+    uniform_real_distribution<DrawType> dist(min, max);
     vector<T> vec(size);
     for (T& element : vec)
     {
@@ -95,13 +96,21 @@ void init_real_tv(shared_ptr<runtime::TensorView> tv, T min, T max)
     tv->write(vec.data(), 0, vec.size() * sizeof(T));
 }
 
-static void random_init(shared_ptr<runtime::TensorView> tv)
+void random_init(shared_ptr<runtime::TensorView> tv)
 {
     element::Type et = tv->get_tensor().get_element_type();
     if (et == element::boolean)
     {
         init_int_tv<char>(tv, 0, 1);
     }
+    else if (et == element::bf16)
+    {
+        init_real_tv<bfloat16, float>(tv, -1, 1);
+    }
+    else if (et == element::f16)
+    {
+        init_real_tv<float16, float>(tv, -1, 1);
+    }
     else if (et == element::f32)
     {
         init_real_tv<float>(tv, -1, 1);
@@ -23,11 +23,15 @@
 
 #include "ngraph/function.hpp"
 #include "ngraph/runtime/performance_counter.hpp"
+#include "ngraph/runtime/tensor_view.hpp"
 
 /// performance test utilities
 std::multimap<size_t, std::string>
     aggregate_timing(const std::vector<ngraph::runtime::PerformanceCounter>& perf_data);
 
+/// Fills tv with random values of its element type
+void random_init(std::shared_ptr<ngraph::runtime::TensorView> tv);
+
 std::vector<ngraph::runtime::PerformanceCounter> run_benchmark(std::shared_ptr<ngraph::Function> f,
                                                                const std::string& backend_name,
                                                                size_t iterations,
@@ -0,0 +1,259 @@
+//*****************************************************************************
+// Copyright 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "load_generator.hpp"
+#include "ngraph/file_util.hpp"
+#include "ngraph/runtime/backend.hpp"
+#include "ngraph/runtime/tensor_view.hpp"
+#include "nlohmann/json.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+typedef chrono::steady_clock Clock;
+
+// Returns the latency below which fraction of the sorted latencies lie
+static double get_percentile(const vector<double>& sorted, double fraction)
+{
+    if (sorted.empty())
+    {
+        return 0;
+    }
+    size_t rank = static_cast<size_t>(ceil(fraction * sorted.size()));
+    return sorted[max(rank, size_t(1)) - 1];
+}
+
+LoadResult run_load(shared_ptr<Function> f, const string& backend_name, const LoadOptions& options)
+{
+    auto backend = runtime::Backend::create(backend_name);
+    backend->compile(f);
+
+    size_t threads = max(options.threads, size_t(1));
+    vector<vector<shared_ptr<runtime::TensorView>>> client_args(threads);
+    vector<vector<shared_ptr<runtime::TensorView>>> client_results(threads);
+    for (size_t client = 0; client < threads; client++)
+    {
+        for (shared_ptr<op::Parameter> param : f->get_parameters())
+        {
+            auto tensor = backend->create_tensor(param->get_element_type(), param->get_shape());
+            random_init(tensor);
+            client_args[client].push_back(tensor);
+        }
+        for (shared_ptr<Node> out : f->get_results())
+        {
+            client_results[client].push_back(
+                backend->create_tensor(out->get_element_type(), out->get_shape()));
+        }
+    }
+
+    // Every client waits for the others to finish warming up so that the measured window
+    // starts with all of them running
+    vector<vector<double>> client_latencies(threads);
+    mutex start_mutex;
+    condition_variable start_changed;
+    size_t warmed_up = 0;
+    Clock::time_point start_time;
+    exception_ptr error;
+    mutex error_mutex;
+
+    auto client = [&](size_t client_index) {
+        try
+        {
+            auto& args = client_args[client_index];
+            auto& results = client_results[client_index];
+            for (size_t i = 0; i < options.warmup_calls; i++)
+            {
+                backend->call(f, results, args);
+            }
+            {
+                unique_lock<mutex> lock(start_mutex);
+                if (++warmed_up == threads)
+                {
+                    start_time = Clock::now();
+                    start_changed.notify_all();
+                }
+                start_changed.wait(lock, [&]() { return warmed_up >= threads; });
+            }
+
+            auto end_time = start_time + chrono::duration_cast<Clock::duration>(
+                                             chrono::duration<double>(options.duration_seconds));
+            // Open loop clients are staggered evenly across one interval
+            Clock::duration interval{0};
+            Clock::time_point scheduled = start_time;
+            if (options.qps > 0)
+            {
+                interval = chrono::duration_cast<Clock::duration>(
+                    chrono::duration<double>(threads / options.qps));
+                scheduled += interval * client_index / threads;
+            }
+
+            vector<double>& latencies = client_latencies[client_index];
+            while (true)
+            {
+                if (options.qps > 0)
+                {
+                    this_thread::sleep_until(scheduled);
+                }
+                else
+                {
+                    scheduled = Clock::now();
+                }
+                if (scheduled >= end_time)
+                {
+                    break;
+                }
+                backend->call(f, results, args);
+                latencies.push_back(
+                    chrono::duration<double, milli>(Clock::now() - scheduled).count());
+                scheduled += interval;
+            }
+        }
+        catch (...)
+        {
+            lock_guard<mutex> lock(error_mutex);
+            if (!error)
+            {
+                error = current_exception();
+            }
+            // Release the other clients if this one failed during warm up
+            lock_guard<mutex> start_lock(start_mutex);
+            if (warmed_up < threads)
+            {
+                warmed_up = threads;
+                start_time = Clock::now();
+                start_changed.notify_all();
+            }
+        }
+    };
+
+    vector<thread> client_threads;
+    for (size_t i = 0; i < threads; i++)
+    {
+        client_threads.emplace_back(client, i);
+    }
+    for (thread& t : client_threads)
+    {
+        t.join();
+    }
+    Clock::time_point stop_time = Clock::now();
+    if (error)
+    {
+        rethrow_exception(error);
+    }
+
+    vector<double> latencies;
+    for (const vector<double>& l : client_latencies)
+    {
+        latencies.insert(latencies.end(), l.begin(), l.end());
+    }
+    sort(latencies.begin(), latencies.end());
+
+    LoadResult result;
+    result.threads = threads;
+    result.target_qps = options.qps;
+    result.calls = latencies.size();
+    result.seconds = chrono::duration<double>(stop_time - start_time).count();
+    result.throughput = result.seconds > 0 ? result.calls / result.seconds : 0;
+    for (double latency : latencies)
+    {
+        result.mean += latency;
+    }
+    result.mean = latencies.empty() ? 0 : result.mean / latencies.size();
+    result.p50 = get_percentile(latencies, 0.5);
+    result.p90 = get_percentile(latencies, 0.9);
+    result.p99 = get_percentile(latencies, 0.99);
+    result.p999 = get_percentile(latencies, 0.999);
+    result.max = latencies.empty() ? 0 : latencies.back();
+    return result;
+}
+
+void print_load_result(const LoadResult& result)
+{
+    streamsize precision = cout.precision();
+    cout << result.threads << " clients, ";
+    if (result.target_qps > 0)
+    {
+        cout << "target " << result.target_qps << " calls/s";
+    }
+    else
+    {
+        cout << "closed loop";
+    }
+    cout << "\n";
+    cout << result.calls << " calls in " << fixed << setprecision(2) << result.seconds << "s, "
+         << result.throughput << " calls/s\n";
+    cout << "latency ms: mean " << setprecision(3) << result.mean << ", p50 " << result.p50
+         << ", p90 " << result.p90 << ", p99 " << result.p99 << ", p99.9 " << result.p999
+         << ", max " << result.max << endl;
+    cout.unsetf(ios::fixed);
+    cout.precision(precision);
+}
+
+void write_load_report(const LoadResult& result, const string& model, const string& file)
+{
+    if (file.size() >= 5 && file.compare(file.size() - 5, 5, ".json") == 0)
+    {
+        // The file holds an array with one entry per run
+        nlohmann::json runs = nlohmann::json::array();
+        if (file_util::exists(file))
+        {
+            ifstream in(file);
+            in >> runs;
+        }
+        runs.push_back({{"model", model},
+                        {"threads", result.threads},
+                        {"target_qps", result.target_qps},
+                        {"calls", result.calls},
+                        {"seconds", result.seconds},
+                        {"throughput", result.throughput},
+                        {"latency_ms",
+                         {{"mean", result.mean},
+                          {"p50", result.p50},
+                          {"p90", result.p90},
+                          {"p99", result.p99},
+                          {"p99.9", result.p999},
+                          {"max", result.max}}}});
+        ofstream out(file);
+        out << setw(4) << runs << endl;
+    }
+    else
+    {
+        bool write_header = !file_util::exists(file);
+        ofstream out(file, ios::app);
+        if (write_header)
+        {
+            out << "model,threads,target_qps,calls,seconds,throughput,mean_ms,p50_ms,p90_ms,"
+                   "p99_ms,p99.9_ms,max_ms\n";
+        }
+        out << model << "," << result.threads << "," << result.target_qps << "," << result.calls
+            << "," << result.seconds << "," << result.throughput << "," << result.mean << ","
+            << result.p50 << "," << result.p90 << "," << result.p99 << "," << result.p999 << ","
+            << result.max << "\n";
+    }
+}
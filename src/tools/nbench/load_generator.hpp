@@ -0,0 +1,67 @@
+//*****************************************************************************
+// Copyright 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "ngraph/function.hpp"
+
+/// How run_load drives the backend
+struct LoadOptions
+{
+    // Client threads, each calling the function with its own input and output tensors
+    size_t threads = 1;
+    // Calls per second over all clients. Each client starts its calls on a fixed schedule
+    // and latencies are measured from the scheduled start, so time spent waiting behind a
+    // slow call counts. 0 runs a closed loop in which every client calls again as soon as
+    // its previous call returns.
+    double qps = 0;
+    double duration_seconds = 10;
+    // Calls made by each client before measurement starts
+    size_t warmup_calls = 1;
+};
+
+/// Latency statistics of the calls made by run_load, in milliseconds
+struct LoadResult
+{
+    size_t threads = 0;
+    double target_qps = 0;
+    size_t calls = 0;
+    double seconds = 0;
+    double throughput = 0;
+    double mean = 0;
+    double p50 = 0;
+    double p90 = 0;
+    double p99 = 0;
+    double p999 = 0;
+    double max = 0;
+};
+
+/// Simulates serving f: runs options.threads clients calling f through Backend::call on a
+/// single backend for options.duration_seconds.
+LoadResult run_load(std::shared_ptr<ngraph::Function> f,
+                    const std::string& backend_name,
+                    const LoadOptions& options);
+
+void print_load_result(const LoadResult& result);
+
+/// Appends result to file as a CSV row, or writes it as JSON if file ends in .json. The CSV
+/// header is written when the file is created, so repeated runs build one table.
+void write_load_report(const LoadResult& result,
+                       const std::string& model,
+                       const std::string& file);
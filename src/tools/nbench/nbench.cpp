@@ -24,6 +24,8 @@
 #include <iomanip>
 
 #include "benchmark.hpp"
+#include "load_generator.hpp"
+#include "ngraph/cost_model.hpp"
 #include "ngraph/except.hpp"
 #include "ngraph/file_util.hpp"
 #include "ngraph/graph_util.hpp"
@@ -39,12 +41,14 @@ using namespace ngraph;
 class PerfShape : public ngraph::runtime::PerformanceCounter
 {
 public:
-    PerfShape(const runtime::PerformanceCounter& p, Shape s)
+    PerfShape(const runtime::PerformanceCounter& p, Shape s, const OpCost& c)
         : PerformanceCounter(p)
         , shape(s)
+        , cost(c)
     {
     }
     Shape shape;
+    OpCost cost;
 };
 
 unordered_map<string, shared_ptr<Node>> get_node_map(shared_ptr<Function> func)
@@ -71,7 +75,7 @@ vector<PerfShape> to_perf_shape(shared_ptr<Function> f,
     {
         auto node = node_map[p.name()];
         Shape shape = node->get_outputs()[0].get_shape();
-        result.push_back(PerfShape(p, shape));
+        result.push_back(PerfShape(p, shape, get_op_cost(*node)));
     }
     return result;
 }
@@ -133,6 +137,63 @@ void print_times(const multimap<size_t, string>& timing)
     }
 }
 
+// Compares the time of each op type/shape with the shortest time the roofline model allows
+// for its FLOPs and bytes on the machine set by NGRAPH_PEAK_GFLOPS and
+// NGRAPH_PEAK_GIGABYTES_PER_SECOND
+void print_roofline(const vector<PerfShape>& perf_data)
+{
+    struct Entry
+    {
+        size_t microseconds = 0;
+        OpCost cost;
+    };
+    map<string, Entry> entries;
+    for (const PerfShape& p : perf_data)
+    {
+        string op = p.name().substr(0, p.name().find('_'));
+        Entry& entry = entries[op + " {" + join(p.shape) + "}"];
+        entry.microseconds += p.microseconds();
+        entry.cost += p.cost;
+    }
+
+    vector<pair<string, Entry>> sorted(entries.begin(), entries.end());
+    sort(sorted.begin(),
+         sorted.end(),
+         [](const pair<string, Entry>& e1, const pair<string, Entry>& e2) {
+             return e1.second.microseconds > e2.second.microseconds;
+         });
+
+    // The table changes the precision and float format, which the caller's output must not see
+    ios::fmtflags saved_flags = cout.flags();
+    streamsize saved_precision = cout.precision();
+
+    const MachineModel& machine = MachineModel::get_default();
+    cout << "peak " << machine.peak_gflops << " GFLOP/s, " << machine.peak_gigabytes_per_second
+         << " GB/s\n";
+    cout << setw(40) << left << "op {shape}" << right << setw(12) << "us" << setw(12)
+         << "flop/byte" << setw(12) << "GFLOP/s" << setw(12) << "GB/s" << setw(12) << "bound"
+         << setw(12) << "efficiency\n";
+    for (const pair<string, Entry>& e : sorted)
+    {
+        const Entry& entry = e.second;
+        if (entry.microseconds == 0)
+        {
+            continue;
+        }
+        // Flops or bytes per nanosecond are GFLOP/s or GB/s
+        double ns = entry.microseconds * 1e3;
+        double efficiency = machine.get_min_microseconds(entry.cost) / entry.microseconds;
+        cout << setw(40) << left << e.first << right << setw(12) << entry.microseconds
+             << setw(12) << setprecision(3) << entry.cost.get_arithmetic_intensity() << setw(12)
+             << entry.cost.flops / ns << setw(12) << entry.cost.get_bytes() / ns << setw(12)
+             << (machine.is_compute_bound(entry.cost) ? "compute" : "memory") << setw(11)
+             << setprecision(1) << fixed << efficiency * 100 << "%\n";
+        cout.unsetf(ios::fixed);
+    }
+    cout.flags(saved_flags);
+    cout.precision(saved_precision);
+}
+
 void print_results(vector<PerfShape> perf_data, bool timing_detail)
 {
     sort(perf_data.begin(), perf_data.end(), [](const PerfShape& p1, const PerfShape& p2) {
@@ -148,6 +209,9 @@ void print_results(vector<PerfShape> perf_data, bool timing_detail)
 
         cout << "\n---- Aggregate times per op type/shape/count ----\n";
         print_times(timing_details);
+
+        cout << "\n---- Achieved versus roofline throughput per op type/shape ----\n";
+        print_roofline(perf_data);
     }
 }
 
@@ -186,6 +250,9 @@ int main(int argc, char** argv)
     bool visualize = false;
     int warmup_iterations = 1;
     bool copy_data = true;
+    bool load = false;
+    LoadOptions load_options;
+    string report_file;
 
     for (size_t i = 1; i < argc; i++)
     {
@@ -242,6 +309,34 @@ int main(int argc, char** argv)
                 failed = true;
             }
         }
+        else if (arg == "-t" || arg == "--threads" || arg == "--qps" || arg == "--duration")
+        {
+            try
+            {
+                if (arg == "--qps")
+                {
+                    load_options.qps = stod(argv[++i]);
+                }
+                else if (arg == "--duration")
+                {
+                    load_options.duration_seconds = stod(argv[++i]);
+                }
+                else
+                {
+                    load_options.threads = stoul(argv[++i]);
+                }
+                load = true;
+            }
+            catch (...)
+            {
+                cout << "Invalid Argument\n";
+                failed = true;
+            }
+        }
+        else if (arg == "--report")
+        {
+            report_file = argv[++i];
+        }
         else
         {
             cout << "Unknown option: " << arg << endl;
@@ -283,6 +378,12 @@ OPTIONS
         --timing_detail           Gather detailed timing
         -w|--warmup_iterations    Number of warm-up iterations
         --no_copy_data            Disable copy of input/result data every iteration
+        -t|--threads              Run a load test with this many client threads
+        --qps                     Load test at this many calls per second over all clients
+                                  (default: closed loop, every client calls back to back)
+        --duration                Seconds to run a load test for (default: 10)
+        --report                  Add load test results to this CSV file, or JSON if the
+                                  name ends in .json
 )###";
         return 1;
     }
@@ -335,7 +436,8 @@ OPTIONS
                 size_t total_constant_bytes = 0;
                 unordered_map<string, size_t> op_list;
                 set<string> type_list;
-                for (shared_ptr<Node> node : f->get_ordered_ops())
+                auto ordered_ops = f->get_ordered_ops_view();
+                for (const shared_ptr<Node>& node : *ordered_ops)
                 {
                     string name = node->get_name();
                     string op_name = name.substr(0, name.find('_'));
@@ -375,7 +477,19 @@ OPTIONS
                 }
             }
 
-            if (!backend.empty())
+            if (!backend.empty() && load)
+            {
+                cout << "\n---- Load test ----\n";
+                shared_ptr<Function> f = deserialize(model);
+                load_options.warmup_calls = warmup_iterations;
+                LoadResult result = run_load(f, backend, load_options);
+                print_load_result(result);
+                if (!report_file.empty())
+                {
+                    write_load_report(result, model, report_file);
+                }
+            }
+            else if (!backend.empty())
             {
                 cout << "\n---- Benchmark ----\n";
                 shared_ptr<Function> f = deserialize(model);
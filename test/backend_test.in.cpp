@@ -1451,6 +1451,132 @@ NGRAPH_TEST(${BACKEND_NAME}, dot_matrix_vector_int64)
     EXPECT_EQ((vector<int64_t>{190, 486, 782, 1078}), read_vector<int64_t>(result));
 }
 
+NGRAPH_TEST(${BACKEND_NAME}, dot_matrix_int8_blocked)
+{
+    // Large enough to span several blocks of the reference kernel, with a row count that is
+    // not a multiple of its tile height.
+    Shape shape_a{6, 200};
+    Shape shape_b{200, 300};
+    auto A = make_shared<op::Parameter>(element::i8, shape_a);
+    auto B = make_shared<op::Parameter>(element::i8, shape_b);
+    auto f = make_shared<Function>(make_shared<op::Dot>(A, B), op::ParameterVector{A, B});
+    Shape shape_r{6, 300};
+
+    auto backend = runtime::Backend::create("${BACKEND_NAME}");
+
+    vector<int8_t> a_data(shape_size(shape_a));
+    for (size_t i = 0; i < a_data.size(); i++)
+    {
+        a_data[i] = static_cast<int8_t>(i % 5) - 2;
+    }
+    vector<int8_t> b_data(shape_size(shape_b));
+    for (size_t i = 0; i < b_data.size(); i++)
+    {
+        b_data[i] = static_cast<int8_t>(i % 7 == 0) - static_cast<int8_t>(i % 11 == 0);
+    }
+    vector<int8_t> expected(shape_size(shape_r));
+    for (size_t i = 0; i < shape_r[0]; i++)
+    {
+        for (size_t j = 0; j < shape_r[1]; j++)
+        {
+            int sum = 0;
+            for (size_t k = 0; k < shape_a[1]; k++)
+            {
+                sum += a_data[i * shape_a[1] + k] * b_data[k * shape_b[1] + j];
+            }
+            expected[i * shape_r[1] + j] = static_cast<int8_t>(sum);
+        }
+    }
+
+    auto a = backend->create_tensor(element::i8, shape_a);
+    copy_data(a, a_data);
+    auto b = backend->create_tensor(element::i8, shape_b);
+    copy_data(b, b_data);
+    auto result = backend->create_tensor(element::i8, shape_r);
+
+    backend->call_with_validate(f, {result}, {a, b});
+    EXPECT_EQ(expected, read_vector<int8_t>(result));
+}
+
+NGRAPH_TEST(${BACKEND_NAME}, convolution_2d_padded_blocked)
+{
+    // Asymmetric padding with strides and filter dilation, so the reference kernel gathers
+    // padded taps. All values are multiples of 1/32 that sum exactly in any order.
+    Shape shape_a{2, 3, 7, 9};
+    Shape shape_b{4, 3, 3, 3};
+    Strides strides{2, 1};
+    Strides dilation{1, 2};
+    CoordinateDiff padding_below{1, 2};
+    CoordinateDiff padding_above{2, 0};
+    auto A = make_shared<op::Parameter>(element::f32, shape_a);
+    auto B = make_shared<op::Parameter>(element::f32, shape_b);
+    auto f = make_shared<Function>(
+        make_shared<op::Convolution>(A, B, strides, dilation, padding_below, padding_above),
+        op::ParameterVector{A, B});
+    Shape shape_r{2, 4, 4, 7};
+
+    auto backend = runtime::Backend::create("${BACKEND_NAME}");
+
+    vector<float> a_data(shape_size(shape_a));
+    for (size_t i = 0; i < a_data.size(); i++)
+    {
+        a_data[i] = 0.25f * (static_cast<int>(i * 7 % 13) - 6);
+    }
+    vector<float> b_data(shape_size(shape_b));
+    for (size_t i = 0; i < b_data.size(); i++)
+    {
+        b_data[i] = 0.125f * (static_cast<int>(i * 5 % 11) - 5);
+    }
+    vector<float> expected;
+    for (size_t n = 0; n < shape_r[0]; n++)
+    {
+        for (size_t co = 0; co < shape_r[1]; co++)
+        {
+            for (size_t y = 0; y < shape_r[2]; y++)
+            {
+                for (size_t x = 0; x < shape_r[3]; x++)
+                {
+                    float sum = 0;
+                    for (size_t ci = 0; ci < shape_a[1]; ci++)
+                    {
+                        for (size_t fy = 0; fy < shape_b[2]; fy++)
+                        {
+                            for (size_t fx = 0; fx < shape_b[3]; fx++)
+                            {
+                                int iy = static_cast<int>(y * strides[0] + fy * dilation[0]) -
+                                         static_cast<int>(padding_below[0]);
+                                int ix = static_cast<int>(x * strides[1] + fx * dilation[1]) -
+                                         static_cast<int>(padding_below[1]);
+                                if (iy < 0 || iy >= static_cast<int>(shape_a[2]) || ix < 0 ||
+                                    ix >= static_cast<int>(shape_a[3]))
+                                {
+                                    continue;
+                                }
+                                sum += a_data[((n * shape_a[1] + ci) * shape_a[2] + iy) *
+                                                  shape_a[3] +
+                                              ix] *
+                                       b_data[((co * shape_b[1] + ci) * shape_b[2] + fy) *
+                                                  shape_b[3] +
+                                              fx];
+                            }
+                        }
+                    }
+                    expected.push_back(sum);
+                }
+            }
+        }
+    }
+
+    auto a = backend->create_tensor(element::f32, shape_a);
+    copy_data(a, a_data);
+    auto b = backend->create_tensor(element::f32, shape_b);
+    copy_data(b, b_data);
+    auto result = backend->create_tensor(element::f32, shape_r);
+
+    backend->call_with_validate(f, {result}, {a, b});
+    EXPECT_EQ(expected, read_vector<float>(result));
+}
+
 NGRAPH_TEST(${BACKEND_NAME}, greater)
 {
     Shape shape{2, 2, 2};
@@ -2348,6 +2474,132 @@ NGRAPH_TEST(${BACKEND_NAME}, convert_float32_bool)
     EXPECT_EQ((vector<char>{1, 2, 3, 4}), read_vector<char>(result));
 }
 
+NGRAPH_TEST(${BACKEND_NAME}, convert_float32_bf16)
+{
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto f =
+        make_shared<Function>(make_shared<op::Convert>(A, element::bf16), op::ParameterVector{A});
+
+    auto backend = runtime::Backend::create("${BACKEND_NAME}");
+
+    // Create some tensors for input/output
+    auto a = backend->create_tensor(element::f32, shape);
+    // 1 + 2^-8 and 1 + 3 * 2^-8 are halfway between two bf16 values and round to even
+    copy_data(a, vector<float>{1.0f, 1.00390625f, 1.01171875f, -3.0f});
+    auto result = backend->create_tensor(element::bf16, shape);
+
+    backend->call_with_validate(f, {result}, {a});
+    EXPECT_EQ((vector<float>{1.0f, 1.0f, 1.015625f, -3.0f}), read_float_vector(result));
+}
+
+NGRAPH_TEST(${BACKEND_NAME}, convert_float32_f16)
+{
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto f =
+        make_shared<Function>(make_shared<op::Convert>(A, element::f16), op::ParameterVector{A});
+
+    auto backend = runtime::Backend::create("${BACKEND_NAME}");
+
+    // Create some tensors for input/output
+    auto a = backend->create_tensor(element::f32, shape);
+    copy_data(a, vector<float>{1.0f, 1.00048828125f, 65504.0f, 70000.0f});
+    auto result = backend->create_tensor(element::f16, shape);
+
+    backend->call_with_validate(f, {result}, {a});
+    EXPECT_EQ((vector<float>{1.0f, 1.0f, 65504.0f, numeric_limits<float>::infinity()}),
+              read_float_vector(result));
+}
+
+NGRAPH_TEST(${BACKEND_NAME}, convert_bf16_float32)
+{
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::bf16, shape);
+    auto f =
+        make_shared<Function>(make_shared<op::Convert>(A, element::f32), op::ParameterVector{A});
+
+    auto backend = runtime::Backend::create("${BACKEND_NAME}");
+
+    // Create some tensors for input/output
+    auto a = backend->create_tensor(element::bf16, shape);
+    copy_data(a, vector<bfloat16>{0.5f, -1.5f, 256.0f, 3.140625f});
+    auto result = backend->create_tensor(element::f32, shape);
+
+    backend->call_with_validate(f, {result}, {a});
+    EXPECT_EQ((vector<float>{0.5f, -1.5f, 256.0f, 3.140625f}), read_vector<float>(result));
+}
+
+NGRAPH_TEST(${BACKEND_NAME}, dot_add_relu_bf16)
+{
+    auto A = make_shared<op::Parameter>(element::bf16, Shape{2, 3});
+    auto B = make_shared<op::Parameter>(element::bf16, Shape{3, 2});
+    auto C = make_shared<op::Parameter>(element::bf16, Shape{2, 2});
+    auto relu = make_shared<op::Relu>(make_shared<op::Dot>(A, B) + C);
+    auto f = make_shared<Function>(relu, op::ParameterVector{A, B, C});
+
+    auto backend = runtime::Backend::create("${BACKEND_NAME}");
+
+    // Create some tensors for input/output
+    auto a = backend->create_tensor(element::bf16, Shape{2, 3});
+    copy_data(a, vector<bfloat16>{1, 2, 3, 4, 5, 6});
+    auto b = backend->create_tensor(element::bf16, Shape{3, 2});
+    copy_data(b, vector<bfloat16>{1, -1, 0, 2, -2, 1});
+    auto c = backend->create_tensor(element::bf16, Shape{2, 2});
+    copy_data(c, vector<bfloat16>{0.5f, 0.5f, -20, 0.5f});
+    auto result = backend->create_tensor(element::bf16, Shape{2, 2});
+
+    backend->call_with_validate(f, {result}, {a, b, c});
+    EXPECT_EQ((vector<float>{0, 6.5f, 0, 12.5f}), read_float_vector(result));
+}
+
+NGRAPH_TEST(${BACKEND_NAME}, convolution_2d_f16)
+{
+    auto data = make_shared<op::Parameter>(element::f16, Shape{1, 1, 3, 3});
+    auto filters = make_shared<op::Parameter>(element::f16, Shape{1, 1, 2, 2});
+    auto f = make_shared<Function>(make_shared<op::Convolution>(data, filters),
+                                   op::ParameterVector{data, filters});
+
+    auto backend = runtime::Backend::create("${BACKEND_NAME}");
+
+    // Create some tensors for input/output
+    auto a = backend->create_tensor(element::f16, Shape{1, 1, 3, 3});
+    copy_data(a, vector<float16>{1, 2, 3, 4, 5, 6, 7, 8, 9});
+    auto b = backend->create_tensor(element::f16, Shape{1, 1, 2, 2});
+    copy_data(b, vector<float16>{1, 2, 3, 4});
+    auto result = backend->create_tensor(element::f16, Shape{1, 1, 2, 2});
+
+    backend->call_with_validate(f, {result}, {a, b});
+    EXPECT_EQ((vector<float>{37, 47, 67, 77}), read_float_vector(result));
+}
+
+NGRAPH_TEST(${BACKEND_NAME}, sum_long_bf16_f16)
+{
+    // Rounding every partial sum to the type would stop the sums at 256 and 2048
+    auto backend = runtime::Backend::create("${BACKEND_NAME}");
+    for (auto type : {element::bf16, element::f16})
+    {
+        Shape shape{4096};
+        auto A = make_shared<op::Parameter>(type, shape);
+        auto f = make_shared<Function>(make_shared<op::Sum>(A, AxisSet{0}),
+                                       op::ParameterVector{A});
+
+        auto a = backend->create_tensor(type, shape);
+        if (type == element::bf16)
+        {
+            copy_data(a, vector<bfloat16>(shape_size(shape), 1));
+        }
+        else
+        {
+            copy_data(a, vector<float16>(shape_size(shape), 1));
+        }
+        auto result = backend->create_tensor(type, Shape{});
+
+        backend->call_with_validate(f, {result}, {a});
+        EXPECT_EQ((vector<float>{4096}), read_float_vector(result));
+    }
+}
+
 // Trivial case with no reduction axes.
 NGRAPH_TEST(${BACKEND_NAME}, reduce_trivial)
 {
@@ -9686,3 +9938,38 @@ NGRAPH_TEST(${BACKEND_NAME}, topk_2d_min_one)
     backend->call_with_validate(f1, {result1}, {a});
     EXPECT_EQ((vector<float>{3, 1, 4}), read_vector<float>(result1));
 }
+
+NGRAPH_TEST(${BACKEND_NAME}, parallel_execution)
+{
+    // Independent branches, each large enough for backends to split it across threads
+    Shape shape{512, 64};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto C = make_shared<op::Parameter>(element::f32, Shape{64, 64});
+    auto branch0 = make_shared<op::Dot>(make_shared<op::Tanh>(A), C);
+    auto branch1 = make_shared<op::Broadcast>(
+        make_shared<op::Sum>(A * B, AxisSet{1}), shape, AxisSet{1});
+    auto branch2 = make_shared<op::Maximum>(A - B, make_shared<op::Negative>(A));
+    auto f = make_shared<Function>(branch0 + branch1 * branch2, op::ParameterVector{A, B, C});
+
+    auto backend = runtime::Backend::create("${BACKEND_NAME}");
+
+    auto a = backend->create_tensor(element::f32, shape);
+    auto b = backend->create_tensor(element::f32, shape);
+    auto c = backend->create_tensor(element::f32, Shape{64, 64});
+    auto result = backend->create_tensor(element::f32, shape);
+    test::Uniform<float> rng(-1.0f, 1.0f);
+    rng.initialize(a);
+    rng.initialize(b);
+    rng.initialize(c);
+
+    backend->call_with_validate(f, {result}, {a, b, c});
+    vector<float> expected = read_vector<float>(result);
+
+    backend->enable_parallel_execution(f, true);
+    for (size_t i = 0; i < 3; i++)
+    {
+        backend->call_with_validate(f, {result}, {a, b, c});
+        EXPECT_EQ(expected, read_vector<float>(result));
+    }
+}
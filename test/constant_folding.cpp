@@ -163,3 +163,180 @@ TEST(constant_folding, constant_pad_interior)
     vector<int> padded_values{777, 111, 111, 111, 888};
     ASSERT_EQ(padded_values, values_out);
 }
+
+TEST(constant_folding, constant_arithmetic_chain)
+{
+    Shape shape{2, 2};
+
+    auto a = make_shared<op::Constant>(element::f32, shape, vector<float>{1, 2, 3, 4});
+    auto b = make_shared<op::Constant>(element::f32, shape, vector<float>{5, 6, 7, 8});
+    auto scale = make_shared<op::Constant>(element::f32, shape, vector<float>{2, 2, 2, 2});
+    auto scaled = make_shared<op::Multiply>(make_shared<op::Add>(a, b), scale);
+    auto f = make_shared<Function>(make_shared<op::Negative>(scaled), op::ParameterVector{});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::ConstantFolding>();
+    pass_manager.run_passes(f);
+
+    ASSERT_EQ(count_ops_of_type<op::Add>(f), 0);
+    ASSERT_EQ(count_ops_of_type<op::Multiply>(f), 0);
+    ASSERT_EQ(count_ops_of_type<op::Negative>(f), 0);
+    ASSERT_EQ(count_ops_of_type<op::Constant>(f), 1);
+
+    auto new_const =
+        std::dynamic_pointer_cast<op::Constant>(f->get_results().at(0)->get_argument(0));
+    ASSERT_TRUE(new_const);
+    auto values_out = new_const->get_vector<float>();
+
+    vector<float> values_expected{-12, -16, -20, -24};
+    ASSERT_EQ(values_expected, values_out);
+}
+
+TEST(constant_folding, constant_arithmetic_partial)
+{
+    Shape shape{3};
+
+    auto a = make_shared<op::Constant>(element::i32, shape, vector<int>{1, 2, 3});
+    auto b = make_shared<op::Constant>(element::i32, shape, vector<int>{4, 5, 6});
+    auto p = make_shared<op::Parameter>(element::i32, shape);
+    auto f = make_shared<Function>(make_shared<op::Add>(make_shared<op::Subtract>(b, a), p),
+                                   op::ParameterVector{p});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::ConstantFolding>();
+    pass_manager.run_passes(f);
+
+    ASSERT_EQ(count_ops_of_type<op::Subtract>(f), 0);
+    ASSERT_EQ(count_ops_of_type<op::Add>(f), 1);
+    ASSERT_EQ(count_ops_of_type<op::Constant>(f), 1);
+
+    auto add = f->get_results().at(0)->get_argument(0);
+    auto new_const = std::dynamic_pointer_cast<op::Constant>(add->get_argument(0));
+    ASSERT_TRUE(new_const);
+    auto values_out = new_const->get_vector<int>();
+
+    vector<int> values_expected{3, 3, 3};
+    ASSERT_EQ(values_expected, values_out);
+}
+
+TEST(constant_folding, constant_dot)
+{
+    auto a = make_shared<op::Constant>(element::f32, Shape{2, 3}, vector<float>{1, 2, 3, 4, 5, 6});
+    auto b = make_shared<op::Constant>(element::f32, Shape{3, 1}, vector<float>{1, 0, -1});
+    auto f = make_shared<Function>(make_shared<op::Dot>(a, b), op::ParameterVector{});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::ConstantFolding>();
+    pass_manager.run_passes(f);
+
+    ASSERT_EQ(count_ops_of_type<op::Dot>(f), 0);
+    ASSERT_EQ(count_ops_of_type<op::Constant>(f), 1);
+
+    auto new_const =
+        std::dynamic_pointer_cast<op::Constant>(f->get_results().at(0)->get_argument(0));
+    ASSERT_TRUE(new_const);
+    ASSERT_EQ(new_const->get_shape(), (Shape{2, 1}));
+    auto values_out = new_const->get_vector<float>();
+
+    vector<float> values_expected{-2, -2};
+    ASSERT_EQ(values_expected, values_out);
+}
+
+TEST(constant_folding, constant_sum)
+{
+    auto constant =
+        make_shared<op::Constant>(element::f64, Shape{2, 3}, vector<double>{1, 2, 3, 4, 5, 6});
+    auto f = make_shared<Function>(make_shared<op::Sum>(constant, AxisSet{1}),
+                                   op::ParameterVector{});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::ConstantFolding>();
+    pass_manager.run_passes(f);
+
+    ASSERT_EQ(count_ops_of_type<op::Sum>(f), 0);
+    ASSERT_EQ(count_ops_of_type<op::Constant>(f), 1);
+
+    auto new_const =
+        std::dynamic_pointer_cast<op::Constant>(f->get_results().at(0)->get_argument(0));
+    ASSERT_TRUE(new_const);
+    auto values_out = new_const->get_vector<double>();
+
+    vector<double> values_expected{6, 15};
+    ASSERT_EQ(values_expected, values_out);
+}
+
+TEST(constant_folding, constant_compare_select)
+{
+    Shape shape{4};
+
+    auto a = make_shared<op::Constant>(element::f32, shape, vector<float>{1, 5, 3, 7});
+    auto b = make_shared<op::Constant>(element::f32, shape, vector<float>{4, 2, 6, 0});
+    auto greater = make_shared<op::Greater>(a, b);
+    auto select = make_shared<op::Select>(greater, a, b);
+    auto f = make_shared<Function>(make_shared<op::Convert>(select, element::i32),
+                                   op::ParameterVector{});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::ConstantFolding>();
+    pass_manager.run_passes(f);
+
+    ASSERT_EQ(count_ops_of_type<op::Greater>(f), 0);
+    ASSERT_EQ(count_ops_of_type<op::Select>(f), 0);
+    ASSERT_EQ(count_ops_of_type<op::Convert>(f), 0);
+    ASSERT_EQ(count_ops_of_type<op::Constant>(f), 1);
+
+    auto new_const =
+        std::dynamic_pointer_cast<op::Constant>(f->get_results().at(0)->get_argument(0));
+    ASSERT_TRUE(new_const);
+    ASSERT_EQ(new_const->get_element_type(), element::i32);
+    auto values_out = new_const->get_vector<int>();
+
+    vector<int> values_expected{4, 5, 6, 7};
+    ASSERT_EQ(values_expected, values_out);
+}
+
+TEST(constant_folding, constant_arithmetic_size_limit)
+{
+    auto a = make_shared<op::Constant>(element::f32, Shape{4, 1}, vector<float>{1, 2, 3, 4});
+    auto b = make_shared<op::Constant>(element::f32, Shape{1, 4}, vector<float>{1, 2, 3, 4});
+    auto f = make_shared<Function>(make_shared<op::Dot>(a, b), op::ParameterVector{});
+
+    // The 4x4 product is larger than both the limit and the constants it would replace
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::ConstantFolding>(
+        vector<pass::ConstantFolding::CFTransformations>{
+            pass::ConstantFolding::CFTransformations::ARITHMETIC},
+        8 * sizeof(float));
+    pass_manager.run_passes(f);
+
+    ASSERT_EQ(count_ops_of_type<op::Dot>(f), 1);
+    ASSERT_EQ(count_ops_of_type<op::Constant>(f), 2);
+}
+
+TEST(constant_folding, backend_pipelines)
+{
+    auto make_function = []() {
+        auto A = make_shared<op::Parameter>(element::f32, Shape{2, 1});
+        auto a =
+            make_shared<op::Constant>(element::f32, Shape{2, 3}, vector<float>{1, 2, 3, 4, 5, 6});
+        auto b = make_shared<op::Constant>(element::f32, Shape{3, 1}, vector<float>{1, 0, -1});
+        return make_shared<Function>(A + make_shared<op::Dot>(a, b), op::ParameterVector{A});
+    };
+
+    for (auto backend_name : runtime::Backend::get_registered_devices())
+    {
+        if (backend_name != "INTERPRETER" && backend_name != "CPU")
+        {
+            continue;
+        }
+        auto f = make_function();
+        auto backend = runtime::Backend::create(backend_name);
+        auto A = backend->create_tensor(element::f32, Shape{2, 1});
+        auto result = backend->create_tensor(element::f32, Shape{2, 1});
+        copy_data(A, vector<float>{1, 2});
+        backend->call_with_validate(f, {result}, {A});
+
+        EXPECT_EQ(count_ops_of_type<op::Dot>(f), 0) << backend_name;
+        EXPECT_EQ(read_vector<float>(result), (vector<float>{-1, 0})) << backend_name;
+    }
+}
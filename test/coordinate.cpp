@@ -69,3 +69,69 @@ TEST(coordinate, shape3d)
     EXPECT_EQ(*it++, Coordinate({1, 2, 3}));
     EXPECT_TRUE(it == ct.end());
 }
+
+TEST(strided_transform, collapse_contiguous)
+{
+    Shape shape{2, 1, 3, 4};
+    StridedTransform transform(shape,
+                               {StridedTransform::row_major_strides(shape),
+                                StridedTransform::row_major_strides(shape)});
+    EXPECT_EQ(transform.get_inner_size(), 24);
+    EXPECT_EQ(transform.get_inner_stride(0), 1);
+    EXPECT_EQ(transform.get_inner_stride(1), 1);
+
+    size_t rows = 0;
+    transform.for_each_row([&](const std::ptrdiff_t* offsets) {
+        EXPECT_EQ(offsets[0], 0);
+        EXPECT_EQ(offsets[1], 0);
+        rows++;
+    });
+    EXPECT_EQ(rows, 1);
+}
+
+TEST(strided_transform, transpose)
+{
+    // Reads a 2x3 row-major matrix column by column
+    StridedTransform transform(Shape{3, 2}, {CoordinateDiff{2, 1}, CoordinateDiff{1, 3}});
+    EXPECT_EQ(transform.get_inner_size(), 2);
+    EXPECT_EQ(transform.get_inner_stride(0), 1);
+    EXPECT_EQ(transform.get_inner_stride(1), 3);
+
+    vector<CoordinateDiff> rows;
+    transform.for_each_row([&](const std::ptrdiff_t* offsets) {
+        rows.push_back(CoordinateDiff{offsets[0], offsets[1]});
+    });
+    vector<CoordinateDiff> expected{{0, 0}, {2, 1}, {4, 2}};
+    EXPECT_EQ(rows, expected);
+}
+
+TEST(strided_transform, broadcast_and_reverse)
+{
+    // Repeats axis 0 of the second operand and reads axis 1 of the third backwards
+    Shape shape{2, 3};
+    StridedTransform transform(shape,
+                               {StridedTransform::row_major_strides(shape),
+                                StridedTransform::projected_strides(shape, AxisSet{0}),
+                                CoordinateDiff{3, -1}},
+                               {0, 0, 2});
+    EXPECT_EQ(transform.get_inner_size(), 3);
+    EXPECT_EQ(transform.get_inner_stride(1), 1);
+    EXPECT_EQ(transform.get_inner_stride(2), -1);
+
+    vector<CoordinateDiff> rows;
+    transform.for_each_row([&](const std::ptrdiff_t* offsets) {
+        rows.push_back(CoordinateDiff{offsets[0], offsets[1], offsets[2]});
+    });
+    vector<CoordinateDiff> expected{{0, 0, 2}, {3, 0, 5}};
+    EXPECT_EQ(rows, expected);
+}
+
+TEST(strided_transform, empty)
+{
+    Shape shape{2, 0, 3};
+    StridedTransform transform(shape, {StridedTransform::row_major_strides(shape)});
+
+    size_t rows = 0;
+    transform.for_each_row([&](const std::ptrdiff_t*) { rows++; });
+    EXPECT_EQ(rows, 0);
+}
@@ -0,0 +1,99 @@
+//*****************************************************************************
+// Copyright 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <memory>
+
+#include "gtest/gtest.h"
+
+#include "ngraph/cost_model.hpp"
+#include "ngraph/ngraph.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+TEST(cost_model, elementwise)
+{
+    Shape shape{2, 3};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto add = make_shared<op::Add>(A, B);
+
+    OpCost cost = get_op_cost(*add);
+    EXPECT_EQ(cost.flops, 6);
+    EXPECT_EQ(cost.bytes_read, 48);
+    EXPECT_EQ(cost.bytes_written, 24);
+    EXPECT_DOUBLE_EQ(cost.get_arithmetic_intensity(), 6.0 / 72);
+
+    EXPECT_EQ(get_op_cost(*A).get_bytes(), 0);
+}
+
+TEST(cost_model, dot)
+{
+    auto A = make_shared<op::Parameter>(element::f32, Shape{4, 8});
+    auto B = make_shared<op::Parameter>(element::f32, Shape{8, 16});
+    auto dot = make_shared<op::Dot>(A, B);
+
+    OpCost cost = get_op_cost(*dot);
+    EXPECT_EQ(cost.flops, 2 * 4 * 16 * 8);
+    EXPECT_EQ(cost.bytes_read, (4 * 8 + 8 * 16) * 4);
+    EXPECT_EQ(cost.bytes_written, 4 * 16 * 4);
+}
+
+TEST(cost_model, convolution)
+{
+    auto data = make_shared<op::Parameter>(element::f32, Shape{1, 3, 8, 8});
+    auto filters = make_shared<op::Parameter>(element::f32, Shape{16, 3, 3, 3});
+    auto conv = make_shared<op::Convolution>(data, filters);
+    ASSERT_EQ(conv->get_shape(), (Shape{1, 16, 6, 6}));
+
+    // Every output element sums 3 channels times a 3x3 window
+    EXPECT_EQ(get_op_cost(*conv).flops, 2 * 16 * 6 * 6 * 27);
+}
+
+TEST(cost_model, roofline)
+{
+    MachineModel machine(100, 10);
+    EXPECT_DOUBLE_EQ(machine.get_balance(), 10);
+
+    auto A = make_shared<op::Parameter>(element::f32, Shape{256, 256});
+    auto B = make_shared<op::Parameter>(element::f32, Shape{256, 256});
+    auto dot = make_shared<op::Dot>(A, B);
+    auto add = make_shared<op::Add>(A, B);
+
+    OpCost dot_cost = get_op_cost(*dot);
+    EXPECT_TRUE(machine.is_compute_bound(dot_cost));
+    EXPECT_DOUBLE_EQ(machine.get_attainable_gflops(dot_cost), 100);
+    EXPECT_DOUBLE_EQ(machine.get_min_microseconds(dot_cost), dot_cost.flops / 1e5);
+
+    OpCost add_cost = get_op_cost(*add);
+    EXPECT_FALSE(machine.is_compute_bound(add_cost));
+    EXPECT_DOUBLE_EQ(machine.get_min_microseconds(add_cost), add_cost.get_bytes() / 1e4);
+}
+
+TEST(cost_model, function)
+{
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>(make_shared<op::Multiply>(A + B, B),
+                                   op::ParameterVector{A, B});
+
+    // Add and Multiply do 4 flops each; the Result copies 16 bytes
+    OpCost cost = get_function_cost(*f);
+    EXPECT_EQ(cost.flops, 8);
+    EXPECT_EQ(cost.bytes_read, 32 + 32 + 16);
+    EXPECT_EQ(cost.bytes_written, 16 + 16 + 16);
+}
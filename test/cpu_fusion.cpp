@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <cstdio>
+#include <cstdlib>
 #include <iostream>
 #include <list>
 #include <memory>
@@ -2250,6 +2251,54 @@ TEST(cpu_fusion, loop_kernel_fusion_one_group)
     }
 }
 
+TEST(cpu_fusion, loop_kernel_fusion_dex)
+{
+    ScopedEnvironment dex("NGRAPH_DEX", "1");
+
+    // Large enough that the kernel runs in several blocks, the last of them partial
+    auto make_function = []() -> std::shared_ptr<Function> {
+        Shape shape{3, 1000};
+        auto a = make_shared<op::Parameter>(element::f32, shape);
+        auto b = make_shared<op::Parameter>(element::f32, shape);
+        auto c = make_shared<op::Parameter>(element::f32, shape);
+        auto add_ab = a + b;
+        auto add_abs = std::make_shared<op::Abs>(add_ab);
+        auto abs_neg = std::make_shared<op::Negative>(add_abs);
+        auto relu = std::make_shared<op::Relu>(c - abs_neg);
+        auto max_ab = std::make_shared<op::Maximum>(a, b);
+        auto min_relu = std::make_shared<op::Minimum>(relu, max_ab);
+
+        auto f = std::make_shared<Function>(ngraph::NodeVector{min_relu * abs_neg},
+                                            op::ParameterVector{a, b, c});
+
+        return f;
+    };
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<runtime::cpu::pass::CPULoopKernelFusion>(2);
+    auto cpu_f = make_function();
+    auto int_f = make_function();
+    pass_manager.run_passes(cpu_f);
+    test::Uniform<float> rng(-100.0f, 100.0f);
+    vector<vector<float>> args;
+
+    size_t lkn = count_ops_of_type<runtime::cpu::op::LoopKernel>(cpu_f);
+    ASSERT_GT(lkn, 0);
+
+    for (shared_ptr<op::Parameter> param : cpu_f->get_parameters())
+    {
+        vector<float> tensor_val(shape_size(param->get_shape()));
+        rng.initialize(tensor_val);
+        args.push_back(tensor_val);
+    }
+    auto int_results = execute(int_f, args, "INTERPRETER");
+    auto cpu_results = execute(cpu_f, args, "CPU");
+    for (size_t i = 0; i < cpu_results.size(); i++)
+    {
+        EXPECT_TRUE(test::all_close(cpu_results.at(i), int_results.at(i), 1.0e-4f, 1.0e-4f));
+    }
+}
+
 TEST(cpu_fusion, sigmoid_multiply_fusion)
 {
     pass::Manager pass_manager;
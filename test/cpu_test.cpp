@@ -15,13 +15,20 @@
 //*****************************************************************************
 
 #include <algorithm>
+#include <cmath>
 #include <cstdio>
+#include <dlfcn.h>
+#include <fstream>
+#include <future>
 #include <iostream>
 #include <list>
 #include <memory>
+#include <thread>
 
 #include "gtest/gtest.h"
 #include "ngraph/autodiff/adjoints.hpp"
+#include "ngraph/codegen/compiler.hpp"
+#include "ngraph/codegen/execution_engine.hpp"
 #include "ngraph/file_util.hpp"
 #include "ngraph/graph_util.hpp"
 #include "ngraph/log.hpp"
@@ -29,9 +36,18 @@
 #include "ngraph/op/batch_norm.hpp"
 #include "ngraph/op/get_output_element.hpp"
 #include "ngraph/op/parameter.hpp"
+#include "ngraph/pass/liveness.hpp"
 #include "ngraph/pass/manager.hpp"
+#include "ngraph/pass/memory_layout.hpp"
 #include "ngraph/pass/visualize_tree.hpp"
+#include "ngraph/runtime/cpu/cpu_call_frame.hpp"
+#include "ngraph/runtime/cpu/cpu_external_function.hpp"
+#include "ngraph/runtime/cpu/cpu_tracing.hpp"
+#include "ngraph/runtime/cpu/kernel/eigen_thread_pool.hpp"
+#include "ngraph/runtime/cpu/pass/cpu_assignment.hpp"
 #include "ngraph/runtime/cpu/pass/cpu_fusion.hpp"
+#include "ngraph/runtime/cpu/pass/cpu_reduced_precision_fallback.hpp"
+#include "ngraph/runtime/memory_arena.hpp"
 #include "ngraph/serializer.hpp"
 #include "ngraph/util.hpp"
 #include "nlohmann/json.hpp"
@@ -95,11 +111,7 @@ TEST(cpu_test, abc_tbb)
 {
     // Force TBB flow graph generation in the CPU backend
     // This has no effect on other backends
-    bool use_tbb = (getenv("NGRAPH_CPU_USE_TBB") != nullptr);
-    if (!use_tbb)
-    {
-        setenv("NGRAPH_CPU_USE_TBB", "1", 1);
-    }
+    ScopedEnvironment tbb("NGRAPH_CPU_USE_TBB", "1");
 
     Shape shape{2, 2};
     auto A = make_shared<op::Parameter>(element::f32, shape);
@@ -130,11 +142,6 @@ TEST(cpu_test, abc_tbb)
     backend->call_with_validate(f, {result}, {a, c, b});
     EXPECT_EQ(read_vector<float>(result),
               (test::NDArray<float, 2>({{50, 72}, {98, 128}})).get_vector());
-
-    if (!use_tbb)
-    {
-        unsetenv("NGRAPH_CPU_USE_TBB");
-    }
 }
 #endif // NGRAPH_TBB_ENABLE
 
@@ -191,3 +198,789 @@ TEST(cpu_test, mkldnn_layouts)
 
     EXPECT_EQ(vector<float>{expected_result}, rv);
 }
+
+TEST(cpu_test, concurrent_calls)
+{
+    Shape shape{64};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto C = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>((A + B) * C, op::ParameterVector{A, B, C});
+
+    auto backend = runtime::Backend::create("CPU");
+    backend->compile(f);
+
+    const size_t num_threads = 8;
+    const size_t iterations = 100;
+    vector<thread> threads;
+    vector<int> passed(num_threads, 1);
+    for (size_t t = 0; t < num_threads; t++)
+    {
+        threads.emplace_back([&, t]() {
+            auto a = backend->create_tensor(element::f32, shape);
+            auto b = backend->create_tensor(element::f32, shape);
+            auto c = backend->create_tensor(element::f32, shape);
+            auto result = backend->create_tensor(element::f32, shape);
+            copy_data(a, vector<float>(shape_size(shape), static_cast<float>(t)));
+            copy_data(b, vector<float>(shape_size(shape), 1.0f));
+            copy_data(c, vector<float>(shape_size(shape), 2.0f));
+            vector<float> expected(shape_size(shape), (t + 1.0f) * 2.0f);
+            for (size_t i = 0; i < iterations; i++)
+            {
+                backend->call_with_validate(f, {result}, {a, b, c});
+                if (read_vector<float>(result) != expected)
+                {
+                    passed[t] = 0;
+                }
+            }
+        });
+    }
+    for (auto& th : threads)
+    {
+        th.join();
+    }
+    for (size_t t = 0; t < num_threads; t++)
+    {
+        EXPECT_TRUE(passed[t]) << "thread " << t;
+    }
+}
+
+TEST(cpu_test, concurrent_calls_dex)
+{
+    // Every runtime context has its own DEX tensor pointers and MKLDNN primitives
+    ScopedEnvironment dex("NGRAPH_DEX", "1");
+
+    auto make_function = []() {
+        auto data = make_shared<op::Parameter>(element::f32, Shape{1, 2, 8, 8});
+        auto filters = make_shared<op::Parameter>(element::f32, Shape{4, 2, 3, 3});
+        auto X = make_shared<op::Parameter>(element::f32, Shape{16, 32});
+        auto W = make_shared<op::Parameter>(element::f32, Shape{32, 8});
+        auto conv = make_shared<op::Relu>(make_shared<op::Convolution>(data, filters));
+        auto dot = make_shared<op::Dot>(X, W);
+        return make_shared<Function>(NodeVector{conv, dot},
+                                     op::ParameterVector{data, filters, X, W});
+    };
+    auto f = make_function();
+    auto backend = runtime::Backend::create("CPU");
+    backend->compile(f);
+
+    const size_t num_threads = 8;
+    const size_t iterations = 20;
+    vector<vector<vector<float>>> args(num_threads);
+    vector<vector<vector<float>>> expected(num_threads);
+    auto int_backend = runtime::Backend::create("INTERPRETER");
+    auto int_f = make_function();
+    test::Uniform<float> rng(-1.0f, 1.0f);
+    for (size_t t = 0; t < num_threads; t++)
+    {
+        vector<shared_ptr<runtime::TensorView>> int_args;
+        for (auto param : int_f->get_parameters())
+        {
+            auto tensor = int_backend->create_tensor(element::f32, param->get_shape());
+            rng.initialize(tensor);
+            args[t].push_back(read_vector<float>(tensor));
+            int_args.push_back(tensor);
+        }
+        vector<shared_ptr<runtime::TensorView>> int_results;
+        for (auto result : int_f->get_results())
+        {
+            int_results.push_back(int_backend->create_tensor(element::f32, result->get_shape()));
+        }
+        int_backend->call_with_validate(int_f, int_results, int_args);
+        for (auto result : int_results)
+        {
+            expected[t].push_back(read_vector<float>(result));
+        }
+    }
+
+    vector<thread> threads;
+    vector<int> passed(num_threads, 1);
+    for (size_t t = 0; t < num_threads; t++)
+    {
+        threads.emplace_back([&, t]() {
+            vector<shared_ptr<runtime::TensorView>> inputs;
+            for (size_t i = 0; i < f->get_parameters().size(); i++)
+            {
+                auto tensor =
+                    backend->create_tensor(element::f32, f->get_parameters()[i]->get_shape());
+                copy_data(tensor, args[t][i]);
+                inputs.push_back(tensor);
+            }
+            vector<shared_ptr<runtime::TensorView>> outputs;
+            for (auto result : f->get_results())
+            {
+                outputs.push_back(backend->create_tensor(element::f32, result->get_shape()));
+            }
+            for (size_t i = 0; i < iterations; i++)
+            {
+                backend->call_with_validate(f, outputs, inputs);
+                for (size_t j = 0; j < outputs.size(); j++)
+                {
+                    if (!test::all_close(expected[t][j], read_vector<float>(outputs[j])))
+                    {
+                        passed[t] = 0;
+                    }
+                }
+            }
+        });
+    }
+    for (auto& th : threads)
+    {
+        th.join();
+    }
+    for (size_t t = 0; t < num_threads; t++)
+    {
+        EXPECT_TRUE(passed[t]) << "thread " << t;
+    }
+}
+
+TEST(cpu_test, invalid_concurrency)
+{
+    Shape shape{4};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>(make_shared<op::Abs>(A), op::ParameterVector{A});
+
+    auto backend = runtime::Backend::create("CPU");
+    auto a = backend->create_tensor(element::f32, shape);
+    auto result = backend->create_tensor(element::f32, shape);
+    ScopedEnvironment concurrency("NGRAPH_CPU_CONCURRENCY", "-2");
+    EXPECT_THROW(backend->call_with_validate(f, {result}, {a}), ngraph_error);
+}
+
+TEST(cpu_test, parallel_execution)
+{
+    // Only DEX functions run their ops concurrently
+    ScopedEnvironment dex("NGRAPH_DEX", "1");
+
+    // Four independent branches joined at the end, large enough to overlap
+    Shape shape{64, 1024};
+    auto make_function = [shape]() {
+        auto A = make_shared<op::Parameter>(element::f32, shape);
+        auto B = make_shared<op::Parameter>(element::f32, shape);
+        auto branch0 = make_shared<op::Tanh>(A + B);
+        auto branch1 = make_shared<op::Abs>(A - B);
+        auto branch2 = make_shared<op::Negative>(A * B);
+        auto branch3 = make_shared<op::Maximum>(A, B);
+        return make_shared<Function>((branch0 + branch1) * (branch2 + branch3),
+                                     op::ParameterVector{A, B});
+    };
+    auto f = make_function();
+
+    auto backend = runtime::Backend::create("CPU");
+    auto a = backend->create_tensor(element::f32, shape);
+    auto b = backend->create_tensor(element::f32, shape);
+    auto result = backend->create_tensor(element::f32, shape);
+    vector<float> va(shape_size(shape));
+    vector<float> vb(shape_size(shape));
+    vector<float> expected(shape_size(shape));
+    for (size_t i = 0; i < va.size(); i++)
+    {
+        va[i] = 0.001f * (i % 2000) - 1.0f;
+        vb[i] = 0.5f - 0.0005f * (i % 3000);
+        expected[i] = (tanh(va[i] + vb[i]) + fabs(va[i] - vb[i])) *
+                      (-(va[i] * vb[i]) + max(va[i], vb[i]));
+    }
+    copy_data(a, va);
+    copy_data(b, vb);
+
+    backend->enable_parallel_execution(f, true);
+    backend->call_with_validate(f, {result}, {a, b});
+    EXPECT_TRUE(test::all_close(expected, read_vector<float>(result)));
+
+    // The external function records how many ops ran at once
+    auto external_function = make_shared<runtime::cpu::CPU_ExternalFunction>(make_function());
+    external_function->set_parallel_execution(true);
+    auto call_frame = external_function->make_call_frame();
+    for (size_t i = 0; i < 10; i++)
+    {
+        copy_data(result, vector<float>(shape_size(shape), 0));
+        call_frame->call({result}, {a, b});
+        EXPECT_TRUE(test::all_close(expected, read_vector<float>(result)));
+    }
+    // One pool thread is kept free of ops; the calling thread runs an op of its own
+    if (runtime::cpu::eigen::global_thread_pool.NumThreads() >= 2)
+    {
+        EXPECT_GE(external_function->get_max_parallel_ops(), 2);
+    }
+}
+
+TEST(cpu_test, parallel_execution_concurrent_calls)
+{
+    // Parallel calls share the kernel pool; unit-test-check also runs this with
+    // OMP_NUM_THREADS=1 and 2, where more calls than pool threads run at once
+    ScopedEnvironment dex("NGRAPH_DEX", "1");
+
+    Shape shape{64, 1024};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto branch0 = make_shared<op::Tanh>(A + B);
+    auto branch1 = make_shared<op::Abs>(A - B);
+    auto branch2 = make_shared<op::Negative>(A * B);
+    auto branch3 = make_shared<op::Maximum>(A, B);
+    auto f = make_shared<Function>((branch0 + branch1) * (branch2 + branch3),
+                                   op::ParameterVector{A, B});
+
+    auto backend = runtime::Backend::create("CPU");
+    backend->enable_parallel_execution(f, true);
+    backend->compile(f);
+
+    const size_t num_threads = 4;
+    const size_t iterations = 10;
+    auto a = backend->create_tensor(element::f32, shape);
+    auto b = backend->create_tensor(element::f32, shape);
+    vector<float> va(shape_size(shape));
+    vector<float> vb(shape_size(shape));
+    vector<float> expected(shape_size(shape));
+    for (size_t i = 0; i < va.size(); i++)
+    {
+        va[i] = 0.5f - 0.0005f * (i % 2000);
+        vb[i] = 0.001f * (i % 3000) - 1.0f;
+        expected[i] = (tanh(va[i] + vb[i]) + fabs(va[i] - vb[i])) *
+                      (-(va[i] * vb[i]) + max(va[i], vb[i]));
+    }
+    copy_data(a, va);
+    copy_data(b, vb);
+
+    vector<future<bool>> calls;
+    for (size_t t = 0; t < num_threads; t++)
+    {
+        calls.push_back(async(launch::async, [&]() {
+            auto result = backend->create_tensor(element::f32, shape);
+            bool passed = true;
+            for (size_t i = 0; i < iterations; i++)
+            {
+                backend->call(f, {result}, {a, b});
+                passed = passed && test::all_close(expected, read_vector<float>(result));
+            }
+            return passed;
+        }));
+    }
+    for (auto& call : calls)
+    {
+        if (call.wait_for(chrono::minutes(2)) == future_status::timeout)
+        {
+            // The stuck calls keep the pool busy, so the process cannot shut down cleanly
+            ADD_FAILURE() << "Concurrent parallel calls did not finish";
+            abort();
+        }
+        EXPECT_TRUE(call.get());
+    }
+}
+
+TEST(cpu_test, dex_performance_data)
+{
+    // Force direct execution; the sampled op histograms only exist for DEX functions
+    ScopedEnvironment dex("NGRAPH_DEX", "1");
+
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto C = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>((A + B) * C, op::ParameterVector{A, B, C});
+
+    auto backend = runtime::Backend::create("CPU");
+    backend->enable_performance_data(f, true);
+
+    auto a = backend->create_tensor(element::f32, shape);
+    auto b = backend->create_tensor(element::f32, shape);
+    auto c = backend->create_tensor(element::f32, shape);
+    auto result = backend->create_tensor(element::f32, shape);
+    copy_data(a, vector<float>{1, 2, 3, 4});
+    copy_data(b, vector<float>{5, 6, 7, 8});
+    copy_data(c, vector<float>{9, 10, 11, 12});
+
+    for (size_t i = 0; i < 5; i++)
+    {
+        backend->call_with_validate(f, {result}, {a, b, c});
+    }
+    EXPECT_EQ(read_vector<float>(result), (vector<float>{54, 80, 110, 144}));
+
+    auto counters = backend->get_performance_data(f);
+    EXPECT_FALSE(counters.empty());
+    for (const runtime::PerformanceCounter& counter : counters)
+    {
+        EXPECT_EQ(counter.call_count(), 5);
+        EXPECT_LE(counter.p50_microseconds(), counter.p99_microseconds());
+        EXPECT_LE(counter.p99_microseconds(), counter.max_microseconds());
+    }
+}
+
+TEST(cpu_test, dex_release_function)
+{
+    ScopedEnvironment dex("NGRAPH_DEX", "1");
+
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto C = op::Constant::create(element::f32, shape, {1, 2, 3, 4});
+    auto f = make_shared<Function>(NodeVector{make_shared<op::Tanh>(A) * C, C},
+                                   op::ParameterVector{A});
+
+    auto external_function = make_shared<runtime::cpu::CPU_ExternalFunction>(f);
+    auto call_frame = external_function->make_call_frame();
+    EXPECT_EQ(external_function->get_function(), nullptr);
+    f.reset();
+
+    // Contexts for concurrent calls build their programs after the function is gone
+    auto backend = runtime::Backend::create("CPU");
+    vector<float> va{0.5f, -1, 2, 0};
+    vector<float> expected;
+    for (size_t i = 0; i < va.size(); i++)
+    {
+        expected.push_back(tanh(va[i]) * (i + 1));
+    }
+    vector<thread> threads;
+    vector<int> passed(4, 0);
+    for (size_t t = 0; t < passed.size(); t++)
+    {
+        threads.emplace_back([&, t]() {
+            auto a = backend->create_tensor(element::f32, shape);
+            auto result = backend->create_tensor(element::f32, shape);
+            auto constant = backend->create_tensor(element::f32, shape);
+            copy_data(a, va);
+            for (size_t i = 0; i < 10; i++)
+            {
+                call_frame->call({result, constant}, {a});
+            }
+            passed[t] = test::all_close(expected, read_vector<float>(result)) &&
+                        read_vector<float>(constant) == vector<float>{1, 2, 3, 4};
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(passed, vector<int>(passed.size(), 1));
+}
+
+TEST(cpu_test, elementwise_in_place)
+{
+    Shape shape{2, 3};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>(
+        make_shared<op::Negative>(make_shared<op::Exp>(make_shared<op::Tanh>(A + B))),
+        op::ParameterVector{A, B});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<runtime::cpu::pass::CPUAssignment>(nullptr);
+    pass_manager.register_pass<pass::Liveness>();
+    pass_manager.register_pass<pass::MemoryLayout>(1, true);
+    pass_manager.run_passes(f);
+
+    // Every op of the chain takes over the buffer of the op before it
+    for (auto node : f->get_ordered_ops())
+    {
+        if (!node->is_parameter() && !node->is_output())
+        {
+            auto op_annotations = static_pointer_cast<op::Op>(node)->get_op_annotations();
+            ASSERT_NE(op_annotations, nullptr) << node->get_name();
+            EXPECT_EQ(op_annotations->get_in_place_oi_pairs().size(), 1u) << node->get_name();
+        }
+    }
+    EXPECT_EQ(f->get_temporary_pool_size(), shape_size(shape) * sizeof(float));
+
+    auto g = make_shared<Function>(
+        make_shared<op::Negative>(make_shared<op::Exp>(make_shared<op::Tanh>(A + B))),
+        op::ParameterVector{A, B});
+    auto backend = runtime::Backend::create("CPU");
+    auto a = backend->create_tensor(element::f32, shape);
+    auto b = backend->create_tensor(element::f32, shape);
+    auto result = backend->create_tensor(element::f32, shape);
+    copy_data(a, vector<float>{-1, -0.5f, 0, 0.5f, 1, 2});
+    copy_data(b, vector<float>{0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 0.5f});
+    vector<float> expected;
+    for (float x : {-0.5f, 0.0f, 0.5f, 1.0f, 1.5f, 2.5f})
+    {
+        expected.push_back(-exp(tanh(x)));
+    }
+    backend->call_with_validate(g, {result}, {a, b});
+    EXPECT_TRUE(test::all_close(expected, read_vector<float>(result)));
+}
+
+TEST(cpu_test, reduced_precision_fallback)
+{
+    Shape shape{2, 3};
+    auto A = make_shared<op::Parameter>(element::bf16, shape);
+    auto B = make_shared<op::Parameter>(element::bf16, Shape{3, 4});
+    auto relu = make_shared<op::Relu>(make_shared<op::Dot>(make_shared<op::Tanh>(A), B));
+    auto f = make_shared<Function>(relu, op::ParameterVector{A, B});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<runtime::cpu::pass::CPUReducedPrecisionFallback>();
+    pass_manager.run_passes(f);
+
+    // Wrapped ops compute in f32 and only the Converts around them touch bf16 tensors
+    for (auto node : f->get_ordered_ops())
+    {
+        if (std::dynamic_pointer_cast<op::Convert>(node))
+        {
+            continue;
+        }
+        for (const descriptor::Output& output : node->get_outputs())
+        {
+            EXPECT_EQ(output.get_element_type(),
+                      node->is_parameter() || node->is_output() ? element::bf16 : element::f32)
+                << node->get_name();
+        }
+    }
+    // Each wrapped op widens its inputs and rounds its output
+    EXPECT_EQ(count_ops_of_type<op::Convert>(f), 7);
+    EXPECT_EQ(f->get_output_element_type(0), element::bf16);
+
+    auto backend = runtime::Backend::create("CPU");
+    auto g = make_shared<Function>(
+        make_shared<op::Relu>(make_shared<op::Dot>(make_shared<op::Tanh>(A), B)),
+        op::ParameterVector{A, B});
+    auto a = backend->create_tensor(element::bf16, shape);
+    auto b = backend->create_tensor(element::bf16, Shape{3, 4});
+    auto result = backend->create_tensor(element::bf16, Shape{2, 4});
+    vector<float> a_values{-1, -0.5f, 0, 0.5f, 1, 2};
+    vector<float> b_values{1, -1, 0.5f, 2, -2, 0.25f, 1, -1, 3, 0.5f, -0.5f, 1};
+    copy_data(a, vector<bfloat16>(a_values.begin(), a_values.end()));
+    copy_data(b, vector<bfloat16>(b_values.begin(), b_values.end()));
+    backend->call_with_validate(g, {result}, {a, b});
+
+    // Same rounding as the CPU: every op result is rounded to bf16
+    auto round = [](float x) { return static_cast<float>(bfloat16(x)); };
+    vector<float> expected;
+    for (size_t i = 0; i < 2; i++)
+    {
+        for (size_t j = 0; j < 4; j++)
+        {
+            float sum = 0;
+            for (size_t k = 0; k < 3; k++)
+            {
+                sum += round(std::tanh(round(a_values[i * 3 + k]))) * round(b_values[k * 4 + j]);
+            }
+            expected.push_back(round(std::max(round(sum), 0.0f)));
+        }
+    }
+    EXPECT_TRUE(test::all_close(expected, read_float_vector(result), 1e-2f, 1e-2f));
+}
+
+TEST(cpu_test, reduced_precision_round_trip)
+{
+    Shape shape{4};
+    auto make_function = [shape]() {
+        auto A = make_shared<op::Parameter>(element::f32, shape);
+        auto narrow = make_shared<op::Convert>(A, element::bf16);
+        auto widen = make_shared<op::Convert>(narrow, element::f32);
+        return make_shared<Function>(make_shared<op::Abs>(widen), op::ParameterVector{A});
+    };
+
+    // An explicit round trip through bf16 is part of the model and must stay
+    auto f = make_function();
+    pass::Manager pass_manager;
+    pass_manager.register_pass<runtime::cpu::pass::CPUReducedPrecisionFallback>();
+    pass_manager.run_passes(f);
+    EXPECT_EQ(count_ops_of_type<op::Convert>(f), 2);
+
+    auto backend = runtime::Backend::create("CPU");
+    auto g = make_function();
+    auto a = backend->create_tensor(element::f32, shape);
+    auto result = backend->create_tensor(element::f32, shape);
+    // 1 + 2^-8 is a tie and rounds to even, the others lose low mantissa bits
+    vector<float> a_values{1.00390625f, -3.14159265f, 1000.1f, 1e-3f};
+    copy_data(a, a_values);
+    backend->call_with_validate(g, {result}, {a});
+    vector<float> expected;
+    for (float x : a_values)
+    {
+        expected.push_back(fabs(static_cast<float>(bfloat16(x))));
+    }
+    EXPECT_EQ(read_vector<float>(result), expected);
+    EXPECT_EQ(expected[0], 1.0f);
+}
+
+TEST(cpu_test, reduced_precision_data_movement)
+{
+    auto make_function = []() {
+        auto A = make_shared<op::Parameter>(element::bf16, Shape{2, 3});
+        auto B = make_shared<op::Parameter>(element::bf16, Shape{3, 2});
+        auto transpose = make_shared<op::Reshape>(A, AxisVector{1, 0}, Shape{3, 2});
+        auto slice = make_shared<op::Slice>(B, Coordinate{1, 0}, Coordinate{3, 2});
+        return make_shared<Function>(
+            make_shared<op::Concat>(NodeVector{transpose, slice}, 0), op::ParameterVector{A, B});
+    };
+
+    // Ops that only move elements run on the bf16 tensors without Converts
+    auto f = make_function();
+    pass::Manager pass_manager;
+    pass_manager.register_pass<runtime::cpu::pass::CPUReducedPrecisionFallback>();
+    pass_manager.run_passes(f);
+    EXPECT_EQ(count_ops_of_type<op::Convert>(f), 0);
+
+    auto backend = runtime::Backend::create("CPU");
+    auto g = make_function();
+    auto a = backend->create_tensor(element::bf16, Shape{2, 3});
+    auto b = backend->create_tensor(element::bf16, Shape{3, 2});
+    auto result = backend->create_tensor(element::bf16, Shape{5, 2});
+    copy_data(a, vector<bfloat16>{1, 2, 3, 4, 5, 6});
+    copy_data(b, vector<bfloat16>{-1, -2, 0.5f, 0.25f, 7, 8});
+    backend->call_with_validate(g, {result}, {a, b});
+    EXPECT_EQ(read_float_vector(result), (vector<float>{1, 4, 2, 5, 3, 6, 0.5f, 0.25f, 7, 8}));
+}
+
+#ifdef AOT_COMPILE_PATH
+// Builds a library from f with the aot_compile tool and runs it once on inputs
+static void run_aot_compiled(const shared_ptr<Function>& f,
+                             const string& name,
+                             vector<vector<float>>& inputs,
+                             vector<float>& result)
+{
+    string directory = file_util::get_temp_directory_path();
+    string model = file_util::path_join(directory, name + ".json");
+    string library = file_util::path_join(directory, "lib" + name + ".so");
+    {
+        ofstream out(model);
+        out << serialize(f);
+    }
+    string command = string(AOT_COMPILE_PATH) + " -i " + model + " -o " + library;
+    ASSERT_EQ(system(command.c_str()), 0);
+    file_util::remove_file(model);
+
+    void* handle = dlopen(library.c_str(), RTLD_NOW | RTLD_LOCAL);
+    ASSERT_NE(handle, nullptr) << dlerror();
+    auto get_input_count = reinterpret_cast<size_t (*)()>(dlsym(handle, "ngraph_get_input_count"));
+    auto create_context = reinterpret_cast<void* (*)()>(dlsym(handle, "ngraph_create_context"));
+    auto call = reinterpret_cast<void (*)(void*, void**, void**)>(dlsym(handle, "ngraph_call"));
+    auto destroy_context =
+        reinterpret_cast<void (*)(void*)>(dlsym(handle, "ngraph_destroy_context"));
+    ASSERT_TRUE(get_input_count && create_context && call && destroy_context);
+    EXPECT_EQ(get_input_count(), inputs.size());
+
+    vector<void*> input_ptrs;
+    for (auto& input : inputs)
+    {
+        input_ptrs.push_back(input.data());
+    }
+    result.resize(shape_size(f->get_output_shape(0)));
+    vector<void*> outputs{result.data()};
+    void* context = create_context();
+    call(context, input_ptrs.data(), outputs.data());
+    destroy_context(context);
+    dlclose(handle);
+    file_util::remove_file(library);
+}
+
+TEST(cpu_test, aot_compile)
+{
+    Shape shape{2, 3};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto C = make_shared<op::Parameter>(element::f32, shape);
+    auto f =
+        make_shared<Function>(make_shared<op::Tanh>((A + B) * C), op::ParameterVector{A, B, C});
+
+    vector<float> a{-1, -0.5f, 0, 0.5f, 1, 2};
+    vector<float> b{0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 0.5f};
+    vector<float> c{1, 2, 3, -1, -2, -3};
+    vector<vector<float>> inputs{a, b, c};
+    vector<float> result;
+    ASSERT_NO_FATAL_FAILURE(run_aot_compiled(f, "aot_compile_test", inputs, result));
+
+    vector<float> expected;
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        expected.push_back(std::tanh((a[i] + b[i]) * c[i]));
+    }
+    EXPECT_TRUE(test::all_close(expected, result));
+}
+
+TEST(cpu_test, aot_compile_convolution)
+{
+    // The CPU backend runs these on MKLDNN; the library uses the reference kernels
+    auto make_function = []() {
+        auto data = make_shared<op::Parameter>(element::f32, Shape{1, 2, 6, 6});
+        auto filters = make_shared<op::Parameter>(element::f32, Shape{3, 2, 3, 3});
+        auto conv = make_shared<op::Convolution>(data,
+                                                 filters,
+                                                 Strides{1, 1},
+                                                 Strides{1, 1},
+                                                 CoordinateDiff{1, 1},
+                                                 CoordinateDiff{1, 1});
+        auto relu = make_shared<op::Relu>(conv);
+        auto pool = make_shared<op::MaxPool>(relu, Shape{2, 2}, Strides{2, 2});
+        return make_shared<Function>(pool, op::ParameterVector{data, filters});
+    };
+
+    vector<float> data(1 * 2 * 6 * 6);
+    test::Uniform<float>(-1.0f, 1.0f).initialize(data);
+    vector<float> filters(3 * 2 * 3 * 3);
+    test::Uniform<float>(-1.0f, 1.0f).initialize(filters);
+    vector<vector<float>> inputs{data, filters};
+    vector<float> result;
+    ASSERT_NO_FATAL_FAILURE(run_aot_compiled(make_function(), "aot_compile_conv", inputs, result));
+
+    auto expected = execute(make_function(), inputs, "INTERPRETER").at(0);
+    EXPECT_TRUE(test::all_close(expected, result));
+}
+#endif
+
+#if !defined(NGRAPH_DEX_ONLY)
+TEST(cpu_test, codegen_cache)
+{
+    string directory =
+        file_util::path_join(file_util::get_temp_directory_path(), "codegen_cache_test");
+    file_util::remove_directory(directory);
+    const string source = "extern \"C\" int codegen_cache_test() { return 42; }\n";
+
+    {
+        codegen::Compiler compiler;
+        compiler.set_cache_directory(directory);
+        EXPECT_NE(compiler.compile(source), nullptr);
+        EXPECT_EQ(compiler.get_cache_hits(), 0);
+    }
+
+    // A later compiler loads the stored module instead of compiling the source again
+    {
+        codegen::Compiler compiler;
+        compiler.set_cache_directory(directory);
+        auto module = compiler.compile(source);
+        ASSERT_NE(module, nullptr);
+        EXPECT_EQ(compiler.get_cache_hits(), 1);
+        codegen::ExecutionEngine engine;
+        ASSERT_TRUE(engine.add_module(module));
+        engine.finalize();
+        EXPECT_EQ(engine.find_function<int()>("codegen_cache_test")(), 42);
+    }
+
+    // Other compile flags select another entry
+    {
+        ScopedEnvironment debuginfo("NGRAPH_COMPILER_DEBUGINFO_ENABLE", "1");
+        codegen::Compiler compiler;
+        compiler.set_cache_directory(directory);
+        EXPECT_NE(compiler.compile(source), nullptr);
+        EXPECT_EQ(compiler.get_cache_hits(), 0);
+    }
+
+    // An entry whose stored key differs from the requested one is compiled again
+    file_util::iterate_files(directory, [](const string& file, bool is_dir) {
+        if (!is_dir && file_util::get_file_ext(file) == ".key")
+        {
+            ofstream out(file);
+            out << "stale";
+        }
+    });
+    {
+        codegen::Compiler compiler;
+        compiler.set_cache_directory(directory);
+        EXPECT_NE(compiler.compile(source), nullptr);
+        EXPECT_EQ(compiler.get_cache_hits(), 0);
+        EXPECT_NE(compiler.compile(source), nullptr);
+        EXPECT_EQ(compiler.get_cache_hits(), 1);
+    }
+    file_util::remove_directory(directory);
+}
+
+TEST(cpu_test, codegen_partitions)
+{
+    // Only generated code is split into translation units
+    ScopedEnvironment dex("NGRAPH_DEX", nullptr);
+
+    Shape shape{16};
+    auto make_function = [shape]() {
+        auto A = make_shared<op::Parameter>(element::f32, shape);
+        auto B = make_shared<op::Parameter>(element::f32, shape);
+        shared_ptr<Node> x = A;
+        for (size_t i = 0; i < 16; i++)
+        {
+            x = make_shared<op::Tanh>(x * B + A);
+        }
+        return make_shared<Function>(x, op::ParameterVector{A, B});
+    };
+
+    auto backend = runtime::Backend::create("CPU");
+    auto a = backend->create_tensor(element::f32, shape);
+    auto b = backend->create_tensor(element::f32, shape);
+    auto result = backend->create_tensor(element::f32, shape);
+    test::Uniform<float> rng(-1.0f, 1.0f);
+    rng.initialize(a);
+    rng.initialize(b);
+
+    auto whole = make_shared<runtime::cpu::CPU_ExternalFunction>(make_function());
+    whole->make_call_frame()->call({result}, {a, b});
+    EXPECT_EQ(whole->get_code_partition_count(), 1);
+    auto expected = read_vector<float>(result);
+
+    shared_ptr<runtime::cpu::CPU_ExternalFunction> split;
+    {
+        ScopedEnvironment min_ops("NGRAPH_CODEGEN_MIN_OPS_PER_PARTITION", "4");
+        ScopedEnvironment threads("NGRAPH_CODEGEN_THREADS", "4");
+        split = make_shared<runtime::cpu::CPU_ExternalFunction>(make_function());
+        copy_data(result, vector<float>(shape_size(shape), 0));
+        split->make_call_frame()->call({result}, {a, b});
+    }
+
+    EXPECT_GT(split->get_code_partition_count(), 1);
+    EXPECT_GT(split->get_compile_thread_count(), 1);
+    EXPECT_EQ(read_vector<float>(result), expected);
+}
+#endif
+
+TEST(cpu_test, timeline_perf_events)
+{
+    vector<runtime::cpu::OpAttributes> op_attrs{{"Add", {"add_out"}, {"A", "B"}},
+                                                {"Tanh", {"tanh_out"}, {"add_out"}}};
+    vector<int64_t> durations{10, 20};
+    vector<runtime::cpu::PerfEventCounts> events(2);
+    // Counters that could not be opened leave the first op's counts unavailable
+    events[1].available = true;
+    events[1].cycles = 1000;
+    events[1].llc_misses = 10;
+    events[1].flops = 4000;
+
+    string file_name = file_util::path_join(file_util::get_temp_directory_path(),
+                                            "timeline_perf_events.json");
+    runtime::cpu::GenerateTimeline(op_attrs, durations.data(), file_name, events.data());
+    ifstream in(file_name);
+    nlohmann::json timeline;
+    in >> timeline;
+    in.close();
+    file_util::remove_file(file_name);
+
+    const auto& trace = timeline["traceEvents"];
+    ASSERT_EQ(trace.size(), 2);
+    EXPECT_EQ(trace[0]["name"], "Add");
+    EXPECT_EQ(trace[0]["dur"], 10);
+    EXPECT_EQ(trace[0]["args"]["Input2"], "B");
+    EXPECT_EQ(trace[0]["args"]["counters"], "unavailable");
+    EXPECT_EQ(trace[0]["args"].count("cycles"), 0);
+    EXPECT_EQ(trace[0]["args"].count("GB/s"), 0);
+
+    EXPECT_EQ(trace[1]["ts"], 10);
+    EXPECT_EQ(trace[1]["args"]["counters"], "executing thread");
+    EXPECT_EQ(trace[1]["args"]["cycles"], 1000);
+    EXPECT_DOUBLE_EQ(trace[1]["args"]["GFLOP/s"].get<double>(), 4000 / 20e3);
+    EXPECT_DOUBLE_EQ(trace[1]["args"]["GB/s"].get<double>(),
+                     10.0 * runtime::cpu::PerfEventGroup::s_cache_line_size / 20e3);
+}
+
+TEST(cpu_test, borrowed_scratch_memory)
+{
+    // Reverse of a constant, which is not folded, is computed on the first call only and kept
+    // in the scratch pool
+    Shape shape{4, 4};
+    auto make_function = [shape](float value) {
+        auto A = make_shared<op::Parameter>(element::f32, shape);
+        auto C = op::Constant::create(element::f32, shape, vector<float>(16, value));
+        return make_shared<Function>(A + make_shared<op::Reverse>(C, AxisSet{0}),
+                                     op::ParameterVector{A});
+    };
+    auto f1 = make_function(1.0f);
+    auto f2 = make_function(2.0f);
+
+    auto backend = runtime::Backend::create("CPU");
+    auto a = backend->create_tensor(element::f32, shape);
+    auto result = backend->create_tensor(element::f32, shape);
+    copy_data(a, vector<float>(16, 0.0f));
+
+    // f2 takes over the pool f1 gave back, so f1 has to recompute its constant part
+    auto& arena = runtime::MemoryArena::get_process_arena();
+    for (auto f : {f1, f1, f2, f1, f2, f2})
+    {
+        backend->call_with_validate(f, {result}, {a});
+        EXPECT_EQ(read_vector<float>(result), vector<float>(16, f == f1 ? 1.0f : 2.0f));
+        EXPECT_EQ(arena.get_borrowed_bytes(), 0u);
+    }
+}
@@ -0,0 +1,75 @@
+//*****************************************************************************
+// Copyright 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ngraph/ngraph.hpp"
+#include "ngraph/runtime/dynamic_batcher.hpp"
+#include "util/test_tools.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+TEST(dynamic_batcher, rebatch_function)
+{
+    auto A = make_shared<op::Parameter>(element::f32, Shape{1, 3});
+    auto B = make_shared<op::Parameter>(element::f32, Shape{1, 3});
+    auto f = make_shared<Function>(make_shared<op::Tanh>(A * B), op::ParameterVector{A, B});
+
+    auto g = runtime::DynamicBatcher::rebatch_function(*f, 4);
+    EXPECT_EQ(g->get_parameters().at(0)->get_shape(), (Shape{4, 3}));
+    EXPECT_EQ(g->get_parameters().at(1)->get_shape(), (Shape{4, 3}));
+    EXPECT_EQ(g->get_output_shape(0), (Shape{4, 3}));
+}
+
+TEST(dynamic_batcher, concurrent_requests)
+{
+    Shape shape{1, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>(A + B, op::ParameterVector{A, B});
+
+    auto backend = runtime::Backend::create("INTERPRETER");
+    runtime::DynamicBatcher batcher(backend, f, {2, 4}, chrono::milliseconds(5));
+    EXPECT_EQ(batcher.get_max_batch_size(), 4u);
+
+    const size_t num_threads = 7;
+    vector<vector<float>> results(num_threads);
+    vector<thread> threads;
+    for (size_t t = 0; t < num_threads; t++)
+    {
+        threads.emplace_back([&, t]() {
+            auto a = backend->create_tensor(element::f32, shape);
+            auto b = backend->create_tensor(element::f32, shape);
+            auto result = backend->create_tensor(element::f32, shape);
+            copy_data(a, vector<float>{static_cast<float>(t), 1});
+            copy_data(b, vector<float>{10, static_cast<float>(t)});
+            batcher.call({result}, {a, b});
+            results[t] = read_vector<float>(result);
+        });
+    }
+    for (auto& th : threads)
+    {
+        th.join();
+    }
+    for (size_t t = 0; t < num_threads; t++)
+    {
+        EXPECT_EQ(results[t], (vector<float>{t + 10.0f, t + 1.0f}));
+    }
+}
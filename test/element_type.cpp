@@ -14,6 +14,8 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <cmath>
+#include <limits>
 #include <map>
 
 #include "gtest/gtest.h"
@@ -26,6 +28,8 @@ TEST(element_type, from)
 {
     EXPECT_EQ(element::from<char>(), element::boolean);
     EXPECT_EQ(element::from<bool>(), element::boolean);
+    EXPECT_EQ(element::from<bfloat16>(), element::bf16);
+    EXPECT_EQ(element::from<float16>(), element::f16);
     EXPECT_EQ(element::from<float>(), element::f32);
     EXPECT_EQ(element::from<double>(), element::f64);
     EXPECT_EQ(element::from<int8_t>(), element::i8);
@@ -43,6 +47,12 @@ TEST(element_type, mapable)
     std::map<element::Type, std::string> test_map;
 
     test_map.insert({element::f32, "float"});
+
+    // bf16 and f16 have the same size and flags
+    test_map.insert({element::bf16, "bfloat16"});
+    test_map.insert({element::f16, "float16"});
+    EXPECT_EQ(test_map.size(), 3);
+    EXPECT_EQ(test_map.at(element::f16), "float16");
 }
 
 TEST(element_type, size)
@@ -84,3 +94,47 @@ TEST(element_type, size)
         EXPECT_EQ(2, t1.size());
     }
 }
+
+TEST(element_type, bfloat16)
+{
+    EXPECT_EQ(element::bf16.size(), 2);
+    EXPECT_EQ(bfloat16(1.0f).to_bits(), 0x3f80);
+    EXPECT_EQ(bfloat16(-2.0f).to_bits(), 0xc000);
+    // Halfway cases round to even
+    EXPECT_EQ(bfloat16(1.00390625f).to_bits(), 0x3f80);
+    EXPECT_EQ(bfloat16(1.01171875f).to_bits(), 0x3f82);
+    EXPECT_EQ(bfloat16(std::nextafter(1.00390625f, 2.0f)).to_bits(), 0x3f81);
+    EXPECT_EQ(bfloat16(std::numeric_limits<float>::max()).to_bits(), 0x7f80);
+    EXPECT_TRUE(std::isnan(static_cast<float>(bfloat16(std::nanf("")))));
+    EXPECT_EQ(static_cast<float>(bfloat16::from_bits(0x4049)), 3.140625f);
+    EXPECT_EQ(static_cast<float>(std::numeric_limits<bfloat16>::max()), 3.38953139e38f);
+
+    bfloat16 value = 1.5f;
+    value += 2;
+    EXPECT_EQ(static_cast<float>(value), 3.5f);
+    EXPECT_EQ(value.to_string(), "3.5");
+}
+
+TEST(element_type, float16)
+{
+    EXPECT_EQ(element::f16.size(), 2);
+    EXPECT_EQ(float16(1.0f).to_bits(), 0x3c00);
+    EXPECT_EQ(float16(-2.0f).to_bits(), 0xc000);
+    EXPECT_EQ(float16(65504.0f).to_bits(), 0x7bff);
+    // Halfway cases round to even, up to infinity
+    EXPECT_EQ(float16(1.00048828125f).to_bits(), 0x3c00);
+    EXPECT_EQ(float16(1.00146484375f).to_bits(), 0x3c02);
+    EXPECT_EQ(float16(65520.0f).to_bits(), 0x7c00);
+    // Subnormals
+    EXPECT_EQ(float16(std::ldexp(1.0f, -24)).to_bits(), 0x0001);
+    EXPECT_EQ(float16(std::ldexp(1.0f, -25)).to_bits(), 0x0000);
+    EXPECT_EQ(float16(std::ldexp(3.0f, -25)).to_bits(), 0x0002);
+    EXPECT_EQ(static_cast<float>(float16::from_bits(0x03ff)), std::ldexp(1023.0f, -24));
+    EXPECT_TRUE(std::isnan(static_cast<float>(float16(std::nanf("")))));
+    EXPECT_EQ(static_cast<float>(float16::from_bits(0xfc00)),
+              -std::numeric_limits<float>::infinity());
+
+    float16 value = 1.5f;
+    value *= 3;
+    EXPECT_EQ(static_cast<float>(value), 4.5f);
+}
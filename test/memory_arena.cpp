@@ -0,0 +1,116 @@
+//*****************************************************************************
+// Copyright 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <cstdint>
+
+#include "gtest/gtest.h"
+#include "ngraph/except.hpp"
+#include "ngraph/runtime/memory_arena.hpp"
+#include "util/test_tools.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+TEST(memory_arena, reuse)
+{
+    runtime::MemoryArena arena;
+    auto a = arena.acquire(1000, 64);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(a->get_ptr()) % 64, 0u);
+    EXPECT_EQ(arena.get_borrowed_bytes(), 1000u);
+    arena.release(a);
+    EXPECT_EQ(arena.get_borrowed_bytes(), 0u);
+    EXPECT_EQ(arena.get_idle_bytes(), 1000u);
+
+    // Large enough and no more than twice the request
+    auto b = arena.acquire(600, 64);
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(arena.get_idle_bytes(), 0u);
+
+    // Too small to be reused
+    auto c = arena.acquire(2000, 64);
+    EXPECT_NE(b, c);
+    arena.release(b);
+    arena.release(c);
+    EXPECT_EQ(arena.get_idle_bytes(), 3000u);
+
+    // Too large to be reused
+    auto d = arena.acquire(100, 64);
+    EXPECT_NE(d, b);
+    EXPECT_NE(d, c);
+    arena.release(d);
+
+    arena.trim();
+    EXPECT_EQ(arena.get_idle_bytes(), 0u);
+}
+
+TEST(memory_arena, idle_limit)
+{
+    runtime::MemoryArena arena;
+    auto a = arena.acquire(1000, 64);
+    auto b = arena.acquire(3000, 64);
+    arena.release(a);
+    arena.release(b);
+    EXPECT_EQ(arena.get_idle_bytes(), 4000u);
+
+    arena.set_idle_limit(2000);
+    EXPECT_EQ(arena.get_idle_bytes(), 1000u);
+
+    auto c = arena.acquire(1500, 64);
+    arena.release(c);
+    EXPECT_EQ(arena.get_idle_bytes(), 1000u);
+}
+
+TEST(memory_arena, tickets)
+{
+    runtime::MemoryArena arena;
+    auto a = arena.acquire(1000, 64);
+    size_t ticket_a = arena.release(a);
+    EXPECT_NE(ticket_a, 0u);
+
+    bool intact = false;
+    auto b = arena.acquire(1000, 64, ticket_a, intact);
+    EXPECT_EQ(a, b);
+    EXPECT_TRUE(intact);
+
+    // Someone else borrowed the buffer in between, so the ticket no longer reclaims it
+    size_t ticket_b = arena.release(b);
+    EXPECT_NE(ticket_b, ticket_a);
+    auto c = arena.acquire(1000, 64);
+    arena.release(c);
+    auto d = arena.acquire(1000, 64, ticket_b, intact);
+    EXPECT_FALSE(intact);
+    arena.release(d);
+
+    // Buffers dropped by the idle limit have no ticket
+    arena.set_idle_limit(0);
+    EXPECT_EQ(arena.release(arena.acquire(1000, 64)), 0u);
+}
+
+TEST(memory_arena, idle_limit_env)
+{
+    {
+        ScopedEnvironment limit("NGRAPH_SCRATCH_ARENA_IDLE_LIMIT", "1500");
+        runtime::MemoryArena arena;
+        arena.release(arena.acquire(1000, 64));
+        arena.release(arena.acquire(2000, 64));
+        EXPECT_EQ(arena.get_idle_bytes(), 1000u);
+    }
+    for (auto bad : {"", "-1", "12MB", "99999999999999999999999"})
+    {
+        ScopedEnvironment limit("NGRAPH_SCRATCH_ARENA_IDLE_LIMIT", bad);
+        EXPECT_THROW(runtime::MemoryArena(), ngraph_error) << bad;
+    }
+}
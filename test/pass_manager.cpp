@@ -23,7 +23,9 @@
 
 #include "ngraph/graph_util.hpp"
 #include "ngraph/ngraph.hpp"
+#include "ngraph/pass/cse.hpp"
 #include "ngraph/pass/manager.hpp"
+#include "ngraph/pass/nop_elimination.hpp"
 #include "util/test_tools.hpp"
 
 using namespace ngraph;
@@ -59,3 +61,28 @@ TEST(pass_manager, module_add_function)
                                        make_shared<op::FunctionCall>(f, NodeVector{X, Y, Z}),
                                    op::ParameterVector{X, Y, Z});
 }
+
+TEST(pass_manager, profile)
+{
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>((A + B) * (A + B), op::ParameterVector{A, B});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::CommonSubexpressionElimination>();
+    pass_manager.register_pass<pass::NopElimination>();
+    pass_manager.set_pass_profiling(true);
+    pass_manager.run_passes(f);
+
+    auto profiles = pass_manager.get_pass_profiles();
+    ASSERT_EQ(profiles.size(), 2);
+    EXPECT_EQ(profiles[0].pass_name, "ngraph::pass::CommonSubexpressionElimination");
+    EXPECT_EQ(profiles[0].node_count_before, 6);
+    EXPECT_EQ(profiles[0].node_count_after, 5);
+    EXPECT_EQ(profiles[0].replaced_node_count, 1);
+    EXPECT_EQ(profiles[1].pass_name, "ngraph::pass::NopElimination");
+    EXPECT_EQ(profiles[1].node_count_before, 5);
+    EXPECT_EQ(profiles[1].replaced_node_count, 0);
+    EXPECT_GE(profiles[1].start, profiles[0].start + profiles[0].duration);
+}
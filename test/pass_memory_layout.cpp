@@ -14,6 +14,7 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <limits>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -236,3 +237,85 @@ TEST(memory_layout, constant)
     size_t temporary_pool_size = f->get_temporary_pool_size();
     EXPECT_EQ(4, temporary_pool_size);
 }
+
+TEST(memory_planner, reuse_after_lifetime)
+{
+    pass::MemoryPlanner planner{64};
+    size_t a = planner.add_buffer(100, 0, 1);
+    size_t b = planner.add_buffer(100, 1, 2);
+    size_t c = planner.add_buffer(100, 2, 3);
+    planner.plan();
+
+    EXPECT_NE(planner.get_offset(a), planner.get_offset(b));
+    EXPECT_NE(planner.get_offset(b), planner.get_offset(c));
+    EXPECT_EQ(planner.get_offset(a), planner.get_offset(c));
+    EXPECT_EQ(256, planner.max_allocated());
+    EXPECT_EQ(256, planner.lower_bound());
+}
+
+TEST(memory_planner, beats_first_fit)
+{
+    // First fit in order of birth puts the large buffer above the small long-lived one;
+    // placing the large one first lets the small ones share the space below it
+    pass::MemoryManager mm{1};
+    size_t small0 = mm.allocate(10);
+    size_t small1 = mm.allocate(10);
+    mm.free(small0);
+    mm.allocate(30);
+    mm.free(small1);
+    EXPECT_EQ(50, mm.max_allocated());
+
+    pass::MemoryPlanner planner{1};
+    planner.add_buffer(10, 0, 1);
+    planner.add_buffer(10, 0, 2);
+    planner.add_buffer(30, 2, 3);
+    planner.plan();
+    EXPECT_EQ(40, planner.max_allocated());
+    EXPECT_EQ(40, planner.lower_bound());
+}
+
+TEST(memory_planner, extend_buffer)
+{
+    pass::MemoryPlanner planner{1};
+    size_t a = planner.add_buffer(10, 0, 0);
+    size_t b = planner.add_buffer(10, 1, 1);
+    planner.extend_buffer(a, 20, 1);
+    planner.plan();
+    EXPECT_NE(planner.get_offset(a), planner.get_offset(b));
+    EXPECT_EQ(30, planner.max_allocated());
+}
+
+TEST(memory_planner, many_buffers)
+{
+    // Mostly short lifetimes with a few that live to the end, as in a long chain of ops
+    pass::MemoryPlanner planner{1};
+    struct Lifetime
+    {
+        size_t size;
+        size_t first;
+        size_t last;
+    };
+    vector<Lifetime> lifetimes;
+    for (size_t step = 0; step < 2000; step++)
+    {
+        size_t last = step % 97 == 0 ? numeric_limits<size_t>::max() : step + 1 + step % 5;
+        lifetimes.push_back({16 * (1 + step % 7), step, last});
+        planner.add_buffer(lifetimes.back().size, step, last);
+    }
+    planner.plan();
+
+    for (size_t i = 0; i < lifetimes.size(); i++)
+    {
+        for (size_t j = i + 1;
+             j < lifetimes.size() && lifetimes[j].first <= lifetimes[i].last;
+             j++)
+        {
+            size_t begin_i = planner.get_offset(i);
+            size_t begin_j = planner.get_offset(j);
+            EXPECT_TRUE(begin_i + lifetimes[i].size <= begin_j ||
+                        begin_j + lifetimes[j].size <= begin_i)
+                << i << " and " << j << " overlap";
+        }
+    }
+    EXPECT_GE(planner.max_allocated(), planner.lower_bound());
+}
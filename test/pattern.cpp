@@ -814,3 +814,46 @@ TEST(pattern, is_contained_match)
     ASSERT_TRUE(n.match(label_abs2, absn2));
     ASSERT_FALSE(n.is_contained_match());
 }
+
+TEST(pattern, root_type)
+{
+    Shape shape{};
+    auto a = make_shared<op::Parameter>(element::i32, shape);
+    auto label = std::make_shared<pattern::op::Label>(a);
+    auto add = label + construct_constant_node(0);
+    auto add_label = std::make_shared<pattern::op::Label>(add, nullptr, NodeVector{add});
+    auto skip = std::make_shared<pattern::op::Skip>(add, pattern::has_class<op::Negative>());
+
+    ASSERT_EQ(pattern::Matcher(add).get_root_type(), &typeid(op::Add));
+    ASSERT_EQ(pattern::Matcher(add_label).get_root_type(), &typeid(op::Add));
+    ASSERT_EQ(pattern::Matcher(label).get_root_type(), nullptr);
+    ASSERT_EQ(pattern::Matcher(skip).get_root_type(), nullptr);
+}
+
+TEST(pattern, graph_rewrite_root_type_dispatch)
+{
+    Shape shape{};
+    auto a = make_shared<op::Parameter>(element::i32, shape);
+    auto b = make_shared<op::Parameter>(element::i32, shape);
+    auto iconst0 = construct_constant_node(0);
+    auto graph = ((a + iconst0) * b) + (b * a);
+    auto f = make_shared<Function>(graph, op::ParameterVector{a, b});
+
+    // The callbacks leave the graph alone, so that every node is tried against both matchers.
+    pattern::graph_rewrite_callback callback = [](pattern::Matcher& m) { return false; };
+    auto label = std::make_shared<pattern::op::Label>(a);
+    auto add_zero_matcher = make_shared<pattern::Matcher>(label + iconst0, callback);
+    auto any_matcher = make_shared<pattern::Matcher>(
+        std::make_shared<pattern::op::Label>(element::i32, shape), callback);
+
+    pass::GraphRewrite rewrite;
+    rewrite.add_matcher(add_zero_matcher);
+    rewrite.add_matcher(any_matcher);
+    rewrite.run_on_function(f);
+
+    // The Add pattern is only tried on the two Adds; the leaf Label is tried on every node.
+    ASSERT_EQ(add_zero_matcher->get_attempt_count(), 2);
+    ASSERT_EQ(add_zero_matcher->get_match_count(), 1);
+    ASSERT_EQ(any_matcher->get_attempt_count(), f->get_ops().size());
+    ASSERT_EQ(any_matcher->get_match_count(), f->get_ops().size());
+}
@@ -23,11 +23,16 @@
 #include "ngraph/ngraph.hpp"
 #include "ngraph/op/constant.hpp"
 #include "ngraph/op/get_output_element.hpp"
+#include "ngraph/pass/manager.hpp"
 #include "ngraph/runtime/cpu/op/dequantize.hpp"
 #include "ngraph/runtime/cpu/op/quantize.hpp"
 #include "ngraph/runtime/cpu/op/quantized_avg_pool.hpp"
 #include "ngraph/runtime/cpu/op/quantized_conv.hpp"
+#include "ngraph/runtime/cpu/op/quantized_dot.hpp"
 #include "ngraph/runtime/cpu/op/quantized_max_pool.hpp"
+#include "ngraph/runtime/cpu/pass/cpu_fusion.hpp"
+#include "ngraph/runtime/cpu/pass/cpu_quantization.hpp"
+#include "ngraph/runtime/cpu/quantization_util.hpp"
 #include "util/all_close.hpp"
 #include "util/all_close_f.hpp"
 #include "util/ndarray.hpp"
@@ -254,6 +259,104 @@ TEST(quantize_cpu, quantizedConv2D_small)
     EXPECT_EQ((vector<float>{90.0}), read_vector<float>(result_max));
 }
 
+TEST(quantize_cpu, quantized_dot)
+{
+    Shape shape_a{2, 3};
+    Shape shape_b{3, 2};
+    Shape shape_r{2, 2};
+    vector<uint8_t> a_data = {1, 2, 3, 4, 5, 6};
+    vector<int8_t> b_data = {1, -1, 2, 0, -1, 100};
+    auto A = make_shared<op::Parameter>(element::u8, shape_a);
+    auto B = make_shared<op::Parameter>(element::i8, shape_b);
+    auto bias = make_shared<op::Parameter>(element::f32, Shape{2});
+    // One unit of the data, the weights and the output is 1, 2 and 4
+    auto QD = make_shared<op::QuantizedDot>(A,
+                                            B,
+                                            op::Constant::create(element::f32, Shape{}, {0.0f}),
+                                            op::Constant::create(element::f32, Shape{}, {255.0f}),
+                                            op::Constant::create(element::f32, Shape{}, {-254.0f}),
+                                            op::Constant::create(element::f32, Shape{}, {254.0f}),
+                                            op::Constant::create(element::f32, Shape{}, {-508.0f}),
+                                            op::Constant::create(element::f32, Shape{}, {508.0f}),
+                                            bias);
+    auto output_data = std::make_shared<op::GetOutputElement>(QD, 0);
+    auto output_min = std::make_shared<op::GetOutputElement>(QD, 1);
+    auto output_max = std::make_shared<op::GetOutputElement>(QD, 2);
+    auto f = make_shared<Function>(NodeVector{output_data, output_min, output_max},
+                                   op::ParameterVector{A, B, bias});
+    auto backend = runtime::Backend::create("CPU");
+    // Create some tensors for input/output
+    auto a = backend->create_tensor(element::u8, shape_a);
+    copy_data(a, a_data);
+    auto b = backend->create_tensor(element::i8, shape_b);
+    copy_data(b, b_data);
+    auto c = backend->create_tensor(element::f32, Shape{2});
+    copy_data(c, vector<float>{1.0f, -6.0f});
+    auto result = backend->create_tensor(element::i8, shape_r);
+    auto result_min = backend->create_tensor(element::f32, Shape{});
+    auto result_max = backend->create_tensor(element::f32, Shape{});
+    backend->call_with_validate(f, {result, result_min, result_max}, {a, b, c});
+    // Dequantized products plus bias are {4 + 1, 598 - 6} and {16 + 1, 1192 - 6}, which
+    // requantize to {1.25, 148} and {4.25, 296.5}, round and saturate
+    EXPECT_EQ((vector<int8_t>{1, 127, 4, 127}), read_vector<int8_t>(result));
+    EXPECT_EQ((vector<float>{-508.0f}), read_vector<float>(result_min));
+    EXPECT_EQ((vector<float>{508.0f}), read_vector<float>(result_max));
+}
+
+TEST(quantize_cpu, quantized_dot_fusion)
+{
+    Shape shape_a{2, 3};
+    Shape shape_b{3, 4};
+    auto A = make_shared<op::Parameter>(element::u8, shape_a);
+    auto B = make_shared<op::Parameter>(element::i8, shape_b);
+    auto bias = make_shared<op::Parameter>(element::f32, Shape{4});
+    auto make_range = [](float value) {
+        return op::Constant::create(element::f32, Shape{}, {value});
+    };
+    auto dequantize_a = make_shared<op::Dequantize>(A, make_range(0), make_range(2), element::u8);
+    auto dequantize_b = make_shared<op::Dequantize>(B, make_range(-1), make_range(1), element::i8);
+    auto dot = make_shared<op::Dot>(dequantize_a, dequantize_b);
+    auto add = dot + make_shared<op::Broadcast>(bias, dot->get_shape(), AxisSet{0});
+    auto quantize = make_shared<op::Quantize>(add, make_range(-4), make_range(4), element::i8);
+    auto f = make_shared<Function>(make_shared<op::GetOutputElement>(quantize, 0),
+                                   op::ParameterVector{A, B, bias});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<runtime::cpu::pass::CPUFusion>();
+    pass_manager.run_passes(f);
+    ASSERT_EQ(count_ops_of_type<op::QuantizedDot>(f), 1);
+    ASSERT_EQ(count_ops_of_type<op::Dequantize>(f), 0);
+
+    auto backend = runtime::Backend::create("CPU");
+    vector<uint8_t> a_data = {0, 50, 100, 150, 200, 255};
+    vector<int8_t> b_data = {-127, -64, 0, 64, 127, 1, 2, 3, -5, 10, -20, 40};
+    vector<float> bias_data = {0.5f, -0.5f, 0.25f, -1.0f};
+    auto a = backend->create_tensor(element::u8, shape_a);
+    copy_data(a, a_data);
+    auto b = backend->create_tensor(element::i8, shape_b);
+    copy_data(b, b_data);
+    auto c = backend->create_tensor(element::f32, Shape{4});
+    copy_data(c, bias_data);
+    auto result = backend->create_tensor(element::i8, add->get_shape());
+    backend->call_with_validate(f, {result}, {a, b, c});
+
+    auto actual = read_vector<int8_t>(result);
+    for (size_t i = 0; i < shape_a[0]; i++)
+    {
+        for (size_t j = 0; j < shape_b[1]; j++)
+        {
+            float expected = bias_data[j];
+            for (size_t k = 0; k < shape_a[1]; k++)
+            {
+                expected += a_data[i * shape_a[1] + k] * (2.0f / 255) *
+                            b_data[k * shape_b[1] + j] * (1.0f / 127);
+            }
+            expected = std::min(std::max(expected * 127 / 4, -128.0f), 127.0f);
+            EXPECT_NEAR(actual[i * shape_b[1] + j], expected, 1);
+        }
+    }
+}
+
 TEST(quantize_cpu, quantize_to_uint8_small)
 {
     vector<float> a_data = {-85.0, 0.0, 2.0, 10.0, 15.0};
@@ -331,3 +434,249 @@ TEST(quantize_cpu, quantize_to_int8)
     EXPECT_EQ((vector<float>{-127}), read_vector<float>(result_min));
     EXPECT_EQ((vector<float>{127}), read_vector<float>(result_max));
 }
+
+TEST(quantize_cpu, kl_divergence_threshold)
+{
+    // Clipping a uniform distribution anywhere below its maximum loses information
+    vector<uint64_t> uniform(2048, 100);
+    EXPECT_FLOAT_EQ(
+        runtime::cpu::quantization_util::get_kl_divergence_threshold(uniform, 8.0f, 128), 8.0f);
+
+    // Rare outliers far above the bulk of the values get clipped
+    vector<uint64_t> outliers(2048, 0);
+    for (size_t i = 0; i < 256; i++)
+    {
+        outliers[i] = 1000 - 3 * i;
+    }
+    outliers[1500] = 1;
+    outliers[2047] = 1;
+    float threshold =
+        runtime::cpu::quantization_util::get_kl_divergence_threshold(outliers, 2048.0f, 128);
+    EXPECT_GE(threshold, 128.0f);
+    EXPECT_LT(threshold, 1024.0f);
+}
+
+// Convolution -> MaxPool -> Relu -> Convolution, with constant filters on the first
+// convolution and filters passed in for the second
+static shared_ptr<Function> make_quantizable_function()
+{
+    auto data = make_shared<op::Parameter>(element::f32, Shape{1, 2, 6, 6});
+    vector<float> filter_values(4 * 2 * 3 * 3);
+    test::Uniform<float>(-1.0f, 1.0f).initialize(filter_values);
+    auto filters1 = op::Constant::create(element::f32, Shape{4, 2, 3, 3}, filter_values);
+    auto conv1 = make_shared<op::Convolution>(
+        data, filters1, Strides{1, 1}, Strides{1, 1}, CoordinateDiff{1, 1}, CoordinateDiff{1, 1});
+    auto pool = make_shared<op::MaxPool>(conv1, Shape{2, 2}, Strides{2, 2});
+    auto relu = make_shared<op::Relu>(pool);
+    auto filters2 = make_shared<op::Parameter>(element::f32, Shape{3, 4, 2, 2});
+    auto conv2 = make_shared<op::Convolution>(relu, filters2);
+    return make_shared<Function>(conv2, op::ParameterVector{data, filters2});
+}
+
+static vector<vector<float>> make_quantizable_inputs(float seed)
+{
+    vector<float> data(1 * 2 * 6 * 6);
+    test::Uniform<float>(0.0f, 1.0f, seed).initialize(data);
+    vector<float> filters(3 * 4 * 2 * 2);
+    test::Uniform<float>(-1.0f, 1.0f, seed).initialize(filters);
+    return {data, filters};
+}
+
+TEST(quantize_cpu, quantization_pass)
+{
+    for (auto calibration : {runtime::cpu::pass::CPUQuantization::Calibration::MinMax,
+                             runtime::cpu::pass::CPUQuantization::Calibration::KLDivergence})
+    {
+        auto f = make_quantizable_function();
+        pass::Manager pass_manager;
+        pass_manager.register_pass<runtime::cpu::pass::CPUQuantization>(
+            vector<vector<vector<float>>>{make_quantizable_inputs(0), make_quantizable_inputs(1)},
+            calibration,
+            "INTERPRETER");
+        pass_manager.run_passes(f);
+
+        // The Relu moves before the pool and is fused into the first convolution. Its u8
+        // output is pooled and read by the second convolution, so only the input and the
+        // second convolution's filters get quantized.
+        EXPECT_EQ(count_ops_of_type<op::Convolution>(f), 0);
+        EXPECT_EQ(count_ops_of_type<op::Relu>(f), 0);
+        EXPECT_EQ(count_ops_of_type<op::QuantizedConvolution>(f), 2);
+        EXPECT_EQ(count_ops_of_type<op::MaxPool>(f), 0);
+        EXPECT_EQ(count_ops_of_type<op::QuantizedMaxPool>(f), 1);
+        EXPECT_EQ(count_ops_of_type<op::Quantize>(f), 2);
+        EXPECT_EQ(count_ops_of_type<op::Dequantize>(f), 1);
+    }
+}
+
+TEST(quantize_cpu, quantization_pass_accuracy)
+{
+    auto f = make_quantizable_function();
+    auto quantized_f = make_quantizable_function();
+    pass::Manager pass_manager;
+    pass_manager.register_pass<runtime::cpu::pass::CPUQuantization>(
+        vector<vector<vector<float>>>{make_quantizable_inputs(0), make_quantizable_inputs(1)});
+    pass_manager.run_passes(quantized_f);
+
+    auto inputs = make_quantizable_inputs(2);
+    auto expected = execute(f, inputs, "INTERPRETER").at(0);
+    auto result = execute(quantized_f, inputs, "CPU").at(0);
+    float max_abs = 0;
+    for (float value : expected)
+    {
+        max_abs = max(max_abs, abs(value));
+    }
+    ASSERT_EQ(result.size(), expected.size());
+    for (size_t i = 0; i < result.size(); i++)
+    {
+        EXPECT_NEAR(result[i], expected[i], 0.05f * max_abs);
+    }
+}
+
+TEST(quantize_cpu, quantization_pass_dot)
+{
+    // Fully connected layer with bias -> Relu -> fully connected layer
+    auto data = make_shared<op::Parameter>(element::f32, Shape{2, 8});
+    vector<float> weight_values(8 * 4);
+    test::Uniform<float>(-1.0f, 1.0f).initialize(weight_values);
+    auto weights1 = op::Constant::create(element::f32, Shape{8, 4}, weight_values);
+    auto bias = op::Constant::create(element::f32, Shape{4}, {0.5f, -0.5f, 0.25f, 0.0f});
+    auto dot1 = make_shared<op::Dot>(data, weights1);
+    auto add = dot1 + make_shared<op::Broadcast>(bias, dot1->get_shape(), AxisSet{0});
+    auto relu = make_shared<op::Relu>(add);
+    auto weights2 = make_shared<op::Parameter>(element::f32, Shape{4, 3});
+    auto dot2 = make_shared<op::Dot>(relu, weights2);
+    auto f = make_shared<Function>(dot2, op::ParameterVector{data, weights2});
+
+    vector<vector<vector<float>>> calibration_inputs(2);
+    for (size_t i = 0; i < calibration_inputs.size(); i++)
+    {
+        vector<float> data_values(2 * 8);
+        test::Uniform<float>(0.0f, 1.0f, i).initialize(data_values);
+        vector<float> weights_values(4 * 3);
+        test::Uniform<float>(-1.0f, 1.0f, i).initialize(weights_values);
+        calibration_inputs[i] = {data_values, weights_values};
+    }
+    pass::Manager pass_manager;
+    pass_manager.register_pass<runtime::cpu::pass::CPUQuantization>(
+        calibration_inputs,
+        runtime::cpu::pass::CPUQuantization::Calibration::MinMax,
+        "INTERPRETER");
+    pass_manager.run_passes(f);
+
+    // The bias and the Relu are fused into the first QuantizedDot, whose u8 output the
+    // second one reads
+    EXPECT_EQ(count_ops_of_type<op::Dot>(f), 0);
+    EXPECT_EQ(count_ops_of_type<op::Add>(f), 0);
+    EXPECT_EQ(count_ops_of_type<op::Relu>(f), 0);
+    EXPECT_EQ(count_ops_of_type<op::QuantizedDot>(f), 2);
+    EXPECT_EQ(count_ops_of_type<op::Quantize>(f), 2);
+    EXPECT_EQ(count_ops_of_type<op::Dequantize>(f), 1);
+}
+
+TEST(quantize_cpu, quantization_pass_relu_range)
+{
+    // Convolution -> Relu -> Convolution, where the second convolution reads the u8 output
+    // of the first one
+    vector<float> filter_values1(4 * 2 * 3 * 3);
+    test::Uniform<float>(-1.0f, 1.0f).initialize(filter_values1);
+    vector<float> filter_values2(3 * 4 * 3 * 3);
+    test::Uniform<float>(-1.0f, 1.0f).initialize(filter_values2);
+    auto make_function = [&]() {
+        auto data = make_shared<op::Parameter>(element::f32, Shape{1, 2, 8, 8});
+        auto filters1 = op::Constant::create(element::f32, Shape{4, 2, 3, 3}, filter_values1);
+        auto filters2 = op::Constant::create(element::f32, Shape{3, 4, 3, 3}, filter_values2);
+        auto relu = make_shared<op::Relu>(make_shared<op::Convolution>(data, filters1));
+        return make_shared<Function>(make_shared<op::Convolution>(relu, filters2),
+                                     op::ParameterVector{data});
+    };
+    auto make_inputs = [](float seed) {
+        vector<float> data(1 * 2 * 8 * 8);
+        test::Uniform<float>(0.0f, 1.0f, seed).initialize(data);
+        return vector<vector<float>>{data};
+    };
+
+    auto f = make_function();
+    pass::Manager pass_manager;
+    pass_manager.register_pass<runtime::cpu::pass::CPUQuantization>(
+        vector<vector<vector<float>>>{make_inputs(0), make_inputs(1)},
+        runtime::cpu::pass::CPUQuantization::Calibration::MinMax,
+        "INTERPRETER");
+    pass_manager.run_passes(f);
+
+    shared_ptr<op::QuantizedConvolution> first;
+    shared_ptr<op::QuantizedConvolution> second;
+    for (auto node : f->get_ordered_ops())
+    {
+        if (auto conv = dynamic_pointer_cast<op::QuantizedConvolution>(node))
+        {
+            (conv->with_relu() ? first : second) = conv;
+        }
+    }
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    // The u8 output spans 255 levels up to output_max, which is how the second convolution
+    // reads its input
+    EXPECT_EQ(second->get_input_min(), 0.0f);
+    EXPECT_EQ(second->get_input_max(), first->get_freezed_output_max());
+
+    auto inputs = make_inputs(2);
+    auto expected = execute(make_function(), inputs, "INTERPRETER").at(0);
+    auto result = execute(f, inputs, "CPU").at(0);
+    float max_abs = 0;
+    for (float value : expected)
+    {
+        max_abs = max(max_abs, abs(value));
+    }
+    ASSERT_EQ(result.size(), expected.size());
+    for (size_t i = 0; i < result.size(); i++)
+    {
+        EXPECT_NEAR(result[i], expected[i], 0.05f * max_abs);
+    }
+}
+
+TEST(quantize_cpu, quantization_pass_chain)
+{
+    // Ops that read the output of a quantized op without a Relu in between
+    auto data = make_shared<op::Parameter>(element::f32, Shape{1, 2, 6, 6});
+    vector<float> filter_values(2 * 2 * 3 * 3);
+    test::Uniform<float>(0.1f, 1.0f).initialize(filter_values);
+    auto filters = op::Constant::create(element::f32, Shape{2, 2, 3, 3}, filter_values);
+    auto conv1 = make_shared<op::Convolution>(data, filters);
+    auto conv2 = make_shared<op::Convolution>(conv1, filters);
+
+    auto matrix = make_shared<op::Parameter>(element::f32, Shape{2, 8});
+    vector<float> weight_values(8 * 8);
+    test::Uniform<float>(0.1f, 1.0f).initialize(weight_values);
+    auto weights = op::Constant::create(element::f32, Shape{8, 8}, weight_values);
+    auto bias = op::Constant::create(element::f32, Shape{8}, vector<float>(8, 0.5f));
+    auto dot1 = make_shared<op::Dot>(matrix, weights);
+    auto add = dot1 + make_shared<op::Broadcast>(bias, dot1->get_shape(), AxisSet{0});
+    auto dot2 = make_shared<op::Dot>(add, weights);
+    auto f = make_shared<Function>(NodeVector{conv2, dot2}, op::ParameterVector{data, matrix});
+
+    vector<vector<vector<float>>> calibration_inputs(2);
+    for (size_t i = 0; i < calibration_inputs.size(); i++)
+    {
+        vector<float> data_values(1 * 2 * 6 * 6);
+        test::Uniform<float>(0.0f, 1.0f, i).initialize(data_values);
+        vector<float> matrix_values(2 * 8);
+        test::Uniform<float>(0.0f, 1.0f, i).initialize(matrix_values);
+        calibration_inputs[i] = {data_values, matrix_values};
+    }
+    pass::Manager pass_manager;
+    pass_manager.register_pass<runtime::cpu::pass::CPUQuantization>(
+        calibration_inputs,
+        runtime::cpu::pass::CPUQuantization::Calibration::MinMax,
+        "INTERPRETER");
+    pass_manager.run_passes(f);
+
+    // The second op of each chain requantizes the output of the first one, and none of the
+    // f32 ops is left behind
+    EXPECT_EQ(count_ops_of_type<op::Convolution>(f), 0);
+    EXPECT_EQ(count_ops_of_type<op::Dot>(f), 0);
+    EXPECT_EQ(count_ops_of_type<op::Add>(f), 0);
+    EXPECT_EQ(count_ops_of_type<op::QuantizedConvolution>(f), 2);
+    EXPECT_EQ(count_ops_of_type<op::QuantizedDot>(f), 2);
+    EXPECT_EQ(count_ops_of_type<op::Quantize>(f), 4);
+    EXPECT_EQ(count_ops_of_type<op::Dequantize>(f), 4);
+}
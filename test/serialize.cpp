@@ -15,6 +15,7 @@
 //*****************************************************************************
 
 #include <fstream>
+#include <numeric>
 #include <sstream>
 
 #include "gtest/gtest.h"
@@ -158,6 +159,104 @@ TEST(serialize, constant)
     EXPECT_TRUE(found);
 }
 
+TEST(serialize, reduced_precision)
+{
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::bf16, shape);
+    auto B = op::Constant::create(element::f16, shape, {0.5f, 1.5f, -3.0f, 65504.0f});
+    auto sum = make_shared<op::Convert>(A, element::f16) + B;
+    auto f = make_shared<Function>(make_shared<op::Convert>(sum, element::bf16),
+                                   op::ParameterVector{A});
+
+    auto g = deserialize(serialize(f));
+    ASSERT_NE(g, nullptr);
+    EXPECT_EQ(g->get_parameters().at(0)->get_element_type(), element::bf16);
+    EXPECT_EQ(g->get_output_element_type(0), element::bf16);
+    bool found = false;
+    for (shared_ptr<Node> node : g->get_ops())
+    {
+        if (auto c = dynamic_pointer_cast<op::Constant>(node))
+        {
+            found = true;
+            EXPECT_EQ(c->get_element_type(), element::f16);
+            EXPECT_EQ((vector<float16>{0.5f, 1.5f, -3.0f, 65504.0f}), c->get_vector<float16>());
+        }
+    }
+    EXPECT_TRUE(found);
+}
+
+TEST(serialize, mapped_constant)
+{
+    const string tmp_file = "serialize_mapped_constant.cpio";
+    Shape small_shape{3};
+    Shape large_shape{32, 32};
+    vector<float> large_values(shape_size(large_shape));
+    iota(large_values.begin(), large_values.end(), 0.0f);
+    auto A = op::Constant::create(element::f32, small_shape, {1, 2, 3});
+    auto B = op::Constant::create(element::f32, large_shape, large_values);
+    auto f = make_shared<Function>(NodeVector{A, B}, op::ParameterVector{});
+
+    serialize(tmp_file, f);
+    auto g = deserialize(tmp_file);
+    ASSERT_NE(g, nullptr);
+    // The constants keep the mapping alive after the file is gone
+    file_util::remove_file(tmp_file);
+
+    size_t found = 0;
+    for (shared_ptr<Node> node : g->get_ops())
+    {
+        if (auto c = dynamic_pointer_cast<op::Constant>(node))
+        {
+            auto address = reinterpret_cast<uintptr_t>(c->get_data_ptr());
+            if (c->get_shape() == large_shape)
+            {
+                EXPECT_EQ(address % 4096, 0u);
+                EXPECT_EQ(large_values, c->get_vector<float>());
+
+                // Copies refer to the same mapped data
+                auto copy = c->copy_with_new_args(NodeVector{});
+                EXPECT_EQ(static_pointer_cast<op::Constant>(copy)->get_data_ptr(),
+                          c->get_data_ptr());
+            }
+            else
+            {
+                EXPECT_EQ(address % 64, 0u);
+                EXPECT_EQ((vector<float>{1, 2, 3}), c->get_vector<float>());
+            }
+            found++;
+        }
+    }
+    EXPECT_EQ(found, 2u);
+}
+
+TEST(serialize, mapped_constant_write)
+{
+    const string tmp_file = "serialize_mapped_constant_write.cpio";
+    Shape shape{32, 32};
+    vector<float> values(shape_size(shape));
+    iota(values.begin(), values.end(), 0.0f);
+    auto f = make_shared<Function>(op::Constant::create(element::f32, shape, values),
+                                   op::ParameterVector{});
+    serialize(tmp_file, f);
+
+    // Kernels that run in place may overwrite the data of a mapped constant
+    auto g = deserialize(tmp_file);
+    ASSERT_NE(g, nullptr);
+    auto c = dynamic_pointer_cast<op::Constant>(g->get_results().at(0)->get_argument(0));
+    ASSERT_NE(c, nullptr);
+    float* data = static_cast<float*>(const_cast<void*>(c->get_data_ptr()));
+    fill(data, data + values.size(), -1.0f);
+    EXPECT_EQ(c->get_vector<float>(), vector<float>(values.size(), -1.0f));
+
+    // The file and later mappings of it keep the serialized values
+    auto h = deserialize(tmp_file);
+    file_util::remove_file(tmp_file);
+    ASSERT_NE(h, nullptr);
+    auto d = dynamic_pointer_cast<op::Constant>(h->get_results().at(0)->get_argument(0));
+    ASSERT_NE(d, nullptr);
+    EXPECT_EQ(d->get_vector<float>(), values);
+}
+
 TEST(benchmark, serialize)
 {
     stopwatch timer;
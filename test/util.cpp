@@ -414,3 +414,42 @@ TEST(graph_util, test_subgraph_topological_sort_control_dependencies)
     std::list<std::shared_ptr<Node>> expected{A, D, add, mul};
     ASSERT_EQ(expected, sorted);
 }
+
+TEST(graph_util, cached_ordered_ops)
+{
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto add = A + B;
+    auto abs = make_shared<op::Abs>(add);
+    auto f = make_shared<Function>(abs, op::ParameterVector{A, B});
+
+    // The view is the cached order itself until the graph changes
+    auto ordered = f->get_ordered_ops_view();
+    EXPECT_EQ(ordered, f->get_ordered_ops_view());
+    EXPECT_EQ(*ordered, f->get_ordered_ops());
+    EXPECT_EQ(ordered->size(), 5);
+
+    auto mul = A * B;
+    f->replace_node(add, mul);
+    auto ops = f->get_ordered_ops();
+    EXPECT_EQ(count(ops.begin(), ops.end(), add), 0);
+    // A snapshot taken before the edit is left intact
+    EXPECT_NE(ordered, f->get_ordered_ops_view());
+    EXPECT_EQ(ordered->size(), 5);
+    EXPECT_EQ(count(ordered->begin(), ordered->end(), add), 1);
+    EXPECT_EQ(ops, topological_sort(f->get_ops(), true));
+
+    // Edits made without going through the function are seen as well
+    auto neg = make_shared<op::Negative>(mul);
+    abs->get_inputs().at(0).replace_output(neg->get_outputs().at(0));
+    ops = f->get_ordered_ops();
+    EXPECT_EQ(ops.size(), 6);
+    EXPECT_EQ(ops, topological_sort(f->get_ops(), true));
+
+    auto C = make_shared<op::Parameter>(element::f32, shape);
+    auto cdep = make_shared<op::Abs>(C);
+    neg->add_control_dependency(cdep);
+    EXPECT_EQ(f->get_ordered_ops(true).size(), 8);
+    EXPECT_EQ(f->get_ordered_ops(false).size(), 6);
+}
@@ -15,6 +15,7 @@
 //*****************************************************************************
 
 #include <algorithm>
+#include <cstdlib>
 
 #include "ngraph/ngraph.hpp"
 #include "ngraph/util.hpp"
@@ -33,6 +34,16 @@ vector<float> read_float_vector(shared_ptr<runtime::TensorView> tv)
         vector<char> vec = read_vector<char>(tv);
         float_vec = vector<float>(vec.begin(), vec.end());
     }
+    else if (element_type == element::bf16)
+    {
+        vector<bfloat16> vec = read_vector<bfloat16>(tv);
+        float_vec = vector<float>(vec.begin(), vec.end());
+    }
+    else if (element_type == element::f16)
+    {
+        vector<float16> vec = read_vector<float16>(tv);
+        float_vec = vector<float>(vec.begin(), vec.end());
+    }
     else if (element_type == element::f32)
     {
         vector<float> vec = read_vector<float>(tv);
@@ -147,3 +158,34 @@ shared_ptr<Function> make_test_graph()
 
     return f0;
 }
+
+ScopedEnvironment::ScopedEnvironment(const string& name, const char* value)
+    : m_name(name)
+    , m_was_set(false)
+{
+    if (const char* saved = getenv(name.c_str()))
+    {
+        m_saved_value = saved;
+        m_was_set = true;
+    }
+    if (value)
+    {
+        setenv(name.c_str(), value, 1);
+    }
+    else
+    {
+        unsetenv(name.c_str());
+    }
+}
+
+ScopedEnvironment::~ScopedEnvironment()
+{
+    if (m_was_set)
+    {
+        setenv(m_name.c_str(), m_saved_value.c_str(), 1);
+    }
+    else
+    {
+        unsetenv(m_name.c_str());
+    }
+}
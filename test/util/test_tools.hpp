@@ -19,6 +19,7 @@
 #include <exception>
 #include <list>
 #include <memory>
+#include <string>
 
 #include "ngraph/descriptor/layout/tensor_layout.hpp"
 #include "ngraph/file_util.hpp"
@@ -36,6 +37,23 @@ namespace ngraph
 bool validate_list(const std::list<std::shared_ptr<ngraph::Node>>& nodes);
 std::shared_ptr<ngraph::Function> make_test_graph();
 
+/// \brief Sets an environment variable, or unsets it if value is nullptr, and restores the
+///     previous state when it goes out of scope, so a failed assertion cannot leak the
+///     setting into later tests
+class ScopedEnvironment
+{
+public:
+    ScopedEnvironment(const std::string& name, const char* value);
+    ~ScopedEnvironment();
+    ScopedEnvironment(const ScopedEnvironment&) = delete;
+    ScopedEnvironment& operator=(const ScopedEnvironment&) = delete;
+
+private:
+    std::string m_name;
+    std::string m_saved_value;
+    bool m_was_set;
+};
+
 template <typename T>
 void copy_data(std::shared_ptr<ngraph::runtime::TensorView> tv, const std::vector<T>& data)
 {